@@ -18,6 +18,7 @@ namespace Fyrion
     void InitSceneViewWindow();
     void InitSceneTreeWindow();
     void InitGraphEditorWindow();
+    void InitProfilerWindow();
 
     struct EditorWindowStorage
     {
@@ -404,11 +405,15 @@ namespace Fyrion
 
         Registry::Type<EditorWindow>();
 
+        //only the editor reloads assets changed on disk.
+        ResourceAssets::SetHotReloadEnabled(true);
+
         InitProjectBrowser();
         InitSceneTreeWindow();
         InitSceneViewWindow();
         InitPropertiesWindow();
         InitGraphEditorWindow();
+        InitProfilerWindow();
 
         Event::Bind<OnInit , &InitEditor>();
         Event::Bind<OnUpdate, &EditorUpdate>();
@@ -0,0 +1,161 @@
+#include "ProfilerWindow.hpp"
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Editor/Editor.hpp"
+#include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/ImGui/IconsFontAwesome6.h"
+#include "Fyrion/ImGui/ImGui.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+
+namespace Fyrion
+{
+    void ProfilerWindow::Draw(u32 id, bool& open)
+    {
+        ImGui::Begin(id, ICON_FA_GAUGE " Profiler", &open);
+        {
+            bool enabled = Profiler::IsEnabled();
+            if (ImGui::Button(enabled ? ICON_FA_PAUSE " Pause" : ICON_FA_PLAY " Resume"))
+            {
+                Profiler::SetEnabled(!enabled);
+            }
+
+            ImGui::SameLine();
+
+            if (ImGui::Button(ICON_FA_FILE_EXPORT " Export Chrome Trace"))
+            {
+                String     path{};
+                FileFilter filter{.name = "Chrome Trace", .spec = "json"};
+                if (Platform::SaveDialog(path, {&filter, 1}, {}, "trace.json") == DialogResult::OK)
+                {
+                    Profiler::ExportChromeTrace(path);
+                }
+            }
+
+            ImGui::SameLine();
+
+            bool lowLatency = Engine::IsLowLatency();
+            if (ImGui::Checkbox("Low Latency", &lowLatency))
+            {
+                Engine::SetLowLatency(lowLatency);
+            }
+
+            FramePacingStats pacingStats = Engine::GetFramePacingStats();
+            ImGui::Text("Input latency %.3f ms (avg %.3f ms, max %.3f ms)  Delay %.3f ms",
+                        pacingStats.inputLatency * 1000.0,
+                        pacingStats.averageInputLatency * 1000.0,
+                        pacingStats.maxInputLatency * 1000.0,
+                        pacingStats.delay * 1000.0);
+
+            //live resources growing over time without a matching scene change usually means a leak.
+            ResourceStats resourceStats = Graphics::GetResourceStats();
+            ImGui::Text("Buffers %u (%u pending)  Textures %u (%u pending)  Views %u (%u pending)  Samplers %u  Stale handles %u",
+                        resourceStats.buffers.live, resourceStats.buffers.pendingDestroy,
+                        resourceStats.textures.live, resourceStats.textures.pendingDestroy,
+                        resourceStats.textureViews.live, resourceStats.textureViews.pendingDestroy,
+                        resourceStats.samplers.live,
+                        resourceStats.buffers.staleAccesses + resourceStats.textures.staleAccesses + resourceStats.textureViews.staleAccesses + resourceStats.samplers.staleAccesses);
+
+            usize frameCount = Profiler::GetFrameCount();
+            if (frameCount == 0)
+            {
+                ImGui::End();
+                return;
+            }
+
+            m_frameTimes.Resize(frameCount);
+            for (usize i = 0; i < frameCount; ++i)
+            {
+                m_frameTimes[i] = static_cast<f32>(Profiler::GetFrame(i).cpuTime * 1000.0);
+            }
+
+            //follows the last frame with gpu timings until a frame is selected.
+            if (m_selectedFrame < 0 || m_selectedFrame >= static_cast<i32>(frameCount))
+            {
+                m_selectedFrame = static_cast<i32>(frameCount) - 1;
+                while (m_selectedFrame > 0 && !Profiler::GetFrame(m_selectedFrame).gpuResolved)
+                {
+                    m_selectedFrame--;
+                }
+            }
+
+            ImGui::PlotHistogram("##frame-times", m_frameTimes.Data(), static_cast<i32>(m_frameTimes.Size()), 0, "CPU frame time (ms)", 0.0f, FLT_MAX,
+                                 ImVec2(ImGui::GetContentRegionAvail().x, 80 * ImGui::GetStyle().ScaleFactor));
+
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+            ImGui::SliderInt("##selected-frame", &m_selectedFrame, 0, static_cast<i32>(frameCount) - 1, "Frame %d");
+
+            const ProfileFrame& frame = Profiler::GetFrame(m_selectedFrame);
+            ImGui::Text("Frame %llu  CPU %.3f ms  GPU %s", static_cast<unsigned long long>(frame.frame), frame.cpuTime * 1000.0, frame.gpuResolved ? "" : "pending");
+            if (frame.gpuResolved)
+            {
+                ImGui::SameLine(0, 0);
+                ImGui::Text("%.3f ms", frame.gpuTime * 1000.0);
+            }
+
+            f64 frameTime = Math::Max(Math::Max(frame.cpuTime, frame.gpuTime), 0.000001);
+            f32 rowHeight = ImGui::GetTextLineHeightWithSpacing();
+
+            ImGui::SeparatorText("CPU");
+            DrawScopes(frame.cpuScopes, frameTime, rowHeight);
+
+            ImGui::SeparatorText("GPU");
+            DrawScopes(frame.gpuScopes, frameTime, rowHeight);
+        }
+        ImGui::End();
+    }
+
+    void ProfilerWindow::DrawScopes(Span<ProfileScope> scopes, f64 frameTime, f32 rowHeight)
+    {
+        u32 maxDepth = 0;
+        for (const ProfileScope& scope : scopes)
+        {
+            maxDepth = Math::Max(maxDepth, scope.depth);
+        }
+
+        ImVec2      origin = ImGui::GetCursorScreenPos();
+        f32         width = ImGui::GetContentRegionAvail().x;
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImVec2      mouse = ImGui::GetMousePos();
+
+        ImGui::Dummy(ImVec2(width, rowHeight * (scopes.Size() == 0 ? 1 : maxDepth + 1)));
+        bool hovered = ImGui::IsItemHovered();
+
+        for (const ProfileScope& scope : scopes)
+        {
+            ImVec2 min{origin.x + static_cast<f32>(scope.begin / frameTime) * width, origin.y + scope.depth * rowHeight};
+            ImVec2 max{Math::Max(origin.x + static_cast<f32>(scope.end / frameTime) * width, min.x + 1.0f), min.y + rowHeight - 1.0f};
+
+            ImU32 color = ImGui::GetColorU32(scope.depth % 2 == 0 ? ImGuiCol_PlotHistogram : ImGuiCol_PlotHistogramHovered);
+            drawList->AddRectFilled(min, max, color);
+
+            drawList->PushClipRect(min, max, true);
+            drawList->AddText(ImVec2(min.x + 2, min.y), ImGui::GetColorU32(ImGuiCol_Text), scope.name.CStr());
+            drawList->PopClipRect();
+
+            if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+            {
+                ImGui::SetTooltip("%s: %.3f ms", scope.name.CStr(), (scope.end - scope.begin) * 1000.0);
+            }
+        }
+    }
+
+    void ProfilerWindow::OpenProfiler(const MenuItemEventData& eventData)
+    {
+        Editor::OpenWindow<ProfilerWindow>();
+    }
+
+    void ProfilerWindow::RegisterType(NativeTypeHandler<ProfilerWindow>& type)
+    {
+        Editor::AddMenuItem(MenuItemCreation{.itemName="Window/Profiler", .action = OpenProfiler});
+
+        type.Attribute<EditorWindowProperties>(EditorWindowProperties{
+            .dockPosition = DockPosition::Bottom,
+            .createOnInit = false
+        });
+    }
+
+    void InitProfilerWindow()
+    {
+        Registry::Type<ProfilerWindow, EditorWindow>();
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Core/Profiler.hpp"
+#include "Fyrion/Editor/EditorTypes.hpp"
+
+namespace Fyrion
+{
+    struct MenuItemEventData;
+
+    class ProfilerWindow : public EditorWindow
+    {
+    public:
+        void Draw(u32 id, bool& open) override;
+
+        static void RegisterType(NativeTypeHandler<ProfilerWindow>& type);
+    private:
+        Array<f32> m_frameTimes{};
+        i32        m_selectedFrame{-1};
+
+        static void DrawScopes(Span<ProfileScope> scopes, f64 frameTime, f32 rowHeight);
+        static void OpenProfiler(const MenuItemEventData& eventData);
+    };
+}
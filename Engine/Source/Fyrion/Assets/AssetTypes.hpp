@@ -21,6 +21,8 @@ namespace Fyrion
         constexpr static u32 Bytes = 0;
         constexpr static u32 Info = 1;
         constexpr static u32 Stages = 2;
+        constexpr static u32 Permutations = 3;
+        constexpr static u32 Path = 4;
     };
 
 
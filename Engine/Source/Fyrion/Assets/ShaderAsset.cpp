@@ -11,46 +11,24 @@ namespace Fyrion
 {
     struct ShaderAsset;
 
-    RID ImportRasterShader(RID asset, const StringView& path)
+    RID ImportShader(RID asset, const StringView& path, Array<ShaderStageInfo> stages)
     {
         RenderApiType renderApi = Graphics::GetRenderApi();
 
-        String source = FileSystem::ReadFileAsString(path);
-
-        Array<u8> bytes;
-        Array<ShaderStageInfo> stages;
+        String        source = FileSystem::ReadFileAsString(path);
+        Array<String> permutations = ShaderManager::ParsePermutations(source);
 
-        bool vertexRes = ShaderManager::CompileShader(ShaderCreation{
-                                                          .source = source,
-                                                          .entryPoint = "MainVS",
-                                                          .shaderStage = ShaderStage::Vertex,
-                                                          .renderApi = renderApi
-                                                      }, bytes);
+        //the asset is the default variant, all permutation keys disabled.
+        Array<String> defines = ShaderManager::GetPermutationDefines(permutations, 0);
 
-        stages.EmplaceBack(ShaderStageInfo{
-            .stage = ShaderStage::Vertex,
-            .entryPoint = "MainVS",
-            .offset = 0,
-            .size = (u32)bytes.Size()
-        });
+        Array<u8>     bytes;
+        Array<String> dependencies;
 
-        u32 pixelOffset = (u32) bytes.Size();
+        bool result = ShaderManager::CompileShaderStages(source, path, renderApi, defines, stages, bytes, &dependencies);
 
-        bool pixelRes = ShaderManager::CompileShader(ShaderCreation{
-                                                          .source = source,
-                                                          .entryPoint = "MainPS",
-                                                          .shaderStage = ShaderStage::Pixel,
-                                                          .renderApi = renderApi
-                                                      }, bytes);
+        ResourceAssets::SetAssetDependencies(asset, dependencies);
 
-        stages.EmplaceBack(ShaderStageInfo{
-            .stage = ShaderStage::Pixel,
-            .entryPoint = "MainPS",
-            .offset = pixelOffset,
-            .size = (u32)bytes.Size() - pixelOffset
-        });
-
-        if (vertexRes &&  pixelRes)
+        if (result)
         {
             RID shader = Repository::CreateResource<ShaderAsset>();
 
@@ -58,7 +36,8 @@ namespace Fyrion
             write[ShaderAsset::Bytes] = bytes;
             write[ShaderAsset::Info] = ShaderManager::ExtractShaderInfo(bytes, stages, renderApi);
             write[ShaderAsset::Stages] = stages;
-
+            write[ShaderAsset::Permutations] = permutations;
+            write[ShaderAsset::Path] = String{path};
             write.Commit();
 
             return shader;
@@ -66,41 +45,19 @@ namespace Fyrion
         return {};
     }
 
-    RID ImportCompShader(RID asset, const StringView& path)
+    RID ImportRasterShader(RID asset, const StringView& path)
     {
-        RenderApiType renderApi = Graphics::GetRenderApi();
-
-        String source = FileSystem::ReadFileAsString(path);
-
-        Array<u8> bytes;
-
-        if (ShaderManager::CompileShader(ShaderCreation{
-                                             .source = source,
-                                             .entryPoint = "MainCS",
-                                             .shaderStage = ShaderStage::Compute,
-                                             .renderApi = renderApi
-                                         }, bytes))
-        {
-            Array<ShaderStageInfo> stages;
-
-            RID shader = Repository::CreateResource<ShaderAsset>();
-
-            stages.EmplaceBack(ShaderStageInfo{
-                .stage = ShaderStage::Compute,
-                .entryPoint = "MainCS",
-                .size = (u32)bytes.Size()
-            });
-
-            ResourceObject write = Repository::Write(shader);
-            write[ShaderAsset::Bytes] = bytes;
-            write[ShaderAsset::Info] = ShaderManager::ExtractShaderInfo(bytes, stages, renderApi);
-            write[ShaderAsset::Stages] = stages;
-            write.Commit();
-
-            return shader;
-        }
+        return ImportShader(asset, path, {
+                                ShaderStageInfo{.stage = ShaderStage::Vertex, .entryPoint = "MainVS"},
+                                ShaderStageInfo{.stage = ShaderStage::Pixel, .entryPoint = "MainPS"},
+                            });
+    }
 
-        return {};
+    RID ImportCompShader(RID asset, const StringView& path)
+    {
+        return ImportShader(asset, path, {
+                                ShaderStageInfo{.stage = ShaderStage::Compute, .entryPoint = "MainCS"},
+                            });
     }
 
     void RegisterShaderAsset()
@@ -109,6 +66,8 @@ namespace Fyrion
             .Value<ShaderAsset::Bytes, Array<u8>>("Bytes")
             .Value<ShaderAsset::Info, ShaderInfo>("Info")
             .Value<ShaderAsset::Stages, Array<ShaderStageInfo>>("Stages")
+            .Value<ShaderAsset::Permutations, Array<String>>("Permutations")
+            .Value<ShaderAsset::Path, String>("Path")
             .Build();
 
         ResourceAssets::AddAssetImporter(".raster", ImportRasterShader);
@@ -58,10 +58,13 @@ inline void operator delete(void*, Fyrion::PlaceHolder, Fyrion::VoidPtr) noexcep
 
 //--general defines
 #define FY_STRING_BUFFER_SIZE 18
-#define FY_FRAMES_IN_FLIGHT 2
+//maximum frames in flight, frame resources are created for all of them and the device runs Graphics::GetFramesInFlight().
+#define FY_FRAMES_IN_FLIGHT 3
+#define FY_DEFAULT_FRAMES_IN_FLIGHT 2
 #define FY_REPO_PAGE_SIZE 4096
 #define FY_ASSET_EXTENSION ".fy_asset"
 #define FY_DATA_EXTENSION ".fy_data"
+#define FY_STORE_EXTENSION ".fy_store"
 #define FY_CHUNK_COMPONENT_SIZE (16*1024)
 
 //---platform defines
@@ -0,0 +1,243 @@
+#include "Compression.hpp"
+
+#include <cstring>
+
+namespace Fyrion
+{
+    namespace
+    {
+        constexpr usize MinMatch = 4;
+        constexpr usize LastLiterals = 5;
+        constexpr usize MatchFindLimit = 12;
+        constexpr usize MaxDistance = 65535;
+        constexpr u32   HashBits = 14;
+        constexpr u32   SkipTrigger = 6;
+
+        FY_FINLINE u32 Read32(const u8* ptr)
+        {
+            u32 value;
+            memcpy(&value, ptr, sizeof(u32));
+            return value;
+        }
+
+        FY_FINLINE u32 HashSequence(u32 sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        FY_FINLINE usize LengthBytes(usize length)
+        {
+            return length >= 15 ? (length - 15) / 255 + 1 : 0;
+        }
+
+        FY_FINLINE u8* WriteLength(u8* op, usize length)
+        {
+            length -= 15;
+            while (length >= 255)
+            {
+                *op++ = 255;
+                length -= 255;
+            }
+            *op++ = static_cast<u8>(length);
+            return op;
+        }
+
+        //token, literals and optionally the match. matchLength = 0 means the last literals.
+        FY_FINLINE u8* WriteSequence(u8* op, u8* opEnd, const u8* literals, usize literalLength, usize offset, usize matchLength)
+        {
+            usize required = 1 + LengthBytes(literalLength) + literalLength;
+            if (matchLength > 0)
+            {
+                required += 2 + LengthBytes(matchLength - MinMatch);
+            }
+
+            if (static_cast<usize>(opEnd - op) < required)
+            {
+                return nullptr;
+            }
+
+            u8* token = op++;
+            *token = static_cast<u8>((literalLength < 15 ? literalLength : 15) << 4);
+            if (literalLength >= 15)
+            {
+                op = WriteLength(op, literalLength);
+            }
+
+            memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            if (matchLength > 0)
+            {
+                *op++ = static_cast<u8>(offset);
+                *op++ = static_cast<u8>(offset >> 8);
+
+                usize length = matchLength - MinMatch;
+                *token |= static_cast<u8>(length < 15 ? length : 15);
+                if (length >= 15)
+                {
+                    op = WriteLength(op, length);
+                }
+            }
+            return op;
+        }
+
+        FY_FINLINE bool ReadLength(const u8*& ip, const u8* ipEnd, usize& length)
+        {
+            u8 value;
+            do
+            {
+                if (ip >= ipEnd) return false;
+                value = *ip++;
+                length += value;
+            }
+            while (value == 255);
+            return true;
+        }
+    }
+
+    usize Compression::CompressBound(usize size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    usize Compression::Compress(const u8* src, usize srcSize, u8* dst, usize dstCapacity)
+    {
+        u8* op = dst;
+        u8* opEnd = dst + dstCapacity;
+        usize anchor = 0;
+
+        if (srcSize > MatchFindLimit)
+        {
+            u32 table[1 << HashBits]{};
+
+            usize limit = srcSize - MatchFindLimit;
+            usize matchLimit = srcSize - LastLiterals;
+            usize ip = 1;
+            table[HashSequence(Read32(src))] = 0;
+
+            while (ip < limit)
+            {
+                u32 sequence = Read32(src + ip);
+                u32 hash = HashSequence(sequence);
+                usize ref = table[hash];
+                table[hash] = static_cast<u32>(ip);
+
+                if (ref >= ip || ip - ref > MaxDistance || Read32(src + ref) != sequence)
+                {
+                    //incompressible data is skipped faster the longer it goes without a match.
+                    ip += 1 + ((ip - anchor) >> SkipTrigger);
+                    continue;
+                }
+
+                while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+                {
+                    ip--;
+                    ref--;
+                }
+
+                usize length = MinMatch;
+                while (ip + length < matchLimit && src[ip + length] == src[ref + length])
+                {
+                    length++;
+                }
+
+                op = WriteSequence(op, opEnd, src + anchor, ip - anchor, ip - ref, length);
+                if (op == nullptr)
+                {
+                    return 0;
+                }
+
+                ip += length;
+                anchor = ip;
+
+                if (ip < limit)
+                {
+                    table[HashSequence(Read32(src + ip - 2))] = static_cast<u32>(ip - 2);
+                }
+            }
+        }
+
+        op = WriteSequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0);
+        if (op == nullptr)
+        {
+            return 0;
+        }
+        return op - dst;
+    }
+
+    usize Compression::Decompress(const u8* src, usize srcSize, u8* dst, usize dstCapacity)
+    {
+        const u8* ip = src;
+        const u8* ipEnd = src + srcSize;
+        u8* op = dst;
+        u8* opEnd = dst + dstCapacity;
+
+        while (ip < ipEnd)
+        {
+            u8 token = *ip++;
+
+            usize literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(ip, ipEnd, literalLength))
+            {
+                return 0;
+            }
+
+            if (static_cast<usize>(ipEnd - ip) < literalLength || static_cast<usize>(opEnd - op) < literalLength)
+            {
+                return 0;
+            }
+
+            memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            //the last sequence has only literals.
+            if (ip == ipEnd)
+            {
+                break;
+            }
+
+            if (ipEnd - ip < 2)
+            {
+                return 0;
+            }
+
+            usize offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+
+            if (offset == 0 || offset > static_cast<usize>(op - dst))
+            {
+                return 0;
+            }
+
+            usize matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength))
+            {
+                return 0;
+            }
+            matchLength += MinMatch;
+
+            if (static_cast<usize>(opEnd - op) < matchLength)
+            {
+                return 0;
+            }
+
+            const u8* match = op - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                //overlapping copy repeats the last offset bytes.
+                for (usize i = 0; i < matchLength; ++i)
+                {
+                    *op++ = *match++;
+                }
+            }
+        }
+
+        return op - dst;
+    }
+}
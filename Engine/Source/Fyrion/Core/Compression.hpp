@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Fyrion/Common.hpp"
+
+namespace Fyrion::Compression
+{
+    //LZ4 block style codec: greedy matching with a 64KB window, no entropy stage.
+    //it favours decode speed, decoding is just literal and match copies.
+
+    FY_API usize CompressBound(usize size);
+
+    //returns the compressed size or 0 if it doesn't fit on dstCapacity.
+    FY_API usize Compress(const u8* src, usize srcSize, u8* dst, usize dstCapacity);
+
+    //returns the decompressed size or 0 if src is malformed or doesn't fit on dstCapacity.
+    FY_API usize Decompress(const u8* src, usize srcSize, u8* dst, usize dstCapacity);
+}
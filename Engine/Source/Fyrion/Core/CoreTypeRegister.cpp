@@ -28,6 +28,7 @@ namespace Fyrion
         Registry::Type<Array<u8>>("Fyrion::ByteArray");
         Registry::Type<String>("Fyrion::String");
         Registry::Type<StringView>("Fyrion::StringView");
+        Registry::Type<Array<String>>("Fyrion::StringArray");
 
         auto any = Registry::Type<Any>();
         any.Function<&Any::Get>("Get");
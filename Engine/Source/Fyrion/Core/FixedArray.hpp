@@ -75,6 +75,11 @@ namespace Fyrion
 			return begin()[idx];
 		}
 
+		const T& operator[](usize idx) const
+		{
+			return begin()[idx];
+		}
+
 		constexpr const T& Back() const
 		{
 			return *begin()[Size() - 1];
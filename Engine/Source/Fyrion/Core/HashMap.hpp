@@ -91,6 +91,7 @@ namespace Fyrion
 	FY_FINLINE HashMap<Key, Value>::HashMap(HashMap&& other) noexcept
 	{
 		m_buckets.Swap(other.m_buckets);
+		m_size = other.m_size;
 		other.m_size = 0;
 	}
 
@@ -305,7 +306,7 @@ namespace Fyrion
         m_buckets.Swap(other.m_buckets);
         usize size = other.m_size;
         other.m_size = this->m_size;
-        other.m_size = size;
+        this->m_size = size;
     }
 
     template<typename Key, typename Value>
@@ -0,0 +1,59 @@
+#include "Parallel.hpp"
+#include "Array.hpp"
+
+#include <thread>
+#include <atomic>
+
+namespace Fyrion
+{
+    u32 Parallel::GetWorkerCount()
+    {
+        u32 count = std::thread::hardware_concurrency();
+        return count > 0 ? count : 1;
+    }
+
+    void Parallel::For(usize count, u32 maxWorkers, VoidPtr userData, FnParallelTask task)
+    {
+        if (count == 0) return;
+
+        u32 workers = maxWorkers > 0 ? maxWorkers : GetWorkerCount();
+        if (workers > count)
+        {
+            workers = static_cast<u32>(count);
+        }
+
+        if (workers <= 1)
+        {
+            for (usize i = 0; i < count; ++i)
+            {
+                task(userData, i);
+            }
+            return;
+        }
+
+        std::atomic_size_t next{};
+
+        auto run = [&]()
+        {
+            usize index;
+            while ((index = next.fetch_add(1, std::memory_order_relaxed)) < count)
+            {
+                task(userData, index);
+            }
+        };
+
+        Array<std::thread> threads{};
+        threads.Reserve(workers - 1);
+        for (u32 i = 0; i < workers - 1; ++i)
+        {
+            threads.EmplaceBack(run);
+        }
+
+        run();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Fyrion/Common.hpp"
+#include "Traits.hpp"
+
+namespace Fyrion
+{
+    typedef void(*FnParallelTask)(VoidPtr userData, usize index);
+}
+
+namespace Fyrion::Parallel
+{
+    FY_API u32  GetWorkerCount();
+    FY_API void For(usize count, u32 maxWorkers, VoidPtr userData, FnParallelTask task);
+
+    //runs task(index) for every index in [0, count) using at most maxWorkers threads, the calling thread included.
+    //maxWorkers = 0 uses GetWorkerCount(). returns when all indices are processed.
+    template<typename Func>
+    void For(usize count, u32 maxWorkers, Func&& func)
+    {
+        For(count, maxWorkers, (VoidPtr) &func, [](VoidPtr userData, usize index)
+        {
+            (*static_cast<Traits::RemoveReference<Func>*>(userData))(index);
+        });
+    }
+}
@@ -0,0 +1,234 @@
+#include "Profiler.hpp"
+
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/Math.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::Profiler");
+
+        constexpr usize MaxProfileFrames = 240;
+
+        Array<ProfileFrame> frames{};
+        usize               frameCount{};
+        ProfileFrame*       currentFrame{};
+        Array<u32>          openScopes{};
+        f64                 startTime{};
+        f64                 frameStartTime{};
+        bool                enabled = true;
+
+        void AppendEscaped(String& json, const StringView& value)
+        {
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    json.Append('\\');
+                }
+                json.Append(c < 0x20 ? ' ' : c);
+            }
+        }
+
+        void AppendScopes(String& json, bool& first, const ProfileFrame& frame, Span<ProfileScope> scopes, u32 thread)
+        {
+            for (const ProfileScope& scope : scopes)
+            {
+                if (!first)
+                {
+                    json.Append(",\n");
+                }
+                first = false;
+
+                json.Append("{\"name\":\"");
+                AppendEscaped(json, scope.name);
+                json.Append("\",\"ph\":\"X\",\"pid\":0,\"tid\":");
+                json.Append(thread);
+                json.Append(",\"ts\":");
+                json.Append((frame.start + scope.begin) * 1000000.0);
+                json.Append(",\"dur\":");
+                json.Append(Math::Max(scope.end - scope.begin, 0.0) * 1000000.0);
+                json.Append(",\"args\":{\"frame\":");
+                json.Append(frame.frame);
+                json.Append("}}");
+            }
+        }
+    }
+
+    void Profiler::Reset()
+    {
+        frames = {};
+        frameCount = 0;
+        currentFrame = nullptr;
+        openScopes.Clear();
+        startTime = Platform::GetTime();
+    }
+
+    void Profiler::SetEnabled(bool enabled)
+    {
+        Fyrion::enabled = enabled;
+    }
+
+    bool Profiler::IsEnabled()
+    {
+        return enabled;
+    }
+
+    void Profiler::BeginFrame(u64 frame)
+    {
+        currentFrame = nullptr;
+        openScopes.Clear();
+
+        if (!enabled)
+        {
+            return;
+        }
+
+        if (frames.Empty())
+        {
+            frames.Resize(MaxProfileFrames);
+        }
+
+        frameStartTime = Platform::GetTime();
+
+        //slots are reused, the scope arrays keep their capacity between frames.
+        currentFrame = &frames[frameCount % MaxProfileFrames];
+        currentFrame->frame = frame;
+        currentFrame->start = frameStartTime - startTime;
+        currentFrame->cpuTime = 0;
+        currentFrame->gpuTime = 0;
+        currentFrame->gpuResolved = false;
+        currentFrame->cpuScopes.Clear();
+        currentFrame->gpuScopes.Clear();
+        frameCount++;
+    }
+
+    void Profiler::EndFrame()
+    {
+        if (!currentFrame)
+        {
+            return;
+        }
+
+        while (!openScopes.Empty())
+        {
+            EndScope();
+        }
+
+        currentFrame->cpuTime = Platform::GetTime() - frameStartTime;
+        currentFrame = nullptr;
+    }
+
+    void Profiler::BeginScope(const StringView& name)
+    {
+        if (!currentFrame)
+        {
+            return;
+        }
+
+        openScopes.EmplaceBack(static_cast<u32>(currentFrame->cpuScopes.Size()));
+        currentFrame->cpuScopes.EmplaceBack(ProfileScope{
+            .name = name,
+            .depth = static_cast<u32>(openScopes.Size() - 1),
+            .begin = Platform::GetTime() - frameStartTime
+        });
+    }
+
+    void Profiler::EndScope()
+    {
+        if (!currentFrame || openScopes.Empty())
+        {
+            return;
+        }
+
+        currentFrame->cpuScopes[openScopes.Back()].end = Platform::GetTime() - frameStartTime;
+        openScopes.PopBack();
+    }
+
+    void Profiler::SetGPUScopes(u64 frame, Span<ProfileScope> scopes)
+    {
+        ProfileFrame* profileFrame = const_cast<ProfileFrame*>(FindFrame(frame));
+        if (!profileFrame)
+        {
+            return;
+        }
+
+        profileFrame->gpuScopes = scopes;
+        profileFrame->gpuResolved = true;
+        profileFrame->gpuTime = 0;
+
+        for (const ProfileScope& scope : scopes)
+        {
+            if (scope.depth == 0)
+            {
+                profileFrame->gpuTime += scope.end - scope.begin;
+            }
+        }
+    }
+
+    usize Profiler::GetFrameCount()
+    {
+        return Math::Min(frameCount, MaxProfileFrames);
+    }
+
+    const ProfileFrame& Profiler::GetFrame(usize index)
+    {
+        FY_ASSERT(index < GetFrameCount(), "index out of range");
+        return frames[(frameCount - GetFrameCount() + index) % MaxProfileFrames];
+    }
+
+    const ProfileFrame* Profiler::FindFrame(u64 frame)
+    {
+        for (usize i = 0; i < GetFrameCount(); ++i)
+        {
+            const ProfileFrame& profileFrame = GetFrame(i);
+            if (profileFrame.frame == frame)
+            {
+                return &profileFrame;
+            }
+        }
+        return nullptr;
+    }
+
+    String Profiler::ExportChromeTrace()
+    {
+        //gpu scopes are placed at the start of their cpu frame, the gpu clock is not calibrated against the cpu clock.
+        String json = "{\"traceEvents\":[\n";
+        json.Append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n");
+        json.Append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"GPU\"}}");
+
+        bool first = false;
+        for (usize i = 0; i < GetFrameCount(); ++i)
+        {
+            const ProfileFrame& frame = GetFrame(i);
+            AppendScopes(json, first, frame, frame.cpuScopes, 0);
+            AppendScopes(json, first, frame, frame.gpuScopes, 1);
+        }
+
+        json.Append("\n]}\n");
+        return json;
+    }
+
+    bool Profiler::ExportChromeTrace(const StringView& path)
+    {
+        String json = ExportChromeTrace();
+
+        FileHandler fileHandler = FileSystem::OpenFile(path, AccessMode::WriteOnly);
+        if (fileHandler)
+        {
+            bool written = FileSystem::WriteFile(fileHandler, json.CStr(), json.Size()) == json.Size();
+            FileSystem::CloseFile(fileHandler);
+            if (written)
+            {
+                logger.Info("chrome trace exported to {}", path);
+                return true;
+            }
+        }
+
+        logger.Error("failed to export chrome trace to {}", path);
+        return false;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Fyrion/Common.hpp"
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/Span.hpp"
+#include "Fyrion/Core/String.hpp"
+#include "Fyrion/Core/StringView.hpp"
+
+namespace Fyrion
+{
+    //times in seconds since the start of the frame.
+    struct ProfileScope
+    {
+        String name{};
+        u32    depth{};
+        f64    begin{};
+        f64    end{};
+    };
+
+    //start is in seconds since the profiler was reset, gpu scopes arrive frames in flight frames after the cpu scopes.
+    struct ProfileFrame
+    {
+        u64                 frame{};
+        f64                 start{};
+        f64                 cpuTime{};
+        f64                 gpuTime{};
+        bool                gpuResolved{};
+        Array<ProfileScope> cpuScopes{};
+        Array<ProfileScope> gpuScopes{};
+    };
+
+    //keeps the last frames, scopes are measured on the thread that calls BeginFrame.
+    namespace Profiler
+    {
+        FY_API void                Reset();
+        FY_API void                SetEnabled(bool enabled);
+        FY_API bool                IsEnabled();
+        FY_API void                BeginFrame(u64 frame);
+        FY_API void                EndFrame();
+        FY_API void                BeginScope(const StringView& name);
+        FY_API void                EndScope();
+        FY_API void                SetGPUScopes(u64 frame, Span<ProfileScope> scopes);
+        FY_API usize               GetFrameCount();
+        FY_API const ProfileFrame& GetFrame(usize index);
+        FY_API const ProfileFrame* FindFrame(u64 frame);
+        FY_API String              ExportChromeTrace();
+        FY_API bool                ExportChromeTrace(const StringView& path);
+    }
+
+    struct ProfileScopeGuard
+    {
+        explicit ProfileScopeGuard(const StringView& name)
+        {
+            Profiler::BeginScope(name);
+        }
+
+        ~ProfileScopeGuard()
+        {
+            Profiler::EndScope();
+        }
+
+        FY_NO_COPY_CONSTRUCTOR(ProfileScopeGuard);
+    };
+}
+
+#define FY_PROFILE_SCOPE_NAME_INNER(line) profileScope##line
+#define FY_PROFILE_SCOPE_NAME(line) FY_PROFILE_SCOPE_NAME_INNER(line)
+#define FY_PROFILE_SCOPE(name) Fyrion::ProfileScopeGuard FY_PROFILE_SCOPE_NAME(__LINE__){name}
@@ -1,5 +1,6 @@
 #include "Engine.hpp"
 #include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/Profiler.hpp"
 #include "Fyrion/Platform/PlatformTypes.hpp"
 #include "Fyrion/Platform/Platform.hpp"
 #include "Fyrion/Graphics/GraphicsTypes.hpp"
@@ -16,7 +17,7 @@ namespace Fyrion
 {
     void            PlatformInit();
     void            PlatformShutdown();
-    void            GraphicsInit();
+    void            GraphicsInit(bool headless);
     void            GraphicsCreateDevice(Adapter adapter);
     RenderCommands& GraphicsBeginFrame();
     void            GraphicsEndFrame(Swapchain swapchain);
@@ -27,6 +28,7 @@ namespace Fyrion
     void            RepositoryShutdown();
     void            ResourceAssetsInit();
     void            ResourceAssetsShutdown();
+    void            ResourceAssetsUpdate();
     void            RegisterAssets();
     void            SceneManagerInit();
     void            SceneManagerShutdown();
@@ -34,6 +36,7 @@ namespace Fyrion
     void            ShaderManagerShutdown();
     void            DefaultRenderPipelineInit();
     void            DefaultRenderPipelineShutdown();
+    void            AsyncIOShutdown();
 
 
     namespace
@@ -47,6 +50,47 @@ namespace Fyrion
         f64         deltaTime{};
         u64         frame{0};
         ArgParser   args{};
+        bool        headless{};
+        bool        hasContext{};
+        Extent      headlessExtent{};
+        FrameStats  frameStats{};
+        FramePacer  framePacer{};
+        f64         frameStatsReportTime{};
+        u64         frameStatsReportFrames{};
+        f64         frameStatsReportMax{};
+
+        constexpr f64 FrameStatsReportInterval = 5.0;
+
+        void UpdateFrameStats(f64 frameTime)
+        {
+            frameStats.frames++;
+            frameStats.lastFrameTime = frameTime;
+            frameStats.totalFrameTime += frameTime;
+            frameStats.averageFrameTime = frameStats.totalFrameTime / static_cast<f64>(frameStats.frames);
+            frameStats.maxFrameTime = Math::Max(frameStats.maxFrameTime, frameTime);
+
+            if (!headless)
+            {
+                return;
+            }
+
+            //without a window there is nothing else showing the engine is alive.
+            frameStatsReportFrames++;
+            frameStatsReportMax = Math::Max(frameStatsReportMax, frameTime);
+            f64 elapsed = lastTime - frameStatsReportTime;
+            if (elapsed >= FrameStatsReportInterval)
+            {
+                logger.Info("{} frames in {:.2f}s, avg {:.3f}ms, max {:.3f}ms",
+                            frameStatsReportFrames,
+                            elapsed,
+                            elapsed * 1000.0 / static_cast<f64>(frameStatsReportFrames),
+                            frameStatsReportMax * 1000.0);
+
+                frameStatsReportTime = lastTime;
+                frameStatsReportFrames = 0;
+                frameStatsReportMax = 0;
+            }
+        }
 
         EventHandler<OnInit> onInitHandler{};
         EventHandler<OnUpdate> onUpdateHandler{};
@@ -66,6 +110,15 @@ namespace Fyrion
     {
         args.Parse(argc, argv);
 
+        //event data is released on Destroy, handlers need to be resolved again when the engine is initialized twice.
+        onInitHandler = {};
+        onUpdateHandler = {};
+        onEndFrameHandler = {};
+        onShutdownHandler = {};
+        onShutdownRequest = {};
+        onRecordRenderCommands = {};
+        onSwapchainRender = {};
+
         RepositoryInit();
         TypeRegister();
         ShaderManagerInit();
@@ -79,6 +132,32 @@ namespace Fyrion
     {
         ResourceAssets::LoadAssetsFromDirectory("Fyrion", Path::Join(FileSystem::AssetFolder(), "Fyrion"));
 
+        headless = contextCreation.headless;
+        hasContext = true;
+        running = true;
+
+        //devices number their frames from creation, the engine frame matches the frame of the gpu timings.
+        frame = 0;
+        Profiler::Reset();
+        framePacer.Reset();
+        framePacer.SetLowLatency(contextCreation.lowLatency);
+
+        if (headless)
+        {
+            headlessExtent = contextCreation.resolution;
+
+            GraphicsInit(true);
+            GraphicsCreateDevice(Adapter{});
+            Graphics::SetFramesInFlight(contextCreation.framesInFlight);
+
+            swapchain = Graphics::CreateSwapchain(SwapchainCreation{
+                .presentMode = contextCreation.presentMode
+            });
+
+            onInitHandler.Invoke();
+            return;
+        }
+
         PlatformInit();
 
         WindowFlags windowFlags = WindowFlags::None;
@@ -92,14 +171,15 @@ namespace Fyrion
             windowFlags |= WindowFlags::Fullscreen;
         }
 
-        GraphicsInit();
+        GraphicsInit(false);
         GraphicsCreateDevice(Adapter{});
+        Graphics::SetFramesInFlight(contextCreation.framesInFlight);
 
         window = Platform::CreateWindow(contextCreation.title, contextCreation.resolution, windowFlags);
 
         swapchain = Graphics::CreateSwapchain(SwapchainCreation{
             .window = window,
-            .vsync = true
+            .presentMode = contextCreation.presentMode
         });
 
         ImGui::Init(window, swapchain);
@@ -110,7 +190,13 @@ namespace Fyrion
 
     void Engine::Run()
     {
-        logger.Info("Fyrion Engine {} Initialized", FY_VERSION);
+        logger.Info("Fyrion Engine {} Initialized{}", FY_VERSION, headless ? " (headless)" : "");
+
+        frameStats = {};
+        lastTime = Platform::GetTime();
+        frameStatsReportTime = lastTime;
+        frameStatsReportFrames = 0;
+        frameStatsReportMax = 0;
 
         while (running)
         {
@@ -118,30 +204,79 @@ namespace Fyrion
             deltaTime = currentTime - lastTime;
             lastTime  = currentTime;
 
-            Platform::ProcessEvents();
+            Profiler::BeginFrame(frame);
+            Profiler::BeginScope("Wait");
+
+            //the gpu is waited before sampling input, so the input is as recent as possible when the frame is recorded.
+            Graphics::WaitFrame();
+
+            u32 framesInFlight = Graphics::GetFramesInFlight();
+            if (frame >= framesInFlight)
+            {
+                framePacer.FrameCompleted(frame - framesInFlight, Platform::GetTime());
+            }
+
+            f64 delay = framePacer.GetDelay(Platform::GetTime());
+            Platform::Sleep(delay);
+            framePacer.BeginFrame(frame, Platform::GetTime(), delay);
+
+            Profiler::EndScope();
+            Profiler::BeginScope("Update");
+
+            if (!headless)
+            {
+                Platform::ProcessEvents();
+            }
 
-            ImGui::BeginFrame(window, deltaTime);
+            ResourceAssetsUpdate();
 
-            if (Platform::UserRequestedClose(window))
+            if (!headless)
             {
-                Shutdown();
-                if (running)
+                ImGui::BeginFrame(window, deltaTime);
+
+                if (Platform::UserRequestedClose(window))
                 {
-                    Platform::SetWindowShouldClose(window, false);
+                    Shutdown();
+                    if (running)
+                    {
+                        Platform::SetWindowShouldClose(window, false);
+                    }
                 }
             }
 
             onUpdateHandler.Invoke(deltaTime);
 
-            Extent extent = Platform::GetWindowExtent(window);
+            Profiler::EndScope();
+            Profiler::BeginScope("Record");
+
+            Extent extent = headless ? headlessExtent : Platform::GetWindowExtent(window);
 
             RenderCommands& cmd = GraphicsBeginFrame();
+
+            const GPUFrameTimings& gpuFrameTimings = Graphics::GetGPUFrameTimings();
+            if (gpuFrameTimings.frame != U64_MAX)
+            {
+                Profiler::SetGPUScopes(gpuFrameTimings.frame, gpuFrameTimings.scopes);
+
+                f64 gpuTime = 0;
+                for (const ProfileScope& scope : gpuFrameTimings.scopes)
+                {
+                    if (scope.depth == 0)
+                    {
+                        gpuTime += scope.end - scope.begin;
+                    }
+                }
+                framePacer.SetGPUTime(gpuTime);
+            }
+
             cmd.Begin();
+            cmd.BeginLabel("Frame", Vec4{0, 0, 0, 1});
 
             onRecordRenderCommands.Invoke(cmd, deltaTime);
 
             RenderPass renderPass = Graphics::AcquireNextRenderPass(swapchain);
 
+            cmd.BeginLabel("Swapchain", Vec4{0, 0, 0, 1});
             cmd.BeginRenderPass(BeginRenderPassInfo{
                 .renderPass = renderPass,
                 .clearValues = {&clearColor, 1}
@@ -157,31 +292,70 @@ namespace Fyrion
             cmd.SetViewport(viewportInfo);
             cmd.SetScissor(Rect{.x= 0, .y = 0, .width = extent.width, .height = extent.height});
 
-            ImGui::Render(cmd);
+            if (!headless)
+            {
+                ImGui::Render(cmd);
+            }
 
             onSwapchainRender.Invoke(cmd);
 
             cmd.EndRenderPass();
+            cmd.EndLabel();
+            cmd.EndLabel();
             cmd.End();
 
+            Profiler::EndScope();
+            Profiler::BeginScope("Submit");
+
             GraphicsEndFrame(swapchain);
+            framePacer.EndFrame(frame, Platform::GetTime());
+
+            Profiler::EndScope();
+            Profiler::BeginScope("EndFrame");
 
             Repository::GarbageCollect();
 
             onEndFrameHandler.Invoke();
 
+            Profiler::EndFrame();
+
             frame++;
+
+            UpdateFrameStats(Platform::GetTime() - currentTime);
+        }
+
+        DestroyContext();
+    }
+
+    void Engine::DestroyContext()
+    {
+        if (!hasContext)
+        {
+            return;
         }
 
+        hasContext = false;
+        running = false;
+
         Graphics::WaitQueue();
 
         onShutdownHandler.Invoke();
 
         Graphics::DestroySwapchain(swapchain);
-        Platform::DestroyWindow(window);
+        swapchain = {};
+
+        if (!headless)
+        {
+            Platform::DestroyWindow(window);
+            window = {};
+        }
 
         GraphicsShutdown();
-        PlatformShutdown();
+
+        if (!headless)
+        {
+            PlatformShutdown();
+        }
     }
 
     void Engine::Shutdown()
@@ -214,14 +388,41 @@ namespace Fyrion
         return frame;
     }
 
+    bool Engine::IsHeadless()
+    {
+        return headless;
+    }
+
+    FrameStats Engine::GetFrameStats()
+    {
+        return frameStats;
+    }
+
+    void Engine::SetLowLatency(bool lowLatency)
+    {
+        framePacer.SetLowLatency(lowLatency);
+    }
+
+    bool Engine::IsLowLatency()
+    {
+        return framePacer.IsLowLatency();
+    }
+
+    FramePacingStats Engine::GetFramePacingStats()
+    {
+        return framePacer.GetStats();
+    }
+
     void Engine::Destroy()
     {
         DefaultRenderPipelineShutdown();
         SceneManagerShutdown();
         ResourceAssetsShutdown();
+        AsyncIOShutdown();
         RepositoryShutdown();
         ShaderManagerShutdown();
         RegistryShutdown();
         EventShutdown();
+        Profiler::Reset();
     }
 }
\ No newline at end of file
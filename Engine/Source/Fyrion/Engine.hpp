@@ -4,11 +4,11 @@
 #include "Fyrion/Core/StringView.hpp"
 #include "Fyrion/Core/Math.hpp"
 #include "Fyrion/Core/Event.hpp"
+#include "Fyrion/Graphics/GraphicsTypes.hpp"
+#include "Fyrion/Graphics/FramePacer.hpp"
 
 namespace Fyrion
 {
-    class RenderCommands;
-
     using OnInit = EventType<"Fyrion::OnInit"_h, void()>;
     using OnUpdate = EventType<"Fyrion::OnUpdate"_h, void(f64 deltaTime)>;
     using OnEndFrame = EventType<"Fyrion::OnEndFrame"_h, void()>;
@@ -19,11 +19,24 @@ namespace Fyrion
 
     struct EngineContextCreation
     {
-        StringView title{};
-        Extent     resolution{};
-        bool       maximize{false};
-        bool       fullscreen{false};
-        bool       headless = false;
+        StringView  title{};
+        Extent      resolution{};
+        bool        maximize{false};
+        bool        fullscreen{false};
+        bool        headless = false;
+        PresentMode presentMode{PresentMode::Fifo};
+        u32         framesInFlight{FY_DEFAULT_FRAMES_IN_FLIGHT};
+        bool        lowLatency{false};
+    };
+
+    //frame times in seconds, measured by Engine::Run since it was started.
+    struct FrameStats
+    {
+        u64 frames{};
+        f64 lastFrameTime{};
+        f64 averageFrameTime{};
+        f64 maxFrameTime{};
+        f64 totalFrameTime{};
     };
 
 
@@ -33,9 +46,18 @@ namespace Fyrion
         static void Init(i32 argc, char** argv);
         static void CreateContext(const EngineContextCreation& contextCreation);
         static void Run();
+        //destroys the context created by CreateContext without running frames, Run calls it when it returns.
+        static void DestroyContext();
         static void Shutdown();
         static void Destroy();
         static u64  GetFrame();
+        static bool IsHeadless();
+
+        static FrameStats GetFrameStats();
+
+        static void             SetLowLatency(bool lowLatency);
+        static bool             IsLowLatency();
+        static FramePacingStats GetFramePacingStats();
 
         static StringView   GetArgByName(const StringView& name);
         static StringView   GetArgByIndex(usize i);
@@ -0,0 +1,603 @@
+#include "CommandStream.hpp"
+
+#include "Fyrion/Core/Algorithm.hpp"
+#include "Fyrion/Graphics/Device/Null/NullDevice.hpp"
+
+namespace Fyrion
+{
+    enum class CommandPacketType : u8
+    {
+        BeginRenderPass,
+        EndRenderPass,
+        SetViewport,
+        BindVertexBuffer,
+        BindIndexBuffer,
+        DrawIndexed,
+        Draw,
+        PushConstants,
+        BindBindingSet,
+        DrawIndexedIndirect,
+        BindPipelineState,
+        Dispatch,
+        TraceRays,
+        SetScissor,
+        BeginLabel,
+        EndLabel,
+        ResourceBarrier,
+        CopyBuffer,
+        BindBindlessHeap,
+        DrawIndexedIndirectCount,
+        FillBuffer,
+        BufferBarrier
+    };
+
+    struct alignas(16) CommandPacket
+    {
+        CommandPacket*    next{};
+        CommandPacketType type{};
+    };
+
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::CommandStream");
+
+        constexpr usize PacketAlignment = alignof(CommandPacket);
+
+        struct BeginRenderPassPacket
+        {
+            RenderPass             renderPass;
+            const Vec4*            clearValues;
+            usize                  clearValueCount;
+            ClearDepthStencilValue depthStencil;
+        };
+
+        struct BufferPacket
+        {
+            Buffer buffer;
+        };
+
+        struct DrawIndexedPacket
+        {
+            u32 indexCount;
+            u32 instanceCount;
+            u32 firstIndex;
+            i32 vertexOffset;
+            u32 firstInstance;
+        };
+
+        struct DrawPacket
+        {
+            u32 vertexCount;
+            u32 instanceCount;
+            u32 firstVertex;
+            u32 firstInstance;
+        };
+
+        struct PushConstantsPacket
+        {
+            PipelineState pipeline;
+            ShaderStage   stages;
+            const void*   data;
+            usize         size;
+        };
+
+        struct BindBindingSetPacket
+        {
+            PipelineState     pipeline;
+            const BindingSet* bindingSet;
+        };
+
+        struct DrawIndexedIndirectPacket
+        {
+            Buffer buffer;
+            usize  offset;
+            u32    drawCount;
+            u32    stride;
+        };
+
+        struct DrawIndexedIndirectCountPacket
+        {
+            Buffer buffer;
+            usize  offset;
+            Buffer countBuffer;
+            usize  countOffset;
+            u32    maxDrawCount;
+            u32    stride;
+        };
+
+        struct FillBufferPacket
+        {
+            Buffer buffer;
+            usize  offset;
+            usize  size;
+            u32    value;
+        };
+
+        struct PipelinePacket
+        {
+            PipelineState pipeline;
+        };
+
+        struct DispatchPacket
+        {
+            PipelineState pipeline;
+            u32           x;
+            u32           y;
+            u32           z;
+        };
+
+        struct BeginLabelPacket
+        {
+            const char* name;
+            usize       size;
+            Vec4        color;
+        };
+
+        struct CopyBufferPacket
+        {
+            Buffer                srcBuffer;
+            Buffer                dstBuffer;
+            const BufferCopyInfo* copies;
+            usize                 count;
+        };
+
+        template<typename T>
+        FY_FINLINE const T& Payload(const CommandPacket* packet)
+        {
+            return *reinterpret_cast<const T*>(reinterpret_cast<const u8*>(packet) + sizeof(CommandPacket));
+        }
+
+        struct SortEntry
+        {
+            u64 sortKey;
+            u32 stream;
+            u32 group;
+        };
+    }
+
+    CommandStream::~CommandStream()
+    {
+        for (Chunk& chunk : m_chunks)
+        {
+            MemoryGlobals::GetDefaultAllocator().MemFree(chunk.memory);
+        }
+    }
+
+    VoidPtr CommandStream::Allocate(usize size)
+    {
+        size = (size + PacketAlignment - 1) & ~(PacketAlignment - 1);
+
+        if (m_chunkIndex < m_chunks.Size() && m_chunkOffset + size <= m_chunks[m_chunkIndex].size)
+        {
+            VoidPtr ptr = m_chunks[m_chunkIndex].memory + m_chunkOffset;
+            m_chunkOffset += size;
+            return ptr;
+        }
+
+        //chunks are kept after Reset, the first one with enough space is reused.
+        usize next = m_chunks.Empty() ? 0 : m_chunkIndex + 1;
+        while (next < m_chunks.Size() && m_chunks[next].size < size)
+        {
+            next++;
+        }
+
+        if (next == m_chunks.Size())
+        {
+            usize chunkSize = Math::Max(ChunkSize, size);
+            m_chunks.EmplaceBack(Chunk{
+                .memory = static_cast<u8*>(MemoryGlobals::GetDefaultAllocator().MemAlloc(chunkSize, PacketAlignment)),
+                .size = chunkSize
+            });
+        }
+
+        m_chunkIndex = next;
+        m_chunkOffset = size;
+        return m_chunks[next].memory;
+    }
+
+    VoidPtr CommandStream::AddPacket(u8 type, usize size)
+    {
+        CommandPacket* packet = static_cast<CommandPacket*>(Allocate(sizeof(CommandPacket) + size));
+        packet->next = nullptr;
+        packet->type = static_cast<CommandPacketType>(type);
+
+        if (m_groups.Empty())
+        {
+            m_groups.EmplaceBack(Group{.sortKey = m_sortKey});
+        }
+
+        Group& group = m_groups.Back();
+        if (group.last)
+        {
+            group.last->next = packet;
+        }
+        else
+        {
+            group.first = packet;
+        }
+        group.last = packet;
+        m_packetCount++;
+
+        return reinterpret_cast<u8*>(packet) + sizeof(CommandPacket);
+    }
+
+    void CommandStream::SetSortKey(u64 sortKey)
+    {
+        if (m_sortKey == sortKey)
+        {
+            return;
+        }
+
+        m_sortKey = sortKey;
+
+        if (!m_groups.Empty() && m_groups.Back().first == nullptr)
+        {
+            m_groups.Back().sortKey = sortKey;
+        }
+        else if (!m_groups.Empty())
+        {
+            m_groups.EmplaceBack(Group{.sortKey = sortKey});
+        }
+    }
+
+    u64 CommandStream::GetSortKey() const
+    {
+        return m_sortKey;
+    }
+
+    void CommandStream::Reset()
+    {
+        m_groups.Clear();
+        m_chunkIndex = 0;
+        m_chunkOffset = 0;
+        m_sortKey = 0;
+        m_packetCount = 0;
+    }
+
+    bool CommandStream::IsEmpty() const
+    {
+        return m_packetCount == 0;
+    }
+
+    u32 CommandStream::GetPacketCount() const
+    {
+        return m_packetCount;
+    }
+
+    usize CommandStream::GetMemoryUsage() const
+    {
+        usize usage = 0;
+        for (const Chunk& chunk : m_chunks)
+        {
+            usage += chunk.size;
+        }
+        return usage;
+    }
+
+    void CommandStream::Begin()
+    {
+        Reset();
+    }
+
+    void CommandStream::End() {}
+
+    void CommandStream::BeginRenderPass(const BeginRenderPassInfo& beginRenderPassInfo)
+    {
+        Vec4* clearValues = nullptr;
+        if (!beginRenderPassInfo.clearValues.Empty())
+        {
+            clearValues = static_cast<Vec4*>(Allocate(sizeof(Vec4) * beginRenderPassInfo.clearValues.Size()));
+            MemCopy(clearValues, beginRenderPassInfo.clearValues.Data(), sizeof(Vec4) * beginRenderPassInfo.clearValues.Size());
+        }
+
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BeginRenderPass), sizeof(BeginRenderPassPacket))) BeginRenderPassPacket{
+            .renderPass = beginRenderPassInfo.renderPass,
+            .clearValues = clearValues,
+            .clearValueCount = beginRenderPassInfo.clearValues.Size(),
+            .depthStencil = beginRenderPassInfo.depthStencil
+        };
+    }
+
+    void CommandStream::EndRenderPass()
+    {
+        AddPacket(static_cast<u8>(CommandPacketType::EndRenderPass), 0);
+    }
+
+    void CommandStream::SetViewport(const ViewportInfo& viewportInfo)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::SetViewport), sizeof(ViewportInfo))) ViewportInfo{viewportInfo};
+    }
+
+    void CommandStream::BindVertexBuffer(const Buffer& gpuBuffer)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BindVertexBuffer), sizeof(BufferPacket))) BufferPacket{gpuBuffer};
+    }
+
+    void CommandStream::BindIndexBuffer(const Buffer& gpuBuffer)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BindIndexBuffer), sizeof(BufferPacket))) BufferPacket{gpuBuffer};
+    }
+
+    void CommandStream::DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::DrawIndexed), sizeof(DrawIndexedPacket))) DrawIndexedPacket{
+            indexCount, instanceCount, firstIndex, vertexOffset, firstInstance
+        };
+    }
+
+    void CommandStream::Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::Draw), sizeof(DrawPacket))) DrawPacket{
+            vertexCount, instanceCount, firstVertex, firstInstance
+        };
+    }
+
+    void CommandStream::PushConstants(const PipelineState& pipeline, ShaderStage stages, const void* data, usize size)
+    {
+        VoidPtr copy = Allocate(size);
+        MemCopy(copy, data, size);
+
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::PushConstants), sizeof(PushConstantsPacket))) PushConstantsPacket{
+            pipeline, stages, copy, size
+        };
+    }
+
+    void CommandStream::BindBindingSet(const PipelineState& pipeline, const BindingSet& bindingSet)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BindBindingSet), sizeof(BindBindingSetPacket))) BindBindingSetPacket{
+            pipeline, &bindingSet
+        };
+    }
+
+    void CommandStream::DrawIndexedIndirect(const Buffer& buffer, usize offset, u32 drawCount, u32 stride)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::DrawIndexedIndirect), sizeof(DrawIndexedIndirectPacket))) DrawIndexedIndirectPacket{
+            buffer, offset, drawCount, stride
+        };
+    }
+
+    void CommandStream::BindPipelineState(const PipelineState& pipeline)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BindPipelineState), sizeof(PipelinePacket))) PipelinePacket{pipeline};
+    }
+
+    void CommandStream::Dispatch(u32 x, u32 y, u32 z)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::Dispatch), sizeof(DispatchPacket))) DispatchPacket{{}, x, y, z};
+    }
+
+    void CommandStream::TraceRays(PipelineState pipeline, u32 x, u32 y, u32 z)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::TraceRays), sizeof(DispatchPacket))) DispatchPacket{pipeline, x, y, z};
+    }
+
+    void CommandStream::SetScissor(const Rect& rect)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::SetScissor), sizeof(Rect))) Rect{rect};
+    }
+
+    void CommandStream::BeginLabel(const StringView& name, const Vec4& color)
+    {
+        char* copy = static_cast<char*>(Allocate(name.Size() + 1));
+        MemCopy(copy, name.CStr(), name.Size());
+        copy[name.Size()] = '\0';
+
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BeginLabel), sizeof(BeginLabelPacket))) BeginLabelPacket{
+            copy, name.Size(), color
+        };
+    }
+
+    void CommandStream::EndLabel()
+    {
+        AddPacket(static_cast<u8>(CommandPacketType::EndLabel), 0);
+    }
+
+    void CommandStream::ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::ResourceBarrier), sizeof(ResourceBarrierInfo))) ResourceBarrierInfo{resourceBarrierInfo};
+    }
+
+    void CommandStream::CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info)
+    {
+        BufferCopyInfo* copies = static_cast<BufferCopyInfo*>(Allocate(sizeof(BufferCopyInfo) * info.Size()));
+        MemCopy(copies, info.Data(), sizeof(BufferCopyInfo) * info.Size());
+
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::CopyBuffer), sizeof(CopyBufferPacket))) CopyBufferPacket{
+            srcBuffer, dstBuffer, copies, info.Size()
+        };
+    }
+
+    void CommandStream::BindBindlessHeap(const PipelineState& pipeline)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BindBindlessHeap), sizeof(PipelinePacket))) PipelinePacket{pipeline};
+    }
+
+    void CommandStream::DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::DrawIndexedIndirectCount), sizeof(DrawIndexedIndirectCountPacket))) DrawIndexedIndirectCountPacket{
+            buffer, offset, countBuffer, countOffset, maxDrawCount, stride
+        };
+    }
+
+    void CommandStream::FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::FillBuffer), sizeof(FillBufferPacket))) FillBufferPacket{buffer, offset, size, value};
+    }
+
+    void CommandStream::BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo)
+    {
+        new(PlaceHolder(), AddPacket(static_cast<u8>(CommandPacketType::BufferBarrier), sizeof(BufferBarrierInfo))) BufferBarrierInfo{bufferBarrierInfo};
+    }
+
+    void CommandStream::SubmitAndWait(GPUQueue queue)
+    {
+        FY_ASSERT(false, "command streams are executed by the frame commands, they can't be submitted");
+    }
+
+    void CommandStream::ExecuteGroup(const Group& group, RenderCommands& renderCommands) const
+    {
+        for (const CommandPacket* packet = group.first; packet != nullptr; packet = packet->next)
+        {
+            switch (packet->type)
+            {
+                case CommandPacketType::BeginRenderPass:
+                {
+                    const BeginRenderPassPacket& data = Payload<BeginRenderPassPacket>(packet);
+                    renderCommands.BeginRenderPass(BeginRenderPassInfo{
+                        .renderPass = data.renderPass,
+                        .clearValues = {const_cast<Vec4*>(data.clearValues), data.clearValueCount},
+                        .depthStencil = data.depthStencil
+                    });
+                    break;
+                }
+                case CommandPacketType::EndRenderPass:
+                    renderCommands.EndRenderPass();
+                    break;
+                case CommandPacketType::SetViewport:
+                    renderCommands.SetViewport(Payload<ViewportInfo>(packet));
+                    break;
+                case CommandPacketType::BindVertexBuffer:
+                    renderCommands.BindVertexBuffer(Payload<BufferPacket>(packet).buffer);
+                    break;
+                case CommandPacketType::BindIndexBuffer:
+                    renderCommands.BindIndexBuffer(Payload<BufferPacket>(packet).buffer);
+                    break;
+                case CommandPacketType::DrawIndexed:
+                {
+                    const DrawIndexedPacket& data = Payload<DrawIndexedPacket>(packet);
+                    renderCommands.DrawIndexed(data.indexCount, data.instanceCount, data.firstIndex, data.vertexOffset, data.firstInstance);
+                    break;
+                }
+                case CommandPacketType::Draw:
+                {
+                    const DrawPacket& data = Payload<DrawPacket>(packet);
+                    renderCommands.Draw(data.vertexCount, data.instanceCount, data.firstVertex, data.firstInstance);
+                    break;
+                }
+                case CommandPacketType::PushConstants:
+                {
+                    const PushConstantsPacket& data = Payload<PushConstantsPacket>(packet);
+                    renderCommands.PushConstants(data.pipeline, data.stages, data.data, data.size);
+                    break;
+                }
+                case CommandPacketType::BindBindingSet:
+                {
+                    const BindBindingSetPacket& data = Payload<BindBindingSetPacket>(packet);
+                    renderCommands.BindBindingSet(data.pipeline, *data.bindingSet);
+                    break;
+                }
+                case CommandPacketType::DrawIndexedIndirect:
+                {
+                    const DrawIndexedIndirectPacket& data = Payload<DrawIndexedIndirectPacket>(packet);
+                    renderCommands.DrawIndexedIndirect(data.buffer, data.offset, data.drawCount, data.stride);
+                    break;
+                }
+                case CommandPacketType::BindPipelineState:
+                    renderCommands.BindPipelineState(Payload<PipelinePacket>(packet).pipeline);
+                    break;
+                case CommandPacketType::Dispatch:
+                {
+                    const DispatchPacket& data = Payload<DispatchPacket>(packet);
+                    renderCommands.Dispatch(data.x, data.y, data.z);
+                    break;
+                }
+                case CommandPacketType::TraceRays:
+                {
+                    const DispatchPacket& data = Payload<DispatchPacket>(packet);
+                    renderCommands.TraceRays(data.pipeline, data.x, data.y, data.z);
+                    break;
+                }
+                case CommandPacketType::SetScissor:
+                    renderCommands.SetScissor(Payload<Rect>(packet));
+                    break;
+                case CommandPacketType::BeginLabel:
+                {
+                    const BeginLabelPacket& data = Payload<BeginLabelPacket>(packet);
+                    renderCommands.BeginLabel(StringView{data.name, data.size}, data.color);
+                    break;
+                }
+                case CommandPacketType::EndLabel:
+                    renderCommands.EndLabel();
+                    break;
+                case CommandPacketType::ResourceBarrier:
+                    renderCommands.ResourceBarrier(Payload<ResourceBarrierInfo>(packet));
+                    break;
+                case CommandPacketType::CopyBuffer:
+                {
+                    const CopyBufferPacket& data = Payload<CopyBufferPacket>(packet);
+                    renderCommands.CopyBuffer(data.srcBuffer, data.dstBuffer, {const_cast<BufferCopyInfo*>(data.copies), data.count});
+                    break;
+                }
+                case CommandPacketType::BindBindlessHeap:
+                    renderCommands.BindBindlessHeap(Payload<PipelinePacket>(packet).pipeline);
+                    break;
+                case CommandPacketType::DrawIndexedIndirectCount:
+                {
+                    const DrawIndexedIndirectCountPacket& data = Payload<DrawIndexedIndirectCountPacket>(packet);
+                    renderCommands.DrawIndexedIndirectCount(data.buffer, data.offset, data.countBuffer, data.countOffset, data.maxDrawCount, data.stride);
+                    break;
+                }
+                case CommandPacketType::FillBuffer:
+                {
+                    const FillBufferPacket& data = Payload<FillBufferPacket>(packet);
+                    renderCommands.FillBuffer(data.buffer, data.offset, data.size, data.value);
+                    break;
+                }
+                case CommandPacketType::BufferBarrier:
+                    renderCommands.BufferBarrier(Payload<BufferBarrierInfo>(packet));
+                    break;
+            }
+        }
+    }
+
+    void CommandStream::Execute(Span<CommandStream*> streams, RenderCommands& renderCommands)
+    {
+        Array<SortEntry> entries{};
+        for (u32 s = 0; s < streams.Size(); ++s)
+        {
+            for (u32 g = 0; g < streams[s]->m_groups.Size(); ++g)
+            {
+                if (streams[s]->m_groups[g].first)
+                {
+                    entries.EmplaceBack(SortEntry{streams[s]->m_groups[g].sortKey, s, g});
+                }
+            }
+        }
+
+        //stream and group indices make the order total, equal keys keep the recording order.
+        auto compare = [](const SortEntry& left, const SortEntry& right)
+        {
+            if (left.sortKey != right.sortKey) return left.sortKey < right.sortKey;
+            if (left.stream != right.stream) return left.stream < right.stream;
+            return left.group < right.group;
+        };
+
+        //most frames record with increasing keys, avoid the quick sort worst case on them.
+        bool sorted = true;
+        for (usize i = 1; i < entries.Size() && sorted; ++i)
+        {
+            sorted = compare(entries[i - 1], entries[i]);
+        }
+
+        if (!sorted)
+        {
+            Sort(entries.begin(), entries.end(), compare);
+        }
+
+        for (const SortEntry& entry : entries)
+        {
+            const CommandStream* stream = streams[entry.stream];
+            stream->ExecuteGroup(stream->m_groups[entry.group], renderCommands);
+        }
+    }
+
+    u64 CommandStream::Validate(Span<CommandStream*> streams)
+    {
+        NullCommands nullCommands{logger};
+        nullCommands.validateOnly = true;
+        nullCommands.Begin();
+        Execute(streams, nullCommands);
+        nullCommands.End();
+        return nullCommands.errors;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Fyrion/Graphics/GraphicsTypes.hpp"
+
+namespace Fyrion
+{
+    struct CommandPacket;
+
+    //records commands as packets into chunks of linear memory. a stream is owned by a single thread,
+    //any number of streams can be recorded in parallel and then executed together ordered by sort key.
+    class FY_API CommandStream final : public RenderCommands
+    {
+    public:
+        static constexpr usize ChunkSize = 64 * 1024;
+
+        CommandStream() = default;
+        CommandStream(CommandStream&& other) noexcept = default;
+        CommandStream(const CommandStream&) = delete;
+        CommandStream& operator=(const CommandStream&) = delete;
+        ~CommandStream() override;
+
+        //commands recorded after this call are sorted with the key, recording order is kept between equal keys.
+        void SetSortKey(u64 sortKey);
+        u64  GetSortKey() const;
+        void Reset();
+        bool IsEmpty() const;
+        u32  GetPacketCount() const;
+        usize GetMemoryUsage() const;
+
+        void Begin() override;
+        void End() override;
+        void BeginRenderPass(const BeginRenderPassInfo& beginRenderPassInfo) override;
+        void EndRenderPass() override;
+        void SetViewport(const ViewportInfo& viewportInfo) override;
+        void BindVertexBuffer(const Buffer& gpuBuffer) override;
+        void BindIndexBuffer(const Buffer& gpuBuffer) override;
+        void DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance) override;
+        void Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) override;
+        void PushConstants(const PipelineState& pipeline, ShaderStage stages, const void* data, usize size) override;
+        void BindBindingSet(const PipelineState& pipeline, const BindingSet& bindingSet) override;
+        void DrawIndexedIndirect(const Buffer& buffer, usize offset, u32 drawCount, u32 stride) override;
+        void BindPipelineState(const PipelineState& pipeline) override;
+        void Dispatch(u32 x, u32 y, u32 z) override;
+        void TraceRays(PipelineState pipeline, u32 x, u32 y, u32 z) override;
+        void SetScissor(const Rect& rect) override;
+        void BeginLabel(const StringView& name, const Vec4& color) override;
+        void EndLabel() override;
+        void ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo) override;
+        void CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info) override;
+        void BindBindlessHeap(const PipelineState& pipeline) override;
+        void DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride) override;
+        void FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value) override;
+        void BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo) override;
+        void SubmitAndWait(GPUQueue queue) override;
+
+        //translates the packets of all streams to renderCommands, which must be recording.
+        static void Execute(Span<CommandStream*> streams, RenderCommands& renderCommands);
+
+        //executes the streams on a null device, returns the number of invalid commands.
+        static u64 Validate(Span<CommandStream*> streams);
+
+    private:
+        struct Group
+        {
+            u64            sortKey{};
+            CommandPacket* first{};
+            CommandPacket* last{};
+        };
+
+        struct Chunk
+        {
+            u8*   memory{};
+            usize size{};
+        };
+
+        Array<Chunk> m_chunks{};
+        Array<Group> m_groups{};
+        usize        m_chunkIndex{};
+        usize        m_chunkOffset{};
+        u64          m_sortKey{};
+        u32          m_packetCount{};
+
+        VoidPtr Allocate(usize size);
+        VoidPtr AddPacket(u8 type, usize size);
+        void    ExecuteGroup(const Group& group, RenderCommands& renderCommands) const;
+    };
+}
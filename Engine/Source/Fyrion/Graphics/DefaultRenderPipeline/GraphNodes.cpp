@@ -35,6 +35,9 @@ namespace Fyrion
         auto geometryRender = Registry::Type<GeometryRender>("Fyrion::GeometryRender");
         geometryRender.Field<&GeometryRender::vertexBuffer>("vertexBuffer").Attribute<GraphInput>();
         geometryRender.Field<&GeometryRender::indexBuffer>("indexBuffer").Attribute<GraphInput>();
+        geometryRender.Field<&GeometryRender::firstIndex>("firstIndex");
+        geometryRender.Field<&GeometryRender::indexCount>("indexCount");
+        geometryRender.Field<&GeometryRender::vertexOffset>("vertexOffset");
         geometryRender.Attribute<ResourceGraphOutput>("Outputs/Geometry Render");
 
         auto uploadGPUBuffer = Registry::Function<CreateBuffer>("Fyrion::CreateBuffer");
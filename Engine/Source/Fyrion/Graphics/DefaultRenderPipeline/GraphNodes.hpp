@@ -3,9 +3,13 @@
 
 namespace Fyrion
 {
+    //firstIndex, indexCount and vertexOffset locate the geometry when the buffers are shared, see DrawBatcher.
     struct GeometryRender
     {
         Buffer vertexBuffer{};
         Buffer indexBuffer{};
+        u32    firstIndex{};
+        u32    indexCount{};
+        i32    vertexOffset{};
     };
 }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Fyrion/Graphics/GraphicsTypes.hpp"
+
+namespace Fyrion
+{
+    //stable indices into one binding of the bindless heap. a freed index can still be read by the frames in flight,
+    //it's reused only after FY_FRAMES_IN_FLIGHT calls to NextFrame.
+    class BindlessIndexAllocator
+    {
+    public:
+        explicit BindlessIndexAllocator(u32 capacity = MaxBindlessResources) : m_capacity(capacity) {}
+
+        //returns U32_MAX when the heap is full
+        u32 Allocate()
+        {
+            if (!m_free.Empty())
+            {
+                u32 index = m_free.Back();
+                m_free.PopBack();
+                m_count++;
+                return index;
+            }
+
+            if (m_next < m_capacity)
+            {
+                m_count++;
+                return m_next++;
+            }
+            return U32_MAX;
+        }
+
+        void Free(u32 index)
+        {
+            if (index == U32_MAX)
+            {
+                return;
+            }
+            m_pending.EmplaceBack(PendingIndex{index, m_frame});
+            m_count--;
+        }
+
+        //must be called when the device waits for the oldest frame in flight.
+        void NextFrame()
+        {
+            m_frame++;
+
+            usize i = 0;
+            while (i < m_pending.Size())
+            {
+                if (m_pending[i].frame + FY_FRAMES_IN_FLIGHT <= m_frame)
+                {
+                    m_free.EmplaceBack(m_pending[i].index);
+                    m_pending[i] = m_pending.Back();
+                    m_pending.PopBack();
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+
+        u32 GetCapacity() const
+        {
+            return m_capacity;
+        }
+
+        void SetCapacity(u32 capacity)
+        {
+            m_capacity = capacity;
+        }
+
+        //indices in use, pending indices are not counted.
+        u32 GetCount() const
+        {
+            return m_count;
+        }
+
+    private:
+        struct PendingIndex
+        {
+            u32 index{};
+            u64 frame{};
+        };
+
+        u32                 m_capacity{};
+        u32                 m_next{};
+        u32                 m_count{};
+        u64                 m_frame{};
+        Array<u32>          m_free{};
+        Array<PendingIndex> m_pending{};
+    };
+}
@@ -0,0 +1,703 @@
+#include "NullDevice.hpp"
+
+#include "Fyrion/Platform/Platform.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        //any non-null value, handlers of objects without state only need to be valid.
+        VoidPtr NullHandler()
+        {
+            static u8 handler{};
+            return &handler;
+        }
+    }
+
+    BindingValue& NullBindingSet::GetBindingValue(const StringView& name)
+    {
+        auto it = bindingValues.Find(name);
+        if (it == bindingValues.end())
+        {
+            it = bindingValues.Emplace(String{name}, MakeShared<NullBindingValue>()).first;
+        }
+        return *it->second;
+    }
+
+    bool NullCommands::Validate(bool condition, const char* message)
+    {
+        if (!condition)
+        {
+            logger.Error("{}", message);
+            errors++;
+        }
+        return condition;
+    }
+
+    void NullCommands::Record(NullCommandType type, VoidPtr handler, u32 v0, u32 v1, u32 v2, u32 v3)
+    {
+        Validate(recording, "command recorded outside Begin/End");
+        commands.EmplaceBack(NullCommand{
+            .type = type,
+            .handler = handler,
+            .values = {v0, v1, v2, v3}
+        });
+    }
+
+    void NullCommands::Begin()
+    {
+        Validate(!recording, "Begin called twice");
+        commands.Clear();
+        recording = true;
+        insideRenderPass = false;
+        pipeline = nullptr;
+        labelDepth = 0;
+        timestampScopes.Clear();
+        openTimestampScopes.Clear();
+    }
+
+    void NullCommands::End()
+    {
+        Validate(recording, "End called without Begin");
+        Validate(!insideRenderPass, "End called inside a render pass");
+        Validate(labelDepth == 0, "End called with open labels");
+        recording = false;
+    }
+
+    void NullCommands::BeginRenderPass(const BeginRenderPassInfo& beginRenderPassInfo)
+    {
+        Validate(beginRenderPassInfo.renderPass, "BeginRenderPass without render pass");
+        Validate(!insideRenderPass, "BeginRenderPass inside a render pass");
+        insideRenderPass = true;
+        Record(NullCommandType::BeginRenderPass, beginRenderPassInfo.renderPass.handler);
+    }
+
+    void NullCommands::EndRenderPass()
+    {
+        Validate(insideRenderPass, "EndRenderPass without BeginRenderPass");
+        insideRenderPass = false;
+        Record(NullCommandType::EndRenderPass);
+    }
+
+    void NullCommands::SetViewport(const ViewportInfo& viewportInfo)
+    {
+        Record(NullCommandType::SetViewport, nullptr, static_cast<u32>(viewportInfo.width), static_cast<u32>(viewportInfo.height));
+    }
+
+    void NullCommands::BindVertexBuffer(const Buffer& gpuBuffer)
+    {
+        Validate(gpuBuffer, "BindVertexBuffer with null buffer");
+        Record(NullCommandType::BindVertexBuffer, gpuBuffer.handler);
+    }
+
+    void NullCommands::BindIndexBuffer(const Buffer& gpuBuffer)
+    {
+        Validate(gpuBuffer, "BindIndexBuffer with null buffer");
+        Record(NullCommandType::BindIndexBuffer, gpuBuffer.handler);
+    }
+
+    void NullCommands::DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance)
+    {
+        Validate(insideRenderPass, "DrawIndexed outside a render pass");
+        Validate(pipeline, "DrawIndexed without pipeline");
+        Record(NullCommandType::DrawIndexed, nullptr, indexCount, instanceCount, firstIndex, firstInstance);
+    }
+
+    void NullCommands::Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance)
+    {
+        Validate(insideRenderPass, "Draw outside a render pass");
+        Validate(pipeline, "Draw without pipeline");
+        Record(NullCommandType::Draw, nullptr, vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    void NullCommands::PushConstants(const PipelineState& pipeline, ShaderStage stages, const void* data, usize size)
+    {
+        Validate(pipeline, "PushConstants with null pipeline");
+        Validate(data != nullptr && size > 0, "PushConstants without data");
+        Record(NullCommandType::PushConstants, pipeline.handler, static_cast<u32>(size));
+    }
+
+    void NullCommands::BindBindingSet(const PipelineState& pipeline, const BindingSet& bindingSet)
+    {
+        Validate(pipeline, "BindBindingSet with null pipeline");
+        Record(NullCommandType::BindBindingSet, pipeline.handler);
+    }
+
+    void NullCommands::DrawIndexedIndirect(const Buffer& buffer, usize offset, u32 drawCount, u32 stride)
+    {
+        Validate(insideRenderPass, "DrawIndexedIndirect outside a render pass");
+        Validate(pipeline, "DrawIndexedIndirect without pipeline");
+        Validate(buffer, "DrawIndexedIndirect with null buffer");
+        Record(NullCommandType::DrawIndexedIndirect, buffer.handler, static_cast<u32>(offset), drawCount, stride);
+    }
+
+    void NullCommands::BindPipelineState(const PipelineState& pipeline)
+    {
+        Validate(pipeline, "BindPipelineState with null pipeline");
+        this->pipeline = pipeline.handler;
+        Record(NullCommandType::BindPipelineState, pipeline.handler);
+    }
+
+    void NullCommands::Dispatch(u32 x, u32 y, u32 z)
+    {
+        Validate(!insideRenderPass, "Dispatch inside a render pass");
+        Validate(pipeline, "Dispatch without pipeline");
+        Record(NullCommandType::Dispatch, nullptr, x, y, z);
+    }
+
+    void NullCommands::TraceRays(PipelineState pipeline, u32 x, u32 y, u32 z)
+    {
+        Validate(!insideRenderPass, "TraceRays inside a render pass");
+        Record(NullCommandType::TraceRays, pipeline.handler, x, y, z);
+    }
+
+    void NullCommands::SetScissor(const Rect& rect)
+    {
+        Record(NullCommandType::SetScissor, nullptr, static_cast<u32>(rect.x), static_cast<u32>(rect.y), rect.width, rect.height);
+    }
+
+    void NullCommands::BeginLabel(const StringView& name, const Vec4& color)
+    {
+        labelDepth++;
+        Record(NullCommandType::BeginLabel);
+
+        openTimestampScopes.EmplaceBack(static_cast<u32>(timestampScopes.Size()));
+        timestampScopes.EmplaceBack(ProfileScope{
+            .name = name,
+            .depth = static_cast<u32>(openTimestampScopes.Size() - 1),
+            .begin = Platform::GetTime()
+        });
+    }
+
+    void NullCommands::EndLabel()
+    {
+        if (Validate(labelDepth > 0, "EndLabel without BeginLabel"))
+        {
+            labelDepth--;
+        }
+        Record(NullCommandType::EndLabel);
+
+        if (!openTimestampScopes.Empty())
+        {
+            timestampScopes[openTimestampScopes.Back()].end = Platform::GetTime();
+            openTimestampScopes.PopBack();
+        }
+    }
+
+    void NullCommands::ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo)
+    {
+        Validate(!insideRenderPass, "ResourceBarrier inside a render pass");
+        Record(NullCommandType::ResourceBarrier, resourceBarrierInfo.texture.handler);
+    }
+
+    void NullCommands::CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info)
+    {
+        Validate(!insideRenderPass, "CopyBuffer inside a render pass");
+        Validate(srcBuffer && dstBuffer, "CopyBuffer with null buffer");
+        Record(NullCommandType::CopyBuffer, dstBuffer.handler, static_cast<u32>(info.Size()));
+
+        //buffers may come from another device when only validating.
+        if (validateOnly || !buffers || !srcBuffer || !dstBuffer)
+        {
+            return;
+        }
+
+        NullBuffer* src = buffers->Get(srcBuffer.handler);
+        NullBuffer* dst = buffers->Get(dstBuffer.handler);
+        if (!Validate(src && dst, "CopyBuffer with destroyed buffer"))
+        {
+            return;
+        }
+
+        for (const BufferCopyInfo& copy : info)
+        {
+            if (Validate(copy.srcOffset + copy.size <= src->data.Size() && copy.dstOffset + copy.size <= dst->data.Size(), "CopyBuffer out of range"))
+            {
+                MemCopy(dst->data.Data() + copy.dstOffset, src->data.Data() + copy.srcOffset, copy.size);
+            }
+        }
+    }
+
+    void NullCommands::BindBindlessHeap(const PipelineState& pipeline)
+    {
+        Validate(pipeline, "BindBindlessHeap with null pipeline");
+        Record(NullCommandType::BindBindlessHeap, pipeline.handler);
+    }
+
+    void NullCommands::DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride)
+    {
+        Validate(insideRenderPass, "DrawIndexedIndirectCount outside a render pass");
+        Validate(pipeline, "DrawIndexedIndirectCount without pipeline");
+        Validate(buffer && countBuffer, "DrawIndexedIndirectCount with null buffer");
+        Record(NullCommandType::DrawIndexedIndirectCount, buffer.handler, static_cast<u32>(offset), static_cast<u32>(countOffset), maxDrawCount, stride);
+    }
+
+    void NullCommands::FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value)
+    {
+        Validate(!insideRenderPass, "FillBuffer inside a render pass");
+        Validate(buffer, "FillBuffer with null buffer");
+        Validate(offset % sizeof(u32) == 0 && size % sizeof(u32) == 0, "FillBuffer offset and size must be multiples of 4");
+        Record(NullCommandType::FillBuffer, buffer.handler, static_cast<u32>(offset), static_cast<u32>(size), value);
+
+        if (validateOnly || !buffers || !buffer)
+        {
+            return;
+        }
+
+        NullBuffer* nullBuffer = buffers->Get(buffer.handler);
+        if (Validate(nullBuffer, "FillBuffer with destroyed buffer") && Validate(offset + size <= nullBuffer->data.Size(), "FillBuffer out of range"))
+        {
+            for (usize i = offset; i + sizeof(u32) <= offset + size; i += sizeof(u32))
+            {
+                MemCopy(nullBuffer->data.Data() + i, &value, sizeof(u32));
+            }
+        }
+    }
+
+    void NullCommands::BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo)
+    {
+        Validate(!insideRenderPass, "BufferBarrier inside a render pass");
+        Validate(bufferBarrierInfo.buffer, "BufferBarrier with null buffer");
+        Record(NullCommandType::BufferBarrier, bufferBarrierInfo.buffer.handler, static_cast<u32>(bufferBarrierInfo.srcAccess), static_cast<u32>(bufferBarrierInfo.dstAccess));
+    }
+
+    void NullCommands::SubmitAndWait(GPUQueue queue)
+    {
+        End();
+    }
+
+    NullDevice::~NullDevice()
+    {
+        if (swapchainRenderPass)
+        {
+            DestroyRenderPass(swapchainRenderPass);
+        }
+
+        RetireAsyncUploads(U64_MAX);
+        CollectResources(U64_MAX);
+
+        ResourceStats stats = GetResourceStats();
+        u32 leaked = stats.buffers.live + stats.textures.live + stats.textureViews.live + stats.samplers.live;
+        if (leaked > 0)
+        {
+            logger.Warn("{} resources were not destroyed", leaked);
+        }
+    }
+
+    Span<Adapter> NullDevice::GetAdapters()
+    {
+        adapter.handler = NullHandler();
+        return {&adapter, 1};
+    }
+
+    void NullDevice::CreateDevice(Adapter adapter)
+    {
+        logger.Info("Null device created, commands are recorded but not executed");
+    }
+
+    Swapchain NullDevice::CreateSwapchain(const SwapchainCreation& swapchainCreation)
+    {
+        if (!swapchainRenderPass)
+        {
+            swapchainRenderPass = CreateRenderPass({});
+        }
+        presentMode = swapchainCreation.presentMode;
+        return {NullHandler()};
+    }
+
+    RenderPass NullDevice::CreateRenderPass(const RenderPassCreation& renderPassCreation)
+    {
+        return {allocator.Alloc<RenderPassCreation>(renderPassCreation)};
+    }
+
+    Buffer NullDevice::CreateBuffer(const BufferCreation& bufferCreation)
+    {
+        VoidPtr     handler = buffers.Create();
+        NullBuffer* nullBuffer = buffers.Get(handler);
+        nullBuffer->bufferCreation = bufferCreation;
+        nullBuffer->data.Resize(bufferCreation.size);
+
+        if (bufferCreation.usage && BufferUsage::StorageBuffer)
+        {
+            nullBuffer->bindlessIndex = bufferIndices.Allocate();
+        }
+        return {handler};
+    }
+
+    Texture NullDevice::CreateTexture(const TextureCreation& textureCreation)
+    {
+        Texture texture = {textures.Create()};
+        textures.Get(texture.handler)->creation = textureCreation;
+
+        TextureView textureView = CreateTextureView(TextureViewCreation{
+            .texture = texture,
+            .viewType = textureCreation.defaultView,
+            .levelCount = textureCreation.mipLevels,
+            .layerCount = textureCreation.arrayLayers
+        });
+        textures.Get(texture.handler)->textureView = textureView;
+        return texture;
+    }
+
+    TextureView NullDevice::CreateTextureView(const TextureViewCreation& textureViewCreation)
+    {
+        NullTexture* nullTexture = textures.Get(textureViewCreation.texture.handler);
+        if (!commands.Validate(nullTexture, "CreateTextureView with destroyed texture"))
+        {
+            return {};
+        }
+
+        VoidPtr          handler = textureViews.Create();
+        NullTextureView* nullTextureView = textureViews.Get(handler);
+        nullTextureView->texture = textureViewCreation.texture;
+
+        TextureUsage usage = nullTexture->creation.usage;
+        if (usage == TextureUsage::None || (usage && TextureUsage::ShaderResource))
+        {
+            nullTextureView->bindlessIndex = textureIndices.Allocate();
+        }
+        return {handler};
+    }
+
+    Sampler NullDevice::CreateSampler(const SamplerCreation& samplerCreation)
+    {
+        VoidPtr handler = samplers.Create();
+        samplers.Get(handler)->bindlessIndex = samplerIndices.Allocate();
+        return {handler};
+    }
+
+    PipelineState NullDevice::CreateGraphicsPipelineState(const GraphicsPipelineCreation& graphicsPipelineCreation)
+    {
+        NullPipelineState* nullPipelineState = allocator.Alloc<NullPipelineState>();
+        nullPipelineState->compute = false;
+        return {nullPipelineState};
+    }
+
+    PipelineState NullDevice::CreateComputePipelineState(const ComputePipelineCreation& computePipelineCreation)
+    {
+        NullPipelineState* nullPipelineState = allocator.Alloc<NullPipelineState>();
+        nullPipelineState->compute = true;
+        return {nullPipelineState};
+    }
+
+    BindingSet& NullDevice::CreateBindingSet(RID shader, const BindingSetType& bindingSetType)
+    {
+        return *allocator.Alloc<NullBindingSet>();
+    }
+
+    void NullDevice::DestroySwapchain(const Swapchain& swapchain) {}
+
+    void NullDevice::DestroyRenderPass(const RenderPass& renderPass)
+    {
+        allocator.DestroyAndFree(static_cast<RenderPassCreation*>(renderPass.handler));
+        if (renderPass == swapchainRenderPass)
+        {
+            swapchainRenderPass = {};
+        }
+    }
+
+    void NullDevice::DestroyBuffer(const Buffer& buffer)
+    {
+        //bindless indices have their own frame delay, they are freed right away.
+        NullBuffer* nullBuffer = buffers.Release(buffer.handler, frameCount);
+        if (commands.Validate(nullBuffer, "DestroyBuffer with destroyed buffer"))
+        {
+            bufferIndices.Free(nullBuffer->bindlessIndex);
+        }
+    }
+
+    void NullDevice::DestroyTexture(const Texture& texture)
+    {
+        if (NullTexture* nullTexture = textures.Release(texture.handler, frameCount))
+        {
+            DestroyTextureView(nullTexture->textureView);
+            return;
+        }
+        commands.Validate(false, "DestroyTexture with destroyed texture");
+    }
+
+    void NullDevice::DestroyTextureView(const TextureView& textureView)
+    {
+        NullTextureView* nullTextureView = textureViews.Release(textureView.handler, frameCount);
+        if (commands.Validate(nullTextureView, "DestroyTextureView with destroyed texture view"))
+        {
+            textureIndices.Free(nullTextureView->bindlessIndex);
+        }
+    }
+
+    void NullDevice::DestroySampler(const Sampler& sampler)
+    {
+        NullSampler* nullSampler = samplers.Release(sampler.handler, frameCount);
+        if (commands.Validate(nullSampler, "DestroySampler with destroyed sampler"))
+        {
+            samplerIndices.Free(nullSampler->bindlessIndex);
+        }
+    }
+
+    void NullDevice::DestroyGraphicsPipelineState(const PipelineState& pipelineState)
+    {
+        allocator.DestroyAndFree(static_cast<NullPipelineState*>(pipelineState.handler));
+    }
+
+    void NullDevice::DestroyComputePipelineState(const PipelineState& pipelineState)
+    {
+        allocator.DestroyAndFree(static_cast<NullPipelineState*>(pipelineState.handler));
+    }
+
+    void NullDevice::DestroyBindingSet(BindingSet& bindingSet)
+    {
+        allocator.DestroyAndFree(static_cast<NullBindingSet*>(&bindingSet));
+    }
+
+    RenderCommands& NullDevice::BeginFrame()
+    {
+        //same as the frame fence, resources released by the frame reusing this slot are no longer in use.
+        if (frameCount >= framesInFlight)
+        {
+            CollectResources(frameCount - framesInFlight);
+        }
+
+        textureIndices.NextFrame();
+        samplerIndices.NextFrame();
+        bufferIndices.NextFrame();
+
+        //the transfer queue finishes the uploads submitted before the frame.
+        RetireAsyncUploads(transferValue);
+
+        //same latency as a device reading the queries back after the frame fence.
+        GPUFrameTimings& timings = frameTimings[frameCount % framesInFlight];
+        if (timings.frame != U64_MAX)
+        {
+            gpuFrameTimings = timings;
+            timings.frame = U64_MAX;
+        }
+
+        return commands;
+    }
+
+    RenderPass NullDevice::AcquireNextRenderPass(Swapchain swapchain)
+    {
+        return swapchainRenderPass;
+    }
+
+    void NullDevice::SetPresentMode(Swapchain swapchain, PresentMode presentMode)
+    {
+        this->presentMode = presentMode;
+    }
+
+    PresentMode NullDevice::GetPresentMode(Swapchain swapchain)
+    {
+        return presentMode;
+    }
+
+    void NullDevice::SetFramesInFlight(u32 framesInFlight)
+    {
+        this->framesInFlight = Math::Clamp(framesInFlight, 1u, static_cast<u32>(FY_FRAMES_IN_FLIGHT));
+
+        //timings of the previous frames would be resolved from the wrong slots.
+        for (GPUFrameTimings& timings : frameTimings)
+        {
+            timings.frame = U64_MAX;
+        }
+    }
+
+    u32 NullDevice::GetFramesInFlight()
+    {
+        return framesInFlight;
+    }
+
+    void NullDevice::WaitFrame() {}
+
+    void NullDevice::EndFrame(Swapchain swapchain)
+    {
+        commands.Validate(!commands.recording, "EndFrame with commands still recording");
+        submittedCommands += commands.commands.Size();
+
+        GPUFrameTimings& timings = frameTimings[frameCount % framesInFlight];
+        timings.frame = frameCount;
+        timings.scopes = commands.timestampScopes;
+
+        if (!timings.scopes.Empty())
+        {
+            f64 frameBegin = timings.scopes[0].begin;
+            for (ProfileScope& scope : timings.scopes)
+            {
+                scope.begin -= frameBegin;
+                scope.end -= frameBegin;
+            }
+        }
+
+        frameCount++;
+    }
+
+    void NullDevice::WaitQueue()
+    {
+        RetireAsyncUploads(U64_MAX);
+        CollectResources(U64_MAX);
+    }
+
+    void NullDevice::UpdateBufferData(const BufferDataInfo& bufferDataInfo)
+    {
+        FY_ASSERT(bufferDataInfo.data, "data cannot be null");
+        FY_ASSERT(bufferDataInfo.size > 0, "size should be higher then zero");
+
+        NullBuffer* nullBuffer = buffers.Get(bufferDataInfo.buffer.handler);
+        if (commands.Validate(nullBuffer, "UpdateBufferData with destroyed buffer") && commands.Validate(bufferDataInfo.offset + bufferDataInfo.size <= nullBuffer->data.Size(), "UpdateBufferData out of range"))
+        {
+            MemCopy(nullBuffer->data.Data() + bufferDataInfo.offset, bufferDataInfo.data, bufferDataInfo.size);
+        }
+
+        uploadStats.uploads++;
+        uploadStats.bytesUploaded += bufferDataInfo.size;
+    }
+
+    UploadStats NullDevice::GetUploadStats()
+    {
+        return uploadStats;
+    }
+
+    UploadToken NullDevice::UploadAsync(const BufferDataInfo& bufferDataInfo)
+    {
+        FY_ASSERT(bufferDataInfo.data, "data cannot be null");
+        FY_ASSERT(bufferDataInfo.size > 0, "size should be higher then zero");
+
+        NullBuffer* nullBuffer = buffers.Get(bufferDataInfo.buffer.handler);
+        if (!commands.Validate(nullBuffer, "UploadAsync with destroyed buffer"))
+        {
+            return {};
+        }
+
+        if (nullBuffer->bufferCreation.allocation != BufferAllocation::GPUOnly)
+        {
+            UpdateBufferData(bufferDataInfo);
+            return {};
+        }
+
+        std::unique_lock lock(uploadMutex);
+
+        NullAsyncUpload& upload = asyncUploads.EmplaceBack();
+        upload.value = ++transferValue;
+        upload.buffer = bufferDataInfo.buffer;
+        upload.offset = bufferDataInfo.offset;
+        upload.data.Resize(bufferDataInfo.size);
+        MemCopy(upload.data.Data(), bufferDataInfo.data, bufferDataInfo.size);
+
+        uploadStats.uploads++;
+        uploadStats.bytesUploaded += bufferDataInfo.size;
+
+        return {upload.value};
+    }
+
+    void NullDevice::RetireAsyncUploads(u64 value)
+    {
+        std::unique_lock lock(uploadMutex);
+
+        usize retired = 0;
+        for (NullAsyncUpload& upload : asyncUploads)
+        {
+            if (upload.value > value)
+            {
+                break;
+            }
+
+            NullBuffer* nullBuffer = buffers.Get(upload.buffer.handler);
+            if (commands.Validate(nullBuffer, "async upload completed on a destroyed buffer") && commands.Validate(upload.offset + upload.data.Size() <= nullBuffer->data.Size(), "UploadAsync out of range"))
+            {
+                MemCopy(nullBuffer->data.Data() + upload.offset, upload.data.Data(), upload.data.Size());
+            }
+
+            transferCompletedValue = upload.value;
+            retired++;
+        }
+
+        if (retired > 0)
+        {
+            asyncUploads.Erase(asyncUploads.begin(), asyncUploads.begin() + retired);
+        }
+    }
+
+    bool NullDevice::IsUploadComplete(UploadToken uploadToken)
+    {
+        std::unique_lock lock(uploadMutex);
+        return uploadToken.value <= transferCompletedValue;
+    }
+
+    void NullDevice::WaitUpload(UploadToken uploadToken)
+    {
+        RetireAsyncUploads(uploadToken.value);
+    }
+
+    DeviceFeatures NullDevice::GetFeatures()
+    {
+        return features;
+    }
+
+    DescriptorStats NullDevice::GetDescriptorStats()
+    {
+        return {};
+    }
+
+    const GPUFrameTimings& NullDevice::GetGPUFrameTimings()
+    {
+        return gpuFrameTimings;
+    }
+
+    ResourceStats NullDevice::GetResourceStats()
+    {
+        return ResourceStats{
+            .buffers = buffers.GetStats(),
+            .textures = textures.GetStats(),
+            .textureViews = textureViews.GetStats(),
+            .samplers = samplers.GetStats()
+        };
+    }
+
+    u32 NullDevice::GetBindlessIndex(const Texture& texture)
+    {
+        NullTexture* nullTexture = textures.Get(texture.handler);
+        return commands.Validate(nullTexture, "GetBindlessIndex with destroyed texture") ? GetBindlessIndex(nullTexture->textureView) : U32_MAX;
+    }
+
+    u32 NullDevice::GetBindlessIndex(const TextureView& textureView)
+    {
+        NullTextureView* nullTextureView = textureViews.Get(textureView.handler);
+        return commands.Validate(nullTextureView, "GetBindlessIndex with destroyed texture view") ? nullTextureView->bindlessIndex : U32_MAX;
+    }
+
+    u32 NullDevice::GetBindlessIndex(const Sampler& sampler)
+    {
+        NullSampler* nullSampler = samplers.Get(sampler.handler);
+        return commands.Validate(nullSampler, "GetBindlessIndex with destroyed sampler") ? nullSampler->bindlessIndex : U32_MAX;
+    }
+
+    u32 NullDevice::GetBindlessIndex(const Buffer& buffer)
+    {
+        NullBuffer* nullBuffer = buffers.Get(buffer.handler);
+        return commands.Validate(nullBuffer, "GetBindlessIndex with destroyed buffer") ? nullBuffer->bindlessIndex : U32_MAX;
+    }
+
+    void NullDevice::ImGuiInit(Swapchain renderSwapchain) {}
+
+    void NullDevice::ImGuiNewFrame() {}
+
+    void NullDevice::ImGuiRender(RenderCommands& renderCommands) {}
+
+    VoidPtr NullDevice::GetImGuiTexture(const Texture& texture)
+    {
+        return nullptr;
+    }
+
+    void NullDevice::CollectResources(u64 completedFrame)
+    {
+        //nothing to release on the null device, the values are only destroyed.
+        buffers.Collect(completedFrame, [](NullBuffer& nullBuffer) {});
+        textures.Collect(completedFrame, [](NullTexture& nullTexture) {});
+        textureViews.Collect(completedFrame, [](NullTextureView& nullTextureView) {});
+        samplers.Collect(completedFrame, [](NullSampler& nullSampler) {});
+    }
+
+    SharedPtr<RenderDevice> CreateNullDevice()
+    {
+        return MakeShared<NullDevice>();
+    }
+}
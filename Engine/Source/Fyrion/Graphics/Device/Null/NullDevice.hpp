@@ -0,0 +1,245 @@
+#pragma once
+
+#include "Fyrion/Graphics/Device/RenderDevice.hpp"
+#include "Fyrion/Graphics/Device/BindlessIndexAllocator.hpp"
+#include "Fyrion/Graphics/Device/ResourcePool.hpp"
+#include "Fyrion/Core/SharedPtr.hpp"
+#include "Fyrion/Core/HashMap.hpp"
+#include "Fyrion/Core/FixedArray.hpp"
+#include "Fyrion/Core/Logger.hpp"
+
+#include <mutex>
+
+namespace Fyrion
+{
+    enum class NullCommandType : u8
+    {
+        BeginRenderPass,
+        EndRenderPass,
+        SetViewport,
+        SetScissor,
+        BindVertexBuffer,
+        BindIndexBuffer,
+        BindPipelineState,
+        BindBindingSet,
+        BindBindlessHeap,
+        PushConstants,
+        Draw,
+        DrawIndexed,
+        DrawIndexedIndirect,
+        Dispatch,
+        TraceRays,
+        BeginLabel,
+        EndLabel,
+        ResourceBarrier,
+        CopyBuffer,
+        DrawIndexedIndirectCount,
+        FillBuffer,
+        BufferBarrier
+    };
+
+    struct NullCommand
+    {
+        NullCommandType type{};
+        VoidPtr         handler{};
+        u32             values[4]{};
+    };
+
+    struct NullBuffer
+    {
+        BufferCreation bufferCreation{};
+        Array<u8>      data{};
+        u32            bindlessIndex{U32_MAX};
+    };
+
+    struct NullTexture
+    {
+        TextureCreation creation{};
+        TextureView     textureView{};
+    };
+
+    struct NullTextureView
+    {
+        Texture texture{};
+        u32     bindlessIndex{U32_MAX};
+    };
+
+    struct NullSampler
+    {
+        u32 bindlessIndex{U32_MAX};
+    };
+
+    struct NullAsyncUpload
+    {
+        u64       value{};
+        Buffer    buffer{};
+        usize     offset{};
+        Array<u8> data{};
+    };
+
+    struct NullPipelineState
+    {
+        PipelineState pipelineState{};
+        bool          compute{};
+    };
+
+    struct NullBindingValue : BindingValue
+    {
+        void SetTexture(const Texture& texture) override {}
+        void SetTextureView(const TextureView& textureView) override {}
+        void SetSampler(const Sampler& sampler) override {}
+        void SetBuffer(const Buffer& buffer) override {}
+    };
+
+    struct NullBindingSet : BindingSet
+    {
+        HashMap<String, SharedPtr<NullBindingValue>> bindingValues{};
+
+        BindingValue& GetBindingValue(const StringView& name) override;
+    };
+
+    //commands are validated and kept in memory, nothing is executed.
+    struct FY_API NullCommands : RenderCommands
+    {
+        Logger&            logger;
+        Array<NullCommand> commands{};
+        bool               recording{};
+        bool               insideRenderPass{};
+        VoidPtr            pipeline{};
+        u32                labelDepth{};
+        u64                errors{};
+        bool               validateOnly{};
+
+        //resolves buffer contents for copies and fills, without it only the commands are recorded.
+        ResourcePool<NullBuffer>* buffers{};
+
+        //labels are timed with the cpu clock while recording.
+        Array<ProfileScope> timestampScopes{};
+        Array<u32>          openTimestampScopes{};
+
+        explicit NullCommands(Logger& logger, ResourcePool<NullBuffer>* buffers = nullptr) : logger(logger), buffers(buffers) {}
+
+        void Begin() override;
+        void End() override;
+        void BeginRenderPass(const BeginRenderPassInfo& beginRenderPassInfo) override;
+        void EndRenderPass() override;
+        void SetViewport(const ViewportInfo& viewportInfo) override;
+        void BindVertexBuffer(const Buffer& gpuBuffer) override;
+        void BindIndexBuffer(const Buffer& gpuBuffer) override;
+        void DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance) override;
+        void Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) override;
+        void PushConstants(const PipelineState& pipeline, ShaderStage stages, const void* data, usize size) override;
+        void BindBindingSet(const PipelineState& pipeline, const BindingSet& bindingSet) override;
+        void DrawIndexedIndirect(const Buffer& buffer, usize offset, u32 drawCount, u32 stride) override;
+        void BindPipelineState(const PipelineState& pipeline) override;
+        void Dispatch(u32 x, u32 y, u32 z) override;
+        void TraceRays(PipelineState pipeline, u32 x, u32 y, u32 z) override;
+        void SetScissor(const Rect& rect) override;
+        void BeginLabel(const StringView& name, const Vec4& color) override;
+        void EndLabel() override;
+        void ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo) override;
+        void CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info) override;
+        void BindBindlessHeap(const PipelineState& pipeline) override;
+        void DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride) override;
+        void FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value) override;
+        void BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo) override;
+        void SubmitAndWait(GPUQueue queue) override;
+
+        void Record(NullCommandType type, VoidPtr handler = nullptr, u32 v0 = 0, u32 v1 = 0, u32 v2 = 0, u32 v3 = 0);
+        bool Validate(bool condition, const char* message);
+    };
+
+    class FY_API NullDevice final : public RenderDevice
+    {
+    public:
+        Logger&      logger = Logger::GetLogger("Fyrion::NullDevice");
+        Allocator&   allocator = MemoryGlobals::GetDefaultAllocator();
+        Adapter      adapter{};
+
+        ResourcePool<NullBuffer>      buffers{};
+        ResourcePool<NullTexture>     textures{};
+        ResourcePool<NullTextureView> textureViews{};
+        ResourcePool<NullSampler>     samplers{};
+
+        NullCommands commands{logger, &buffers};
+        RenderPass   swapchainRenderPass{};
+        UploadStats  uploadStats{};
+        u64          submittedCommands{};
+
+        //async uploads are copied when they complete, on the next frame or when they are waited.
+        std::mutex             uploadMutex{};
+        u64                    transferValue{};
+        u64                    transferCompletedValue{};
+        Array<NullAsyncUpload> asyncUploads{};
+
+        u64          frameCount{};
+        u32          framesInFlight{FY_DEFAULT_FRAMES_IN_FLIGHT};
+        PresentMode  presentMode{};
+
+        FixedArray<GPUFrameTimings, FY_FRAMES_IN_FLIGHT> frameTimings{};
+        GPUFrameTimings                                  gpuFrameTimings{};
+
+        DeviceFeatures         features{.raytraceSupported = false, .bindlessSupported = true, .multiDrawIndirectSupported = true, .drawIndirectCountSupported = true};
+        BindlessIndexAllocator textureIndices{};
+        BindlessIndexAllocator samplerIndices{};
+        BindlessIndexAllocator bufferIndices{};
+
+        ~NullDevice() override;
+
+        Span<Adapter>   GetAdapters() override;
+        void            CreateDevice(Adapter adapter) override;
+        Swapchain       CreateSwapchain(const SwapchainCreation& swapchainCreation) override;
+        RenderPass      CreateRenderPass(const RenderPassCreation& renderPassCreation) override;
+        Buffer          CreateBuffer(const BufferCreation& bufferCreation) override;
+        Texture         CreateTexture(const TextureCreation& textureCreation) override;
+        TextureView     CreateTextureView(const TextureViewCreation& textureViewCreation) override;
+        Sampler         CreateSampler(const SamplerCreation& samplerCreation) override;
+        PipelineState   CreateGraphicsPipelineState(const GraphicsPipelineCreation& graphicsPipelineCreation) override;
+        PipelineState   CreateComputePipelineState(const ComputePipelineCreation& computePipelineCreation) override;
+        BindingSet&     CreateBindingSet(RID shader, const BindingSetType& bindingSetType) override;
+        void            DestroySwapchain(const Swapchain& swapchain) override;
+        void            DestroyRenderPass(const RenderPass& renderPass) override;
+        void            DestroyBuffer(const Buffer& buffer) override;
+        void            DestroyTexture(const Texture& texture) override;
+        void            DestroyTextureView(const TextureView& textureView) override;
+        void            DestroySampler(const Sampler& sampler) override;
+        void            DestroyGraphicsPipelineState(const PipelineState& pipelineState) override;
+        void            DestroyComputePipelineState(const PipelineState& pipelineState) override;
+        void            DestroyBindingSet(BindingSet& bindingSet) override;
+        RenderCommands& BeginFrame() override;
+        RenderPass      AcquireNextRenderPass(Swapchain swapchain) override;
+        void            SetPresentMode(Swapchain swapchain, PresentMode presentMode) override;
+        PresentMode     GetPresentMode(Swapchain swapchain) override;
+        void            SetFramesInFlight(u32 framesInFlight) override;
+        u32             GetFramesInFlight() override;
+        void            WaitFrame() override;
+        void            EndFrame(Swapchain swapchain) override;
+        void            WaitQueue() override;
+        void            UpdateBufferData(const BufferDataInfo& bufferDataInfo) override;
+        UploadStats     GetUploadStats() override;
+        UploadToken     UploadAsync(const BufferDataInfo& bufferDataInfo) override;
+        bool            IsUploadComplete(UploadToken uploadToken) override;
+        void            WaitUpload(UploadToken uploadToken) override;
+        DeviceFeatures  GetFeatures() override;
+        DescriptorStats GetDescriptorStats() override;
+        const GPUFrameTimings& GetGPUFrameTimings() override;
+        ResourceStats   GetResourceStats() override;
+        u32             GetBindlessIndex(const Texture& texture) override;
+        u32             GetBindlessIndex(const TextureView& textureView) override;
+        u32             GetBindlessIndex(const Sampler& sampler) override;
+        u32             GetBindlessIndex(const Buffer& buffer) override;
+
+        void    ImGuiInit(Swapchain renderSwapchain) override;
+        void    ImGuiNewFrame() override;
+        void    ImGuiRender(RenderCommands& renderCommands) override;
+        VoidPtr GetImGuiTexture(const Texture& texture) override;
+
+        //destroys the resources released up to completedFrame.
+        void CollectResources(u64 completedFrame);
+
+        //copies the async uploads up to value and marks them as complete.
+        void RetireAsyncUploads(u64 value);
+    };
+
+    SharedPtr<RenderDevice> CreateNullDevice();
+}
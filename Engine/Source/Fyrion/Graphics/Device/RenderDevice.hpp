@@ -28,9 +28,26 @@ namespace Fyrion
         virtual void            DestroyBindingSet(BindingSet& bindingSet) = 0;
         virtual RenderCommands& BeginFrame() = 0;
         virtual RenderPass      AcquireNextRenderPass(Swapchain swapchain) = 0;
+        virtual void            SetPresentMode(Swapchain swapchain, PresentMode presentMode) = 0;
+        virtual PresentMode     GetPresentMode(Swapchain swapchain) = 0;
+        virtual void            SetFramesInFlight(u32 framesInFlight) = 0;
+        virtual u32             GetFramesInFlight() = 0;
+        virtual void            WaitFrame() = 0;
         virtual void            EndFrame(Swapchain swapchain) = 0;
         virtual void            WaitQueue() = 0;
         virtual void            UpdateBufferData(const BufferDataInfo& bufferDataInfo) = 0;
+        virtual UploadStats     GetUploadStats() = 0;
+        virtual UploadToken     UploadAsync(const BufferDataInfo& bufferDataInfo) = 0;
+        virtual bool            IsUploadComplete(UploadToken uploadToken) = 0;
+        virtual void            WaitUpload(UploadToken uploadToken) = 0;
+        virtual DeviceFeatures  GetFeatures() = 0;
+        virtual DescriptorStats GetDescriptorStats() = 0;
+        virtual const GPUFrameTimings& GetGPUFrameTimings() = 0;
+        virtual ResourceStats   GetResourceStats() = 0;
+        virtual u32             GetBindlessIndex(const Texture& texture) = 0;
+        virtual u32             GetBindlessIndex(const TextureView& textureView) = 0;
+        virtual u32             GetBindlessIndex(const Sampler& sampler) = 0;
+        virtual u32             GetBindlessIndex(const Buffer& buffer) = 0;
 
         virtual void    ImGuiInit(Swapchain renderSwapchain) = 0;
         virtual void    ImGuiNewFrame() = 0;
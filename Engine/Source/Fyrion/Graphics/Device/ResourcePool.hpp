@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Fyrion/Graphics/GraphicsTypes.hpp"
+#include "Fyrion/Core/Allocator.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace Fyrion
+{
+    //resources are stored in pages of contiguous slots, their addresses are stable while they are alive.
+    //handles are the slot index + 1 in the low 32 bits and the slot generation in the high 32 bits, packed in the
+    //handler pointer. a released slot bumps its generation, so stale handles resolve to nullptr instead of a reused slot.
+    //released values stay alive until the frames that can still use them are completed.
+    //the page table has a fixed size and pages never move, so Get can run on any thread while the render thread
+    //creates and releases resources. Create, Release and Collect are serialized by the pool mutex.
+    template<typename T, u32 PageSize = 256, u32 MaxPages = 4096>
+    class ResourcePool
+    {
+    public:
+        ResourcePool() = default;
+        FY_NO_COPY_CONSTRUCTOR(ResourcePool);
+
+        ~ResourcePool()
+        {
+            for (u32 p = 0; p < m_pageCount; ++p)
+            {
+                Slot* page = m_pages[p].load(std::memory_order_relaxed);
+                for (u32 i = 0; i < PageSize; ++i)
+                {
+                    if (page[i].state != SlotState::Free)
+                    {
+                        page[i].Value()->~T();
+                    }
+                }
+                m_allocator.MemFree(page);
+            }
+        }
+
+        template<typename ...Args>
+        VoidPtr Create(Args&& ...args)
+        {
+            std::unique_lock lock(m_mutex);
+
+            u32 index;
+            bool newSlot = m_free.Empty();
+            if (!newSlot)
+            {
+                index = m_free.Back();
+                m_free.PopBack();
+            }
+            else
+            {
+                index = m_count.load(std::memory_order_relaxed);
+                if (index / PageSize == m_pageCount)
+                {
+                    FY_ASSERT(m_pageCount < MaxPages, "resource pool is full");
+                    Slot* page = static_cast<Slot*>(m_allocator.MemAlloc(sizeof(Slot) * PageSize, alignof(Slot)));
+                    for (u32 i = 0; i < PageSize; ++i)
+                    {
+                        new(PlaceHolder(), &page[i]) Slot{};
+                    }
+                    m_pages[m_pageCount++].store(page, std::memory_order_release);
+                }
+            }
+
+            Slot& slot = GetSlot(index);
+            if constexpr (Traits::IsAggregate<T>)
+            {
+                new(PlaceHolder(), slot.Value()) T{Traits::Forward<Args>(args)...};
+            }
+            else
+            {
+                new(PlaceHolder(), slot.Value()) T(Traits::Forward<Args>(args)...);
+            }
+            slot.state = SlotState::Alive;
+            m_live++;
+
+            //the slot is visible to Get on other threads only after it's constructed.
+            if (newSlot)
+            {
+                m_count.store(index + 1, std::memory_order_release);
+            }
+
+            return reinterpret_cast<VoidPtr>(static_cast<u64>(slot.generation) << 32 | static_cast<u64>(index + 1));
+        }
+
+        T* Get(VoidPtr handler) const
+        {
+            Slot* slot = Find(handler);
+            if (slot == nullptr)
+            {
+                if (handler != nullptr)
+                {
+                    m_staleAccesses++;
+                }
+                return nullptr;
+            }
+            return slot->Value();
+        }
+
+        //invalidates the handle, the value is destroyed by Collect once frame is completed.
+        T* Release(VoidPtr handler, u64 frame)
+        {
+            std::unique_lock lock(m_mutex);
+
+            Slot* slot = Find(handler);
+            if (slot == nullptr)
+            {
+                if (handler != nullptr)
+                {
+                    m_staleAccesses++;
+                }
+                return nullptr;
+            }
+
+            slot->state = SlotState::Pending;
+            slot->generation++;
+            slot->releaseFrame = frame;
+            m_pending.EmplaceBack(static_cast<u32>(reinterpret_cast<u64>(handler) & U32_MAX) - 1);
+            m_live--;
+            return slot->Value();
+        }
+
+        //calls destroy for the values released up to completedFrame and frees their slots.
+        template<typename Func>
+        void Collect(u64 completedFrame, Func&& destroy)
+        {
+            std::unique_lock lock(m_mutex);
+
+            for (usize i = 0; i < m_pending.Size();)
+            {
+                Slot& slot = GetSlot(m_pending[i]);
+                if (slot.releaseFrame <= completedFrame)
+                {
+                    destroy(*slot.Value());
+                    slot.Value()->~T();
+                    slot.state = SlotState::Free;
+                    m_free.EmplaceBack(m_pending[i]);
+
+                    m_pending[i] = m_pending.Back();
+                    m_pending.PopBack();
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        template<typename Func>
+        void CollectAll(Func&& destroy)
+        {
+            Collect(U64_MAX, Traits::Forward<Func>(destroy));
+        }
+
+        //calls func for every value not released, used to report and clean up leaks.
+        template<typename Func>
+        void ForEachAlive(Func&& func)
+        {
+            std::unique_lock lock(m_mutex);
+
+            u32 count = m_count.load(std::memory_order_relaxed);
+            for (u32 index = 0; index < count; ++index)
+            {
+                Slot& slot = GetSlot(index);
+                if (slot.state == SlotState::Alive)
+                {
+                    func(*slot.Value());
+                }
+            }
+        }
+
+        ResourcePoolStats GetStats() const
+        {
+            std::unique_lock lock(m_mutex);
+
+            return ResourcePoolStats{
+                .live = m_live,
+                .pendingDestroy = static_cast<u32>(m_pending.Size()),
+                .capacity = m_pageCount * PageSize,
+                .staleAccesses = m_staleAccesses.load(std::memory_order_relaxed)
+            };
+        }
+
+    private:
+        enum class SlotState : u8
+        {
+            Free,
+            Alive,
+            Pending
+        };
+
+        struct Slot
+        {
+            alignas(T) u8 storage[sizeof(T)];
+            u32           generation{1};
+            SlotState     state{SlotState::Free};
+            u64           releaseFrame{};
+
+            T* Value()
+            {
+                return reinterpret_cast<T*>(storage);
+            }
+        };
+
+        Allocator&               m_allocator = MemoryGlobals::GetDefaultAllocator();
+        std::atomic<Slot*>       m_pages[MaxPages]{};
+        u32                      m_pageCount{};
+        Array<u32>               m_free{};
+        Array<u32>               m_pending{};
+        std::atomic<u32>         m_count{};
+        u32                      m_live{};
+        mutable std::atomic<u32> m_staleAccesses{};
+        mutable std::mutex       m_mutex{};
+
+        Slot& GetSlot(u32 index) const
+        {
+            return m_pages[index / PageSize].load(std::memory_order_acquire)[index % PageSize];
+        }
+
+        Slot* Find(VoidPtr handler) const
+        {
+            u64 value = reinterpret_cast<u64>(handler);
+            u32 index = static_cast<u32>(value & U32_MAX);
+            u32 generation = static_cast<u32>(value >> 32);
+
+            if (index == 0 || index > m_count.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+
+            Slot& slot = GetSlot(index - 1);
+            if (slot.state != SlotState::Alive || slot.generation != generation)
+            {
+                return nullptr;
+            }
+            return &slot;
+        }
+    };
+}
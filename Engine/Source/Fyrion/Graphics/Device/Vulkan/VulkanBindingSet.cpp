@@ -1,10 +1,31 @@
 #include "VulkanBindingSet.hpp"
 
+#include "VulkanDevice.hpp"
+#include "VulkanUtils.hpp"
 #include "Fyrion/Assets/AssetTypes.hpp"
 #include "Fyrion/Resource/Repository.hpp"
 
 namespace Fyrion
 {
+    namespace
+    {
+        bool MatchValues(const VulkanCachedDescriptorSet& cached, const VulkanDescriptorSet& descriptorSet, usize hash)
+        {
+            if (cached.hash != hash || cached.layout != descriptorSet.layout || cached.values.Size() != descriptorSet.values.Size())
+            {
+                return false;
+            }
+            for (usize i = 0; i < cached.values.Size(); ++i)
+            {
+                if (cached.values[i].handler != descriptorSet.values[i]->handler || cached.values[i].texture != descriptorSet.values[i]->texture)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
     VulkanBindingSet::VulkanBindingSet(VulkanDevice& vulkanDevice, const RID& shader, BindingSetType bindingSetType) : vulkanDevice(vulkanDevice), shader(shader), bindingSetType(bindingSetType)
     {
         ResourceObject shaderAsset = Repository::Read(shader);
@@ -12,44 +33,88 @@ namespace Fyrion
 
         for(const DescriptorLayout& descriptorLayout: shaderInfo.descriptors)
         {
-            auto setIt = descriptorLayoutLookup.Find(descriptorLayout.set);
+            bool hasRuntimeArrays = false;
+            for (const DescriptorBinding& binding : descriptorLayout.bindings)
+            {
+                hasRuntimeArrays |= binding.renderType == RenderType::RuntimeArray;
+            }
 
-            if (setIt == descriptorLayoutLookup.end())
+            //bound by BindBindlessHeap
+            if (descriptorLayout.set == BindlessSet && hasRuntimeArrays && vulkanDevice.deviceFeatures.bindlessSupported)
             {
-                descriptorLayoutLookup.Insert(descriptorLayout.set, descriptorLayout);
+                continue;
             }
 
+            u32 index = descriptorSets.Size();
+            VulkanDescriptorSet& descriptorSet = descriptorSets.EmplaceBack();
+            descriptorSet.set = descriptorLayout.set;
+            descriptorSet.layout = vulkanDevice.GetDescriptorSetLayout(descriptorLayout);
+
             for(const DescriptorBinding& binding: descriptorLayout.bindings)
             {
-                if (auto it = valueDescriptorSetLookup.Find(binding.name); it == valueDescriptorSetLookup.end())
+                if (binding.renderType == RenderType::RuntimeArray || bindingValues.Has(binding.name))
                 {
-                    valueDescriptorSetLookup.Emplace(String{binding.name}, (u32)descriptorLayout.set);
+                    continue;
                 }
+
+                SharedPtr<VulkanBindingValue> value = MakeShared<VulkanBindingValue>();
+                value->bindingSet = this;
+                value->descriptorSet = index;
+                value->binding = binding.binding;
+                value->descriptorType = binding.descriptorType;
+
+                descriptorSet.values.EmplaceBack(value.Get());
+                bindingValues.Emplace(String{binding.name}, Traits::Move(value));
             }
         }
     }
 
-    void VulkanBindingValue::SetTexture(const Texture& texture)
+    VulkanBindingSet::~VulkanBindingSet()
     {
-        if (texture != m_texture)
+        //frames in flight can still use the sets.
+        for (VulkanDescriptorSet& descriptorSet : descriptorSets)
         {
-            m_texture = texture;
+            for (VulkanCachedDescriptorSet& cached : descriptorSet.cache)
+            {
+                vulkanDevice.FreeDescriptorSet(cached.descriptorSet);
+            }
         }
     }
 
+    void VulkanBindingValue::SetHandler(VoidPtr handler, bool texture)
+    {
+        if (this->handler == handler && this->texture == texture)
+        {
+            return;
+        }
+
+        this->handler = handler;
+        this->texture = texture;
+
+        if (descriptorSet != U32_MAX)
+        {
+            bindingSet->descriptorSets[descriptorSet].dirty = true;
+        }
+    }
+
+    void VulkanBindingValue::SetTexture(const Texture& texture)
+    {
+        SetHandler(texture.handler, true);
+    }
+
     void VulkanBindingValue::SetTextureView(const TextureView& textureView)
     {
-        m_textureView = textureView;
+        SetHandler(textureView.handler, false);
     }
 
     void VulkanBindingValue::SetSampler(const Sampler& sampler)
     {
-        m_sampler = sampler;
+        SetHandler(sampler.handler, false);
     }
 
     void VulkanBindingValue::SetBuffer(const Buffer& buffer)
     {
-        m_buffer = buffer;
+        SetHandler(buffer.handler, false);
     }
 
     BindingValue& VulkanBindingSet::GetBindingValue(const StringView& name)
@@ -57,8 +122,174 @@ namespace Fyrion
         auto it = bindingValues.Find(name);
         if (it == bindingValues.end())
         {
+            //not declared by the shader, values are kept but never written.
+            vulkanDevice.logger.Warn("binding {} not found in shader", name);
             it = bindingValues.Emplace(String{name}, MakeShared<VulkanBindingValue>()).first;
         }
         return *it->second;
     }
+
+    void VulkanBindingSet::Bind(VkCommandBuffer commandBuffer, const VulkanPipelineState& pipelineState)
+    {
+        for (VulkanDescriptorSet& descriptorSet : descriptorSets)
+        {
+            VkDescriptorSet vkDescriptorSet = Resolve(descriptorSet);
+            if (vkDescriptorSet)
+            {
+                vkCmdBindDescriptorSets(commandBuffer, pipelineState.bindingPoint, pipelineState.layout, descriptorSet.set, 1, &vkDescriptorSet, 0, nullptr);
+            }
+        }
+    }
+
+    VkDescriptorSet VulkanBindingSet::Resolve(VulkanDescriptorSet& descriptorSet)
+    {
+        bool dynamic = bindingSetType == BindingSetType::Dynamic;
+        if (!descriptorSet.dirty && (!dynamic || descriptorSet.frame == vulkanDevice.frameCount))
+        {
+            return descriptorSet.descriptorSet;
+        }
+
+        usize hash = HashValue(reinterpret_cast<usize>(descriptorSet.layout));
+        for (const VulkanBindingValue* value : descriptorSet.values)
+        {
+            HashCombine(hash, HashValue(reinterpret_cast<usize>(value->handler)), HashValue(value->texture));
+        }
+
+        Array<VulkanCachedDescriptorSet>* cache = &descriptorSet.cache;
+        if (dynamic)
+        {
+            HashMap<usize, Array<VulkanCachedDescriptorSet>>& frameSets = vulkanDevice.frameDescriptorSets[vulkanDevice.currentFrame];
+            auto it = frameSets.Find(hash);
+            if (it == frameSets.end())
+            {
+                it = frameSets.Insert(hash, {}).first;
+            }
+            cache = &it->second;
+        }
+
+        VulkanCachedDescriptorSet* cached = nullptr;
+        for (VulkanCachedDescriptorSet& entry : *cache)
+        {
+            if (MatchValues(entry, descriptorSet, hash))
+            {
+                cached = &entry;
+                break;
+            }
+        }
+
+        if (cached)
+        {
+            cached->lastUse = vulkanDevice.frameCount;
+            descriptorSet.descriptorSet = cached->descriptorSet;
+            vulkanDevice.descriptorStats.cacheHits++;
+        }
+        else
+        {
+            descriptorSet.descriptorSet = vulkanDevice.AllocateDescriptorSet(descriptorSet.layout, bindingSetType);
+            if (descriptorSet.descriptorSet)
+            {
+                Write(descriptorSet, descriptorSet.descriptorSet);
+
+                VulkanCachedDescriptorSet entry{
+                    .hash = hash,
+                    .layout = descriptorSet.layout,
+                    .descriptorSet = descriptorSet.descriptorSet,
+                    .lastUse = vulkanDevice.frameCount
+                };
+                entry.values.Reserve(descriptorSet.values.Size());
+                for (const VulkanBindingValue* value : descriptorSet.values)
+                {
+                    entry.values.EmplaceBack(VulkanDescriptorSetValue{value->handler, value->texture});
+                }
+
+                if (!dynamic && cache->Size() >= MaxCachedDescriptorSets)
+                {
+                    VulkanCachedDescriptorSet* leastUsed = cache->begin();
+                    for (VulkanCachedDescriptorSet& other : *cache)
+                    {
+                        if (other.lastUse < leastUsed->lastUse)
+                        {
+                            leastUsed = &other;
+                        }
+                    }
+                    vulkanDevice.FreeDescriptorSet(leastUsed->descriptorSet);
+                    *leastUsed = Traits::Move(entry);
+                }
+                else
+                {
+                    cache->EmplaceBack(Traits::Move(entry));
+                }
+            }
+        }
+
+        descriptorSet.frame = vulkanDevice.frameCount;
+        descriptorSet.dirty = false;
+        return descriptorSet.descriptorSet;
+    }
+
+    void VulkanBindingSet::Write(const VulkanDescriptorSet& descriptorSet, VkDescriptorSet vkDescriptorSet)
+    {
+        Array<VkWriteDescriptorSet>   writes{};
+        Array<VkDescriptorImageInfo>  imageInfos{};
+        Array<VkDescriptorBufferInfo> bufferInfos{};
+
+        //writes point into the info arrays, reserved up front so they never reallocate.
+        writes.Reserve(descriptorSet.values.Size());
+        imageInfos.Reserve(descriptorSet.values.Size());
+        bufferInfos.Reserve(descriptorSet.values.Size());
+
+        for (const VulkanBindingValue* value : descriptorSet.values)
+        {
+            if (!value->handler)
+            {
+                continue;
+            }
+
+            VkWriteDescriptorSet& write = writes.EmplaceBack(VkWriteDescriptorSet{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET});
+            write.dstSet = vkDescriptorSet;
+            write.dstBinding = value->binding;
+            write.descriptorCount = 1;
+            write.descriptorType = Vulkan::CastDescriptorType(value->descriptorType);
+
+            switch (value->descriptorType)
+            {
+                case DescriptorType::SampledImage:
+                case DescriptorType::StorageImage:
+                {
+                    const VulkanTextureView* textureView = value->texture
+                                                               ? vulkanDevice.GetTextureView(vulkanDevice.GetTexture(Texture{value->handler})->textureView)
+                                                               : vulkanDevice.GetTextureView(TextureView{value->handler});
+
+                    VkImageLayout imageLayout = value->descriptorType == DescriptorType::StorageImage ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    write.pImageInfo = &imageInfos.EmplaceBack(VkDescriptorImageInfo{VK_NULL_HANDLE, textureView->imageView, imageLayout});
+                    break;
+                }
+                case DescriptorType::Sampler:
+                {
+                    const VulkanSampler* sampler = vulkanDevice.GetSampler(Sampler{value->handler});
+                    write.pImageInfo = &imageInfos.EmplaceBack(VkDescriptorImageInfo{sampler->sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED});
+                    break;
+                }
+                case DescriptorType::UniformBuffer:
+                case DescriptorType::StorageBuffer:
+                {
+                    const VulkanBuffer* buffer = vulkanDevice.GetBuffer(Buffer{value->handler});
+                    write.pBufferInfo = &bufferInfos.EmplaceBack(VkDescriptorBufferInfo{buffer->buffer, 0, VK_WHOLE_SIZE});
+                    break;
+                }
+                case DescriptorType::AccelerationStructure:
+                {
+                    writes.PopBack();
+                    break;
+                }
+            }
+        }
+
+        if (!writes.Empty())
+        {
+            vkUpdateDescriptorSets(vulkanDevice.device, writes.Size(), writes.Data(), 0, nullptr);
+            vulkanDevice.descriptorStats.updates++;
+            vulkanDevice.descriptorStats.writes += writes.Size();
+        }
+    }
 }
@@ -2,25 +2,47 @@
 #include "Fyrion/Core/HashMap.hpp"
 #include "Fyrion/Core/SharedPtr.hpp"
 #include "Fyrion/Graphics/GraphicsTypes.hpp"
+#include "VulkanTypes.hpp"
+
+#include "volk.h"
 
 namespace Fyrion
 {
     class VulkanDevice;
+    struct VulkanBindingSet;
+    struct VulkanPipelineState;
 
     struct VulkanBindingValue : BindingValue
     {
-        union
-        {
-            Texture     m_texture{};
-            TextureView m_textureView;
-            Sampler     m_sampler;
-            Buffer      m_buffer;
-        };
+        VulkanBindingSet* bindingSet{};
+        u32               descriptorSet{U32_MAX};
+        u32               binding{};
+        DescriptorType    descriptorType{};
+        VoidPtr           handler{};
+        bool              texture{};
 
         void SetTexture(const Texture& texture) override;
         void SetTextureView(const TextureView& textureView) override;
         void SetSampler(const Sampler& sampler) override;
         void SetBuffer(const Buffer& buffer) override;
+
+    private:
+        void SetHandler(VoidPtr handler, bool texture);
+    };
+
+    //descriptor sets are never written after the first bind, a change of values resolves to another set.
+    //static binding sets keep the last MaxCachedDescriptorSets sets by their values, the least recently used
+    //is freed when a new one is needed. dynamic binding sets allocate from the frame pools and share the sets
+    //with the same layout and values in the frame.
+    struct VulkanDescriptorSet
+    {
+        u32                              set{};
+        VkDescriptorSetLayout            layout{};
+        Array<VulkanBindingValue*>       values{};
+        Array<VulkanCachedDescriptorSet> cache{};
+        VkDescriptorSet                  descriptorSet{};
+        u64                              frame{U64_MAX};
+        bool                             dirty{true};
     };
 
     struct VulkanBindingSet : BindingSet
@@ -30,13 +52,18 @@ namespace Fyrion
         BindingSetType bindingSetType;
 
         HashMap<String, SharedPtr<VulkanBindingValue>> bindingValues;
-        HashMap<String, u32>                           valueDescriptorSetLookup{};
-        HashMap<u32, DescriptorLayout>                 descriptorLayoutLookup{};
-
+        Array<VulkanDescriptorSet>                     descriptorSets{};
 
         VulkanBindingSet(VulkanDevice& vulkanDevice, const RID& shader, BindingSetType bindingSetType);
-
+        ~VulkanBindingSet() override;
 
         BindingValue& GetBindingValue(const StringView& name) override;
+
+        //resolves the dirty sets, writing all values of a new set with a single update.
+        void Bind(VkCommandBuffer commandBuffer, const VulkanPipelineState& pipelineState);
+
+    private:
+        VkDescriptorSet Resolve(VulkanDescriptorSet& descriptorSet);
+        void            Write(const VulkanDescriptorSet& descriptorSet, VkDescriptorSet vkDescriptorSet);
     };
 }
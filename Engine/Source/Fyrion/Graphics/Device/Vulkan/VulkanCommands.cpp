@@ -1,9 +1,46 @@
 #include "VulkanCommands.hpp"
 #include "VulkanDevice.hpp"
 #include "VulkanUtils.hpp"
+#include "VulkanBindingSet.hpp"
 
 namespace Fyrion
 {
+    namespace
+    {
+        void CastBufferAccess(BufferAccess bufferAccess, VkPipelineStageFlags& stage, VkAccessFlags& access)
+        {
+            constexpr VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+            switch (bufferAccess)
+            {
+                case BufferAccess::None:
+                    stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+                    access = 0;
+                    break;
+                case BufferAccess::TransferWrite:
+                    stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                    access = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    break;
+                case BufferAccess::ShaderRead:
+                    stage = shaderStages;
+                    access = VK_ACCESS_SHADER_READ_BIT;
+                    break;
+                case BufferAccess::ShaderWrite:
+                    stage = shaderStages;
+                    access = VK_ACCESS_SHADER_WRITE_BIT;
+                    break;
+                case BufferAccess::ShaderReadWrite:
+                    stage = shaderStages;
+                    access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                    break;
+                case BufferAccess::IndirectRead:
+                    stage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+                    access = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+                    break;
+            }
+        }
+    }
+
     VulkanCommands::VulkanCommands(VulkanDevice& vulkanDevice) : vulkanDevice(vulkanDevice)
     {
         VkCommandPoolCreateInfo commandPoolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
@@ -23,6 +60,14 @@ namespace Fyrion
     {
         VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
         vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+        if (timestampPool)
+        {
+            vkCmdResetQueryPool(commandBuffer, timestampPool, 0, MaxTimestampQueries);
+            timestampCount = 0;
+            timestampScopes.Clear();
+            openTimestampScopes.Clear();
+        }
     }
 
     void VulkanCommands::End()
@@ -89,14 +134,14 @@ namespace Fyrion
 
     void VulkanCommands::BindVertexBuffer(const Buffer& gpuBuffer)
     {
-        VkBuffer     vertexBuffers[] = {static_cast<const VulkanBuffer*>(gpuBuffer.handler)->buffer};
+        VkBuffer     vertexBuffers[] = {vulkanDevice.GetBuffer(gpuBuffer)->buffer};
         VkDeviceSize offsets[] = {0};
         vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
     }
 
     void VulkanCommands::BindIndexBuffer(const Buffer& gpuBuffer)
     {
-        vkCmdBindIndexBuffer(commandBuffer, static_cast<const VulkanBuffer*>(gpuBuffer.handler)->buffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdBindIndexBuffer(commandBuffer, vulkanDevice.GetBuffer(gpuBuffer)->buffer, 0, VK_INDEX_TYPE_UINT32);
     }
 
     void VulkanCommands::DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance)
@@ -117,11 +162,14 @@ namespace Fyrion
 
     void VulkanCommands::BindBindingSet(const PipelineState& pipeline, const BindingSet& bindingSet)
     {
+        //resolving the descriptor sets updates the binding set caches.
+        VulkanBindingSet& vulkanBindingSet = const_cast<VulkanBindingSet&>(static_cast<const VulkanBindingSet&>(bindingSet));
+        vulkanBindingSet.Bind(commandBuffer, *static_cast<const VulkanPipelineState*>(pipeline.handler));
     }
 
     void VulkanCommands::DrawIndexedIndirect(const Buffer& buffer, usize offset, u32 drawCount, u32 stride)
     {
-        const VulkanBuffer& vulkanBuffer = *static_cast<const VulkanBuffer*>(buffer.handler);
+        const VulkanBuffer& vulkanBuffer = *vulkanDevice.GetBuffer(buffer);
         vkCmdDrawIndexedIndirect(commandBuffer, vulkanBuffer.buffer, offset, drawCount, stride);
     }
 
@@ -152,6 +200,25 @@ namespace Fyrion
             vkDebugUtilsLabelExt.color[3] = color.a;
             vkCmdBeginDebugUtilsLabelEXT(commandBuffer, &vkDebugUtilsLabelExt);
         }
+
+        if (timestampPool)
+        {
+            if (timestampCount + 2 <= MaxTimestampQueries)
+            {
+                openTimestampScopes.EmplaceBack(static_cast<u32>(timestampScopes.Size()));
+                timestampScopes.EmplaceBack(VulkanTimestampScope{
+                    .name = name,
+                    .depth = static_cast<u32>(openTimestampScopes.Size() - 1),
+                    .beginQuery = timestampCount
+                });
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampPool, timestampCount);
+                timestampCount += 2;
+            }
+            else
+            {
+                openTimestampScopes.EmplaceBack(U32_MAX);
+            }
+        }
     }
 
     void VulkanCommands::EndLabel()
@@ -160,6 +227,16 @@ namespace Fyrion
         {
             vkCmdEndDebugUtilsLabelEXT(commandBuffer);
         }
+
+        if (timestampPool && !openTimestampScopes.Empty())
+        {
+            u32 scope = openTimestampScopes.Back();
+            openTimestampScopes.PopBack();
+            if (scope != U32_MAX)
+            {
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampPool, timestampScopes[scope].beginQuery + 1);
+            }
+        }
     }
 
     void VulkanCommands::ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo)
@@ -174,7 +251,7 @@ namespace Fyrion
             subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         }
 
-        auto vulkanTexture = static_cast<VulkanTexture*>(resourceBarrierInfo.texture.handler);
+        VulkanTexture* vulkanTexture = vulkanDevice.GetTexture(resourceBarrierInfo.texture);
 
         subresourceRange.baseMipLevel = resourceBarrierInfo.mipLevel;
         subresourceRange.levelCount = Math::Max(resourceBarrierInfo.levelCount, 1u);
@@ -265,13 +342,63 @@ namespace Fyrion
     void VulkanCommands::CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info)
     {
         vkCmdCopyBuffer(commandBuffer,
-                        static_cast<VulkanBuffer*>(srcBuffer.handler)->buffer,
-                        static_cast<VulkanBuffer*>(dstBuffer.handler)->buffer,
+                        vulkanDevice.GetBuffer(srcBuffer)->buffer,
+                        vulkanDevice.GetBuffer(dstBuffer)->buffer,
                         info.Size(),
                         (const VkBufferCopy*)info.Data()
         );
     }
 
+    void VulkanCommands::BindBindlessHeap(const PipelineState& pipeline)
+    {
+        const VulkanPipelineState& vulkanPipelineState = *static_cast<const VulkanPipelineState*>(pipeline.handler);
+        if (!vulkanPipelineState.bindless)
+        {
+            return;
+        }
+
+        vkCmdBindDescriptorSets(commandBuffer,
+                                vulkanPipelineState.bindingPoint,
+                                vulkanPipelineState.layout,
+                                BindlessSet,
+                                1,
+                                &vulkanDevice.bindlessDescriptorSet,
+                                0,
+                                nullptr);
+    }
+
+    void VulkanCommands::DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride)
+    {
+        vkCmdDrawIndexedIndirectCount(commandBuffer,
+                                      vulkanDevice.GetBuffer(buffer)->buffer,
+                                      offset,
+                                      vulkanDevice.GetBuffer(countBuffer)->buffer,
+                                      countOffset,
+                                      maxDrawCount,
+                                      stride);
+    }
+
+    void VulkanCommands::FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value)
+    {
+        vkCmdFillBuffer(commandBuffer, vulkanDevice.GetBuffer(buffer)->buffer, offset, size, value);
+    }
+
+    void VulkanCommands::BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo)
+    {
+        VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = vulkanDevice.GetBuffer(bufferBarrierInfo.buffer)->buffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        VkPipelineStageFlags srcStage{};
+        VkPipelineStageFlags dstStage{};
+        CastBufferAccess(bufferBarrierInfo.srcAccess, srcStage, barrier.srcAccessMask);
+        CastBufferAccess(bufferBarrierInfo.dstAccess, dstStage, barrier.dstAccessMask);
+
+        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
 
     void VulkanCommands::SubmitAndWait(GPUQueue queue)
     {
@@ -8,12 +8,28 @@ namespace Fyrion
 {
     class VulkanDevice;
 
+    constexpr u32 MaxTimestampQueries = 256;
+
+    struct VulkanTimestampScope
+    {
+        String name{};
+        u32    depth{};
+        u32    beginQuery{};
+    };
+
     struct VulkanCommands : RenderCommands
     {
         VulkanDevice& vulkanDevice;
         VkCommandPool commandPool{};
         VkCommandBuffer commandBuffer{};
 
+        //only the default commands have a timestamp pool, labels write a query pair resolved by the device after the frame fence.
+        VkQueryPool                 timestampPool{};
+        u32                         timestampCount{};
+        u64                         timestampFrame{U64_MAX};
+        Array<VulkanTimestampScope> timestampScopes{};
+        Array<u32>                  openTimestampScopes{};
+
         VulkanCommands(VulkanDevice& vulkanDevice);
 
         void Begin() override;
@@ -36,6 +52,10 @@ namespace Fyrion
         void EndLabel() override;
         void ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo) override;
         void CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info) override;
+        void BindBindlessHeap(const PipelineState& pipeline) override;
+        void DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride) override;
+        void FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value) override;
+        void BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo) override;
         void SubmitAndWait(GPUQueue queue) override;
     };
 }
\ No newline at end of file
@@ -11,13 +11,113 @@
 #include "Fyrion/Platform/Platform.hpp"
 #include "Fyrion/ImGui/Lib/imgui_impl_vulkan.h"
 #include "Fyrion/Resource/Repository.hpp"
+#include "Fyrion/Graphics/ShaderManager.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/FileTransaction.hpp"
+#include "Fyrion/IO/Path.hpp"
 
 namespace Fyrion
 {
+    namespace
+    {
+        usize HashRenderPassFormats(const GraphicsPipelineCreation& graphicsPipelineCreation)
+        {
+            usize hash = HashValue(static_cast<u32>(graphicsPipelineCreation.depthFormat));
+            for (Format format : graphicsPipelineCreation.attachments)
+            {
+                HashCombine(hash, HashValue(static_cast<u32>(format)));
+            }
+            return hash;
+        }
+
+        //the shader version is part of the key, a reloaded shader creates a new pipeline.
+        usize HashGraphicsPipeline(const GraphicsPipelineCreation& graphicsPipelineCreation)
+        {
+            usize hash = HashRenderPassFormats(graphicsPipelineCreation);
+            HashCombine(hash,
+                        HashValue(graphicsPipelineCreation.shader),
+                        HashValue(Repository::GetVersion(graphicsPipelineCreation.shader)),
+                        HashValue(graphicsPipelineCreation.depthWrite),
+                        HashValue(graphicsPipelineCreation.stencilTest),
+                        HashValue(graphicsPipelineCreation.blendEnabled),
+                        HashValue(graphicsPipelineCreation.minDepthBounds),
+                        HashValue(graphicsPipelineCreation.maxDepthBounds),
+                        HashValue(static_cast<u32>(graphicsPipelineCreation.cullMode)),
+                        HashValue(static_cast<u32>(graphicsPipelineCreation.compareOperator)),
+                        HashValue(static_cast<u32>(graphicsPipelineCreation.polygonMode)),
+                        HashValue(static_cast<u32>(graphicsPipelineCreation.primitiveTopology)));
+            return hash;
+        }
+
+        bool MatchRenderPassFormats(const Span<Format>& attachments, Format depthFormat, const GraphicsPipelineCreation& graphicsPipelineCreation)
+        {
+            if (depthFormat != graphicsPipelineCreation.depthFormat || attachments.Size() != graphicsPipelineCreation.attachments.Size())
+            {
+                return false;
+            }
+            for (usize i = 0; i < attachments.Size(); ++i)
+            {
+                if (attachments[i] != graphicsPipelineCreation.attachments[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //only the fields used to create the layout are compared.
+        bool MatchDescriptorBindings(const Span<DescriptorBinding>& bindings, const Span<DescriptorBinding>& other)
+        {
+            if (bindings.Size() != other.Size())
+            {
+                return false;
+            }
+            for (usize i = 0; i < bindings.Size(); ++i)
+            {
+                if (bindings[i].binding != other[i].binding ||
+                    bindings[i].count != other[i].count ||
+                    bindings[i].descriptorType != other[i].descriptorType ||
+                    bindings[i].renderType != other[i].renderType ||
+                    bindings[i].shaderStage != other[i].shaderStage)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool MatchGraphicsPipeline(const VulkanPipelineState& pipelineState, const GraphicsPipelineCreation& graphicsPipelineCreation)
+        {
+            const GraphicsPipelineCreation& creation = pipelineState.graphicsPipelineCreation;
+            return creation.shader == graphicsPipelineCreation.shader &&
+                pipelineState.shaderVersion == Repository::GetVersion(graphicsPipelineCreation.shader) &&
+                creation.depthWrite == graphicsPipelineCreation.depthWrite &&
+                creation.stencilTest == graphicsPipelineCreation.stencilTest &&
+                creation.blendEnabled == graphicsPipelineCreation.blendEnabled &&
+                creation.minDepthBounds == graphicsPipelineCreation.minDepthBounds &&
+                creation.maxDepthBounds == graphicsPipelineCreation.maxDepthBounds &&
+                creation.cullMode == graphicsPipelineCreation.cullMode &&
+                creation.compareOperator == graphicsPipelineCreation.compareOperator &&
+                creation.polygonMode == graphicsPipelineCreation.polygonMode &&
+                creation.primitiveTopology == graphicsPipelineCreation.primitiveTopology &&
+                MatchRenderPassFormats(pipelineState.attachments, creation.depthFormat, graphicsPipelineCreation);
+        }
+    }
+
     VulkanDevice::~VulkanDevice()
     {
         ImGui_ImplVulkan_Shutdown();
 
+        vkDeviceWaitIdle(device);
+        CollectResources(U64_MAX);
+
+        ResourceStats stats = GetResourceStats();
+        u32 leaked = stats.buffers.live + stats.textures.live + stats.textureViews.live + stats.samplers.live;
+        if (leaked > 0)
+        {
+            logger.Warn("{} resources were not destroyed", leaked);
+        }
+
         for (size_t i = 0; i < FY_FRAMES_IN_FLIGHT; i++)
         {
             vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
@@ -26,12 +126,64 @@ namespace Fyrion
 
         vkDestroyDescriptorPool(device, descriptorPool, nullptr);
 
+        for (Array<VkDescriptorPool>& pools : frameDescriptorPools)
+        {
+            for (VkDescriptorPool pool : pools)
+            {
+                vkDestroyDescriptorPool(device, pool, nullptr);
+            }
+        }
+
+        for (auto& it : descriptorSetLayouts)
+        {
+            for (VulkanDescriptorSetLayout& descriptorSetLayout : it.second)
+            {
+                vkDestroyDescriptorSetLayout(device, descriptorSetLayout.layout, nullptr);
+            }
+        }
+
+        if (bindlessDescriptorPool)
+        {
+            vkDestroyDescriptorPool(device, bindlessDescriptorPool, nullptr);
+            vkDestroyDescriptorSetLayout(device, bindlessDescriptorSetLayout, nullptr);
+        }
+
+        SavePipelineCache();
+        vkDestroyPipelineCache(device, pipelineCache, nullptr);
+
+        for (auto& it : compatibleRenderPasses)
+        {
+            for (VulkanCompatibleRenderPass& compatibleRenderPass : it.second)
+            {
+                vkDestroyRenderPass(device, compatibleRenderPass.renderPass, nullptr);
+            }
+        }
+
         vkDestroyCommandPool(device, temporaryCmd->commandPool, nullptr);
 
         for (int i = 0; i < FY_FRAMES_IN_FLIGHT; ++i)
         {
             vkDestroyCommandPool(device, defaultCommands[i]->commandPool, nullptr);
+            if (defaultCommands[i]->timestampPool)
+            {
+                vkDestroyQueryPool(device, defaultCommands[i]->timestampPool, nullptr);
+            }
+            vkDestroyCommandPool(device, uploadCommands[i]->commandPool, nullptr);
+        }
+
+        vmaDestroyBuffer(vmaAllocator, stagingBuffer.buffer, stagingBuffer.allocation);
+
+        vkQueueWaitIdle(transferQueue);
+        for (VulkanAsyncUpload& upload : asyncUploads)
+        {
+            vmaDestroyBuffer(vmaAllocator, upload.stagingBuffer.buffer, upload.stagingBuffer.allocation);
+        }
+        for (VulkanBuffer& stagingBuffer : freeTransferStagingBuffers)
+        {
+            vmaDestroyBuffer(vmaAllocator, stagingBuffer.buffer, stagingBuffer.allocation);
         }
+        vkDestroyCommandPool(device, transferCommandPool, nullptr);
+        vkDestroySemaphore(device, transferSemaphore, nullptr);
 
         vmaDestroyAllocator(vmaAllocator);
         vkDestroyDevice(device, nullptr);
@@ -160,11 +312,18 @@ namespace Fyrion
 
         deviceFeatures.multiDrawIndirectSupported = vulkanDeviceFeatures.multiDrawIndirect;
 
-        VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES, nullptr};
+        VkPhysicalDeviceVulkan12Features           vulkan12Features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES, nullptr};
+        VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES, &vulkan12Features};
         VkPhysicalDeviceFeatures2                  deviceFeatures2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &indexingFeatures};
         vkGetPhysicalDeviceFeatures2(physicalDevice, &deviceFeatures2);
-        //TODO check other extensions for bindless.
-        deviceFeatures.bindlessSupported = false; //indexingFeatures.descriptorBindingPartiallyBound && indexingFeatures.runtimeDescriptorArray;
+        deviceFeatures.drawIndirectCountSupported = vulkan12Features.drawIndirectCount;
+        deviceFeatures.bindlessSupported = indexingFeatures.runtimeDescriptorArray &&
+            indexingFeatures.descriptorBindingPartiallyBound &&
+            indexingFeatures.descriptorBindingVariableDescriptorCount &&
+            indexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+            indexingFeatures.shaderStorageBufferArrayNonUniformIndexing &&
+            indexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+            indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind;
 
 
         uint32_t extensionCount;
@@ -223,8 +382,24 @@ namespace Fyrion
         FY_ASSERT(graphicsFamily != U32_MAX, "Graphics queue not found");
         FY_ASSERT(presentFamily != U32_MAX, "Present queue not found");
 
+        //a transfer only family maps to the copy engines, a second graphics queue is the fallback.
+        for (u32 i = 0; i < queueFamilies.Size(); ++i)
+        {
+            VkQueueFlags flags = queueFamilies[i].queueFlags;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+            {
+                transferFamily = i;
+                break;
+            }
+        }
+
+        if (transferFamily == U32_MAX)
+        {
+            transferFamily = graphicsFamily;
+            transferQueueIndex = queueFamilies[graphicsFamily].queueCount > 1 ? 1 : 0;
+        }
 
-        float queuePriority = 1.0f;
+        float queuePriorities[2] = {1.0f, 1.0f};
 
         //**raytrace***
         VkPhysicalDeviceRayQueryFeaturesKHR deviceRayQueryFeaturesKhr{};
@@ -245,27 +420,23 @@ namespace Fyrion
         //endraytrace.
 
         Array<VkDeviceQueueCreateInfo> queueCreateInfos{};
-        if (graphicsFamily != presentFamily)
+        for (u32 family : {graphicsFamily, presentFamily, transferFamily})
         {
-            queueCreateInfos.Resize(2);
-
-            queueCreateInfos[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            queueCreateInfos[0].queueFamilyIndex = graphicsFamily;
-            queueCreateInfos[0].queueCount = 1;
-            queueCreateInfos[0].pQueuePriorities = &queuePriority;
+            bool found = false;
+            for (const VkDeviceQueueCreateInfo& queueCreateInfo : queueCreateInfos)
+            {
+                found |= queueCreateInfo.queueFamilyIndex == family;
+            }
 
-            queueCreateInfos[1].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            queueCreateInfos[1].queueFamilyIndex = presentFamily;
-            queueCreateInfos[1].queueCount = 1;
-            queueCreateInfos[1].pQueuePriorities = &queuePriority;
-        }
-        else
-        {
-            queueCreateInfos.Resize(1);
-            queueCreateInfos[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            queueCreateInfos[0].queueFamilyIndex = graphicsFamily;
-            queueCreateInfos[0].queueCount = 1;
-            queueCreateInfos[0].pQueuePriorities = &queuePriority;
+            if (!found)
+            {
+                queueCreateInfos.EmplaceBack(VkDeviceQueueCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+                    .queueFamilyIndex = family,
+                    .queueCount = family == transferFamily ? transferQueueIndex + 1 : 1,
+                    .pQueuePriorities = queuePriorities
+                });
+            }
         }
 
         VkPhysicalDeviceFeatures physicalDeviceFeatures{};
@@ -285,6 +456,8 @@ namespace Fyrion
 
         VkPhysicalDeviceVulkan12Features features12{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
         features12.bufferDeviceAddress = VK_TRUE;
+        features12.timelineSemaphore = VK_TRUE;
+        features12.drawIndirectCount = deviceFeatures.drawIndirectCountSupported ? VK_TRUE : VK_FALSE;
 
         VkPhysicalDeviceMaintenance4FeaturesKHR vkPhysicalDeviceMaintenance4FeaturesKhr{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_4_FEATURES_KHR};
         vkPhysicalDeviceMaintenance4FeaturesKhr.maintenance4 = true;
@@ -301,13 +474,13 @@ namespace Fyrion
 
         if (deviceFeatures.bindlessSupported)
         {
-            //TODO do I need all these features?
-            features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
             features12.runtimeDescriptorArray = VK_TRUE;
-            features12.descriptorBindingVariableDescriptorCount = VK_TRUE;
             features12.descriptorBindingPartiallyBound = VK_TRUE;
+            features12.descriptorBindingVariableDescriptorCount = VK_TRUE;
+            features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+            features12.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
             features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
-            features12.descriptorBindingUniformBufferUpdateAfterBind = VK_TRUE;
+            features12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
         }
 
         VkDeviceCreateInfo createInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
@@ -377,8 +550,28 @@ namespace Fyrion
         for (int j = 0; j < FY_FRAMES_IN_FLIGHT; ++j)
         {
             defaultCommands[j] = MakeShared<VulkanCommands>(*this);
+            uploadCommands[j] = MakeShared<VulkanCommands>(*this);
+
+            if (vulkanDeviceProperties.limits.timestampComputeAndGraphics)
+            {
+                VkQueryPoolCreateInfo queryPoolInfo{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+                queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+                queryPoolInfo.queryCount = MaxTimestampQueries;
+                vkCreateQueryPool(device, &queryPoolInfo, nullptr, &defaultCommands[j]->timestampPool);
+            }
         }
 
+        VkBufferCreateInfo stagingBufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        stagingBufferInfo.size = StagingFrameSize * FY_FRAMES_IN_FLIGHT;
+        stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        stagingBufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo stagingAllocInfo = {};
+        stagingAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        vmaCreateBuffer(vmaAllocator, &stagingBufferInfo, &stagingAllocInfo, &stagingBuffer.buffer, &stagingBuffer.allocation, &stagingBuffer.allocInfo);
+        uploadWindowStart = Platform::GetTime();
+
         VkDescriptorPoolSize sizes[5] = {
             {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 500},
             {VK_DESCRIPTOR_TYPE_SAMPLER, 500},
@@ -400,8 +593,28 @@ namespace Fyrion
         }
 
         vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool);
+
+        if (deviceFeatures.bindlessSupported)
+        {
+            CreateBindlessHeap();
+        }
         vkGetDeviceQueue(device, graphicsFamily, 0, &graphicsQueue);
         vkGetDeviceQueue(device, presentFamily, 0, &presentQueue);
+        vkGetDeviceQueue(device, transferFamily, transferQueueIndex, &transferQueue);
+        transferQueueShared = transferQueue == graphicsQueue || transferQueue == presentQueue;
+
+        VkCommandPoolCreateInfo transferPoolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        transferPoolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        transferPoolInfo.queueFamilyIndex = transferFamily;
+        vkCreateCommandPool(device, &transferPoolInfo, nullptr, &transferCommandPool);
+
+        VkSemaphoreTypeCreateInfo timelineInfo{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+        timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo transferSemaphoreInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        transferSemaphoreInfo.pNext = &timelineInfo;
+        vkCreateSemaphore(device, &transferSemaphoreInfo, nullptr, &transferSemaphore);
 
 
         VkSemaphoreCreateInfo semaphoreInfo{};
@@ -426,167 +639,546 @@ namespace Fyrion
                     VK_VERSION_MINOR(vulkanDeviceProperties.apiVersion),
                     VK_VERSION_PATCH(vulkanDeviceProperties.apiVersion),
                     vulkanDeviceProperties.deviceName);
+
+        LoadPipelineCache();
     }
 
-    bool VulkanDevice::CreateSwapchain(VulkanSwapchain* swapchain)
+    void VulkanDevice::CreateBindlessHeap()
     {
-        if (Platform::CreateWindowSurface(swapchain->window, instance, &swapchain->surfaceKHR) != VK_SUCCESS)
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES};
+        VkPhysicalDeviceProperties2                  deviceProperties2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, &indexingProperties};
+        vkGetPhysicalDeviceProperties2(physicalDevice, &deviceProperties2);
+
+        bindlessTextureIndices.SetCapacity(Math::Min(MaxBindlessResources, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages));
+        bindlessSamplerIndices.SetCapacity(Math::Min(MaxBindlessResources, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers));
+        bindlessBufferIndices.SetCapacity(Math::Min(MaxBindlessResources, indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers));
+
+        VkDescriptorSetLayoutBinding bindings[3] = {
+            {BindlessTextureBinding, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, bindlessTextureIndices.GetCapacity(), VK_SHADER_STAGE_ALL, nullptr},
+            {BindlessSamplerBinding, VK_DESCRIPTOR_TYPE_SAMPLER, bindlessSamplerIndices.GetCapacity(), VK_SHADER_STAGE_ALL, nullptr},
+            {BindlessBufferBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindlessBufferIndices.GetCapacity(), VK_SHADER_STAGE_ALL, nullptr},
+        };
+
+        //slots not used by the frames in flight can be written while the set is bound.
+        VkDescriptorBindingFlags bindingFlags[3] = {};
+        for (VkDescriptorBindingFlags& flags : bindingFlags)
         {
-            logger.Error("Error on create CreateWindowSurface");
-            return false;
+            flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
         }
 
-        VulkanSwapChainSupportDetails details = Vulkan::QuerySwapChainSupport(physicalDevice, swapchain->surfaceKHR);
-        VkSurfaceFormatKHR            format = Vulkan::ChooseSwapSurfaceFormat(details, {VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR});
-        VkPresentModeKHR              presentMode = Vulkan::ChooseSwapPresentMode(details, swapchain->vsync ? VK_PRESENT_MODE_FIFO_KHR : VK_PRESENT_MODE_MAILBOX_KHR);
-        Extent                        extent = Platform::GetWindowExtent(swapchain->window);
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO};
+        bindingFlagsInfo.bindingCount = 3;
+        bindingFlagsInfo.pBindingFlags = bindingFlags;
 
-        swapchain->extent = Vulkan::ChooseSwapExtent(details, {extent.width, extent.height});
+        VkDescriptorSetLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+        layoutInfo.pNext = &bindingFlagsInfo;
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = 3;
+        layoutInfo.pBindings = bindings;
+        vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &bindlessDescriptorSetLayout);
 
-        u32 imageCount = details.capabilities.minImageCount + 1;
-        if (details.capabilities.maxImageCount > 0 && imageCount > details.capabilities.maxImageCount)
+        VkDescriptorPoolSize sizes[3] = {
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, bindlessTextureIndices.GetCapacity()},
+            {VK_DESCRIPTOR_TYPE_SAMPLER, bindlessSamplerIndices.GetCapacity()},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindlessBufferIndices.GetCapacity()}
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.poolSizeCount = 3;
+        poolInfo.pPoolSizes = sizes;
+        poolInfo.maxSets = 1;
+        vkCreateDescriptorPool(device, &poolInfo, nullptr, &bindlessDescriptorPool);
+
+        VkDescriptorSetAllocateInfo allocInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+        allocInfo.descriptorPool = bindlessDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &bindlessDescriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(device, &allocInfo, &bindlessDescriptorSet) != VK_SUCCESS)
         {
-            imageCount = details.capabilities.maxImageCount;
+            logger.Error("Failed to allocate bindless descriptor set, bindless disabled");
+            deviceFeatures.bindlessSupported = false;
         }
+    }
 
-        VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, presentFamily, swapchain->surfaceKHR, &presentSupport);
-        if (!presentSupport)
+    VkDescriptorSetLayout VulkanDevice::GetDescriptorSetLayout(const DescriptorLayout& descriptorLayout)
+    {
+        usize hash = 0;
+        for (const DescriptorBinding& binding : descriptorLayout.bindings)
         {
-            logger.Error("PhysicalDeviceSurfaceSupportKHR not supported");
-            return false;
+            HashCombine(hash,
+                        HashValue(binding.binding),
+                        HashValue(binding.count),
+                        HashValue(static_cast<u32>(binding.descriptorType)),
+                        HashValue(static_cast<u32>(binding.renderType)),
+                        HashValue(static_cast<u32>(binding.shaderStage)));
         }
 
-        VkSwapchainCreateInfoKHR createInfo{};
-        createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-        createInfo.surface = swapchain->surfaceKHR;
-        createInfo.minImageCount = imageCount;
-        createInfo.imageFormat = format.format;
-        createInfo.imageColorSpace = format.colorSpace;
-        createInfo.imageExtent = swapchain->extent;
-        createInfo.imageArrayLayers = 1;
-        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-
-        u32 queueFamilyIndices[] = {graphicsFamily, presentFamily};
-        if (graphicsFamily != presentFamily)
+        auto it = descriptorSetLayouts.Find(hash);
+        if (it != descriptorSetLayouts.end())
         {
-            createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
-            createInfo.queueFamilyIndexCount = 2;
-            createInfo.pQueueFamilyIndices = queueFamilyIndices;
+            for (const VulkanDescriptorSetLayout& descriptorSetLayout : it->second)
+            {
+                if (MatchDescriptorBindings(descriptorSetLayout.bindings, descriptorLayout.bindings))
+                {
+                    return descriptorSetLayout.layout;
+                }
+            }
         }
         else
         {
-            createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-            createInfo.queueFamilyIndexCount = 0;
-            createInfo.pQueueFamilyIndices = nullptr;
+            it = descriptorSetLayouts.Insert(hash, {}).first;
         }
 
-        createInfo.preTransform = details.capabilities.currentTransform;
-        createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-        createInfo.presentMode = presentMode;
-        createInfo.clipped = VK_TRUE;
-        createInfo.oldSwapchain = VK_NULL_HANDLE;
+        VkDescriptorSetLayout layout{};
+        Vulkan::CreateDescriptorSetLayout(device, descriptorLayout, &layout);
+        it->second.EmplaceBack(VulkanDescriptorSetLayout{
+            .bindings = descriptorLayout.bindings,
+            .layout = layout
+        });
+        return layout;
+    }
 
-        vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapchain->swapchainKHR);
-        vkGetSwapchainImagesKHR(device, swapchain->swapchainKHR, &imageCount, nullptr);
+    void VulkanDevice::FreeDescriptorSet(VkDescriptorSet descriptorSet)
+    {
+        pendingDescriptorSets.EmplaceBack(VulkanPendingDescriptorSet{descriptorSet, frameCount});
+    }
 
-        swapchain->format = format.format;
-        swapchain->images.Resize(imageCount);
-        swapchain->imageViews.Resize(imageCount);
-        swapchain->renderPasses.Resize(imageCount);
+    VkDescriptorPool VulkanDevice::CreateFrameDescriptorPool()
+    {
+        VkDescriptorPoolSize sizes[6] = {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 500},
+            {VK_DESCRIPTOR_TYPE_SAMPLER, 500},
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 500},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 500},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 500},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 500}
+        };
 
-        vkGetSwapchainImagesKHR(device, swapchain->swapchainKHR, &imageCount, swapchain->images.Data());
+        VkDescriptorPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+        poolInfo.poolSizeCount = 6;
+        poolInfo.pPoolSizes = sizes;
+        poolInfo.maxSets = 500;
 
-        for (size_t i = 0; i < imageCount; i++)
+        if (deviceFeatures.bindlessSupported)
         {
-            VkImageViewCreateInfo imageViewCreateInfo{};
-            imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-            imageViewCreateInfo.image = swapchain->images[i];
-            imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-            imageViewCreateInfo.format = format.format;
-            imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-            imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-            imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-            imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-            imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
-            imageViewCreateInfo.subresourceRange.levelCount = 1;
-            imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
-            imageViewCreateInfo.subresourceRange.layerCount = 1;
-            vkCreateImageView(device, &imageViewCreateInfo, nullptr, &swapchain->imageViews[i]);
+            poolInfo.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
         }
 
-        for (int i = 0; i < imageCount; ++i)
-        {
-            VulkanRenderPass& vulkanRenderPass = swapchain->renderPasses[i];
-            vulkanRenderPass.extent = swapchain->extent;
-            vulkanRenderPass.clearValues.Resize(1);
+        VkDescriptorPool pool{};
+        vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool);
+        return pool;
+    }
 
-            VkAttachmentDescription attachmentDescription{};
-            VkAttachmentReference   colorAttachmentReference{};
+    VkDescriptorSet VulkanDevice::AllocateDescriptorSet(VkDescriptorSetLayout layout, BindingSetType bindingSetType)
+    {
+        VkDescriptorSetAllocateInfo allocInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
 
-            attachmentDescription.format = format.format;
-            attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
-            attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-            attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-            attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        VkDescriptorSet descriptorSet{};
 
-            colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            colorAttachmentReference.attachment = 0;
+        if (bindingSetType == BindingSetType::Static)
+        {
+            allocInfo.descriptorPool = descriptorPool;
+            if (vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet) != VK_SUCCESS)
+            {
+                logger.Error("Failed to allocate descriptor set");
+                return VK_NULL_HANDLE;
+            }
+            descriptorStats.allocations++;
+            return descriptorSet;
+        }
 
-            VkSubpassDescription subPass = {};
-            subPass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-            subPass.colorAttachmentCount = 1;
-            subPass.pColorAttachments = &colorAttachmentReference;
+        //a full frame pool moves to the next one, pools are kept and reused in the next frames.
+        Array<VkDescriptorPool>& pools = frameDescriptorPools[currentFrame];
+        u32&                     poolIndex = frameDescriptorPoolIndex[currentFrame];
 
-            VkRenderPassCreateInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
-            renderPassInfo.attachmentCount = 1;
-            renderPassInfo.pAttachments = &attachmentDescription;
-            renderPassInfo.subpassCount = 1;
-            renderPassInfo.pSubpasses = &subPass;
-            renderPassInfo.dependencyCount = 0;
-            vkCreateRenderPass(device, &renderPassInfo, nullptr, &vulkanRenderPass.renderPass);
+        while (true)
+        {
+            if (poolIndex == pools.Size())
+            {
+                pools.EmplaceBack(CreateFrameDescriptorPool());
+            }
 
-            VkFramebufferCreateInfo framebufferCreateInfo{};
-            framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-            framebufferCreateInfo.renderPass = vulkanRenderPass.renderPass;
-            framebufferCreateInfo.width = vulkanRenderPass.extent.width;
-            framebufferCreateInfo.height = vulkanRenderPass.extent.height;
-            framebufferCreateInfo.layers = 1u;
-            framebufferCreateInfo.attachmentCount = 1;
-            framebufferCreateInfo.pAttachments = &swapchain->imageViews[i];
-            vkCreateFramebuffer(device, &framebufferCreateInfo, nullptr, &vulkanRenderPass.framebuffer);
-        }
+            allocInfo.descriptorPool = pools[poolIndex];
+            VkResult result = vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet);
+            if (result == VK_SUCCESS)
+            {
+                descriptorStats.allocations++;
+                return descriptorSet;
+            }
 
-        VkSemaphoreCreateInfo semaphoreInfo{};
-        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-        for (int i = 0; i < FY_FRAMES_IN_FLIGHT; ++i)
-        {
-            vkCreateSemaphore(device, &semaphoreInfo, nullptr, &swapchain->imageAvailableSemaphores[i]);
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+            {
+                logger.Error("Failed to allocate descriptor set");
+                return VK_NULL_HANDLE;
+            }
+            poolIndex++;
         }
-
-        return true;
     }
 
-    void VulkanDevice::DestroySwapchain(VulkanSwapchain* swapchain)
+    void VulkanDevice::WriteBindlessDescriptor(u32 binding, u32 index, VkDescriptorType descriptorType, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
     {
-        if (swapchain == nullptr) return;
+        VkWriteDescriptorSet write{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        write.dstSet = bindlessDescriptorSet;
+        write.dstBinding = binding;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = descriptorType;
+        write.pImageInfo = imageInfo;
+        write.pBufferInfo = bufferInfo;
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    }
 
-        vkDeviceWaitIdle(device);
+    void VulkanDevice::LoadPipelineCache()
+    {
+        pipelineCachePath = Path::Join(ShaderManager::GetCacheDirectory(), "PipelineCache.bin");
 
-        for (int i = 0; i < swapchain->renderPasses.Size(); ++i)
+        Array<u8> data{};
+        if (FileSystem::GetFileStatus(pipelineCachePath).exists)
         {
-            vkDestroyRenderPass(device, swapchain->renderPasses[i].renderPass, nullptr);
-            vkDestroyFramebuffer(device, swapchain->renderPasses[i].framebuffer, nullptr);
+            data = FileSystem::ReadFileAsByteArray(pipelineCachePath);
         }
 
-        for (int i = 0; i < swapchain->imageViews.Size(); ++i)
+        //data from another driver or device is discarded, drivers are not required to handle it gracefully.
+        if (data.Size() >= sizeof(VkPipelineCacheHeaderVersionOne))
         {
-            vkDestroyImageView(device, swapchain->imageViews[i], nullptr);
-        }
+            VkPipelineCacheHeaderVersionOne header{};
+            memcpy(&header, data.Data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+            if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+                header.vendorID != vulkanDeviceProperties.vendorID ||
+                header.deviceID != vulkanDeviceProperties.deviceID ||
+                memcmp(header.pipelineCacheUUID, vulkanDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+            {
+                logger.Debug("pipeline cache {} is from another device, discarded", pipelineCachePath);
+                data.Clear();
+            }
+        }
+        else
+        {
+            data.Clear();
+        }
+
+        VkPipelineCacheCreateInfo pipelineCacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        pipelineCacheInfo.initialDataSize = data.Size();
+        pipelineCacheInfo.pInitialData = data.Data();
+
+        if (vkCreatePipelineCache(device, &pipelineCacheInfo, nullptr, &pipelineCache) != VK_SUCCESS && !data.Empty())
+        {
+            pipelineCacheInfo.initialDataSize = 0;
+            pipelineCacheInfo.pInitialData = nullptr;
+            vkCreatePipelineCache(device, &pipelineCacheInfo, nullptr, &pipelineCache);
+        }
+    }
+
+    void VulkanDevice::SavePipelineCache()
+    {
+        if (!pipelineCache || pipelineCachePath.Empty())
+        {
+            return;
+        }
+
+        usize size = 0;
+        if (vkGetPipelineCacheData(device, pipelineCache, &size, nullptr) != VK_SUCCESS || size == 0)
+        {
+            return;
+        }
+
+        Array<u8> data(size);
+        if (vkGetPipelineCacheData(device, pipelineCache, &size, data.Data()) != VK_SUCCESS)
+        {
+            return;
+        }
+
+        FileSystem::CreateDirectory(Path::Parent(pipelineCachePath));
+
+        String tempPath = pipelineCachePath + FY_TEMP_EXTENSION;
+        FileHandler fileHandler = FileSystem::OpenFile(tempPath, AccessMode::WriteOnly);
+        if (fileHandler)
+        {
+            bool written = FileSystem::WriteFile(fileHandler, data.Data(), size) == size;
+            FileSystem::CloseFile(fileHandler);
+            if (written && FileSystem::Rename(tempPath, pipelineCachePath))
+            {
+                return;
+            }
+            FileSystem::Remove(tempPath);
+        }
+        logger.Warn("pipeline cache cannot be saved on {}", pipelineCachePath);
+    }
+
+    VkRenderPass VulkanDevice::GetCompatibleRenderPass(const GraphicsPipelineCreation& graphicsPipelineCreation)
+    {
+        usize hash = HashRenderPassFormats(graphicsPipelineCreation);
+        auto it = compatibleRenderPasses.Find(hash);
+        if (it != compatibleRenderPasses.end())
+        {
+            for (const VulkanCompatibleRenderPass& compatibleRenderPass : it->second)
+            {
+                if (MatchRenderPassFormats(compatibleRenderPass.attachments, compatibleRenderPass.depthFormat, graphicsPipelineCreation))
+                {
+                    return compatibleRenderPass.renderPass;
+                }
+            }
+        }
+        else
+        {
+            it = compatibleRenderPasses.Insert(hash, {}).first;
+        }
+
+        Array<VkAttachmentDescription> attachmentDescriptions{};
+        Array<VkAttachmentReference>   colorAttachmentReference{};
+        VkAttachmentReference          depthReference{};
+
+        for (Format attachmentFormat : graphicsPipelineCreation.attachments)
+        {
+            VkAttachmentDescription attachmentDescription{};
+            attachmentDescription.format = Vulkan::CastFormat(attachmentFormat);
+            attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+            attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            attachmentDescriptions.EmplaceBack(attachmentDescription);
+
+            VkAttachmentReference reference{};
+            reference.attachment = colorAttachmentReference.Size();
+            reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorAttachmentReference.EmplaceBack(reference);
+        }
+
+        if (graphicsPipelineCreation.depthFormat != Format::Undefined)
+        {
+            VkAttachmentDescription attachmentDescription{};
+            attachmentDescription.format = VK_FORMAT_D32_SFLOAT;
+            attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+            attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            attachmentDescriptions.EmplaceBack(attachmentDescription);
+
+            VkAttachmentReference reference{};
+            depthReference.attachment = colorAttachmentReference.Size();
+            depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            colorAttachmentReference.EmplaceBack(reference);
+        }
+
+        VkSubpassDescription subPass = {};
+        subPass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subPass.colorAttachmentCount = colorAttachmentReference.Size();
+        subPass.pColorAttachments = colorAttachmentReference.Data();
+        if (graphicsPipelineCreation.depthFormat != Format::Undefined)
+        {
+            subPass.pDepthStencilAttachment = &depthReference;
+        }
+
+        VkRenderPass           renderPass = {};
+        VkRenderPassCreateInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+        renderPassInfo.attachmentCount = attachmentDescriptions.Size();
+        renderPassInfo.pAttachments = attachmentDescriptions.Data();
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subPass;
+        renderPassInfo.dependencyCount = 0;
+        vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass);
+
+        it->second.EmplaceBack(VulkanCompatibleRenderPass{
+            .attachments = Array<Format>(graphicsPipelineCreation.attachments),
+            .depthFormat = graphicsPipelineCreation.depthFormat,
+            .renderPass = renderPass
+        });
+        return renderPass;
+    }
+
+    bool VulkanDevice::CreateSwapchain(VulkanSwapchain* swapchain)
+    {
+        if (Platform::CreateWindowSurface(swapchain->window, instance, &swapchain->surfaceKHR) != VK_SUCCESS)
+        {
+            logger.Error("Error on create CreateWindowSurface");
+            return false;
+        }
+
+        VulkanSwapChainSupportDetails details = Vulkan::QuerySwapChainSupport(physicalDevice, swapchain->surfaceKHR);
+        VkSurfaceFormatKHR            format = Vulkan::ChooseSwapSurfaceFormat(details, {VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR});
+        VkPresentModeKHR              presentMode = VK_PRESENT_MODE_FIFO_KHR;
+        Extent                        extent = Platform::GetWindowExtent(swapchain->window);
+
+        if (swapchain->presentMode == PresentMode::Immediate)
+        {
+            presentMode = Vulkan::ChooseSwapPresentMode(details, VK_PRESENT_MODE_IMMEDIATE_KHR);
+        }
+
+        if (swapchain->presentMode != PresentMode::Fifo && presentMode == VK_PRESENT_MODE_FIFO_KHR)
+        {
+            presentMode = Vulkan::ChooseSwapPresentMode(details, VK_PRESENT_MODE_MAILBOX_KHR);
+        }
+
+        switch (presentMode)
+        {
+            case VK_PRESENT_MODE_IMMEDIATE_KHR: swapchain->activePresentMode = PresentMode::Immediate; break;
+            case VK_PRESENT_MODE_MAILBOX_KHR: swapchain->activePresentMode = PresentMode::Mailbox; break;
+            default: swapchain->activePresentMode = PresentMode::Fifo; break;
+        }
+
+        if (swapchain->activePresentMode != swapchain->presentMode)
+        {
+            logger.Warn("present mode {} not supported, using {}", static_cast<u32>(swapchain->presentMode), static_cast<u32>(swapchain->activePresentMode));
+        }
+        swapchain->recreate = false;
+
+        swapchain->extent = Vulkan::ChooseSwapExtent(details, {extent.width, extent.height});
+
+        u32 imageCount = details.capabilities.minImageCount + 1;
+        if (details.capabilities.maxImageCount > 0 && imageCount > details.capabilities.maxImageCount)
+        {
+            imageCount = details.capabilities.maxImageCount;
+        }
+
+        VkBool32 presentSupport = false;
+        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, presentFamily, swapchain->surfaceKHR, &presentSupport);
+        if (!presentSupport)
+        {
+            logger.Error("PhysicalDeviceSurfaceSupportKHR not supported");
+            return false;
+        }
+
+        VkSwapchainCreateInfoKHR createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        createInfo.surface = swapchain->surfaceKHR;
+        createInfo.minImageCount = imageCount;
+        createInfo.imageFormat = format.format;
+        createInfo.imageColorSpace = format.colorSpace;
+        createInfo.imageExtent = swapchain->extent;
+        createInfo.imageArrayLayers = 1;
+        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+        u32 queueFamilyIndices[] = {graphicsFamily, presentFamily};
+        if (graphicsFamily != presentFamily)
+        {
+            createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = 2;
+            createInfo.pQueueFamilyIndices = queueFamilyIndices;
+        }
+        else
+        {
+            createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount = 0;
+            createInfo.pQueueFamilyIndices = nullptr;
+        }
+
+        createInfo.preTransform = details.capabilities.currentTransform;
+        createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        createInfo.presentMode = presentMode;
+        createInfo.clipped = VK_TRUE;
+        createInfo.oldSwapchain = VK_NULL_HANDLE;
+
+        vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapchain->swapchainKHR);
+        vkGetSwapchainImagesKHR(device, swapchain->swapchainKHR, &imageCount, nullptr);
+
+        swapchain->format = format.format;
+        swapchain->images.Resize(imageCount);
+        swapchain->imageViews.Resize(imageCount);
+        swapchain->renderPasses.Resize(imageCount);
+
+        vkGetSwapchainImagesKHR(device, swapchain->swapchainKHR, &imageCount, swapchain->images.Data());
+
+        for (size_t i = 0; i < imageCount; i++)
+        {
+            VkImageViewCreateInfo imageViewCreateInfo{};
+            imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            imageViewCreateInfo.image = swapchain->images[i];
+            imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            imageViewCreateInfo.format = format.format;
+            imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+            imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+            imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+            imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+            imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+            imageViewCreateInfo.subresourceRange.levelCount = 1;
+            imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+            imageViewCreateInfo.subresourceRange.layerCount = 1;
+            vkCreateImageView(device, &imageViewCreateInfo, nullptr, &swapchain->imageViews[i]);
+        }
+
+        for (int i = 0; i < imageCount; ++i)
+        {
+            VulkanRenderPass& vulkanRenderPass = swapchain->renderPasses[i];
+            vulkanRenderPass.extent = swapchain->extent;
+            vulkanRenderPass.clearValues.Resize(1);
+
+            VkAttachmentDescription attachmentDescription{};
+            VkAttachmentReference   colorAttachmentReference{};
+
+            attachmentDescription.format = format.format;
+            attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+            attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+            colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorAttachmentReference.attachment = 0;
+
+            VkSubpassDescription subPass = {};
+            subPass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subPass.colorAttachmentCount = 1;
+            subPass.pColorAttachments = &colorAttachmentReference;
+
+            VkRenderPassCreateInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+            renderPassInfo.attachmentCount = 1;
+            renderPassInfo.pAttachments = &attachmentDescription;
+            renderPassInfo.subpassCount = 1;
+            renderPassInfo.pSubpasses = &subPass;
+            renderPassInfo.dependencyCount = 0;
+            vkCreateRenderPass(device, &renderPassInfo, nullptr, &vulkanRenderPass.renderPass);
+
+            VkFramebufferCreateInfo framebufferCreateInfo{};
+            framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferCreateInfo.renderPass = vulkanRenderPass.renderPass;
+            framebufferCreateInfo.width = vulkanRenderPass.extent.width;
+            framebufferCreateInfo.height = vulkanRenderPass.extent.height;
+            framebufferCreateInfo.layers = 1u;
+            framebufferCreateInfo.attachmentCount = 1;
+            framebufferCreateInfo.pAttachments = &swapchain->imageViews[i];
+            vkCreateFramebuffer(device, &framebufferCreateInfo, nullptr, &vulkanRenderPass.framebuffer);
+        }
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        for (int i = 0; i < FY_FRAMES_IN_FLIGHT; ++i)
+        {
+            vkCreateSemaphore(device, &semaphoreInfo, nullptr, &swapchain->imageAvailableSemaphores[i]);
+        }
+
+        return true;
+    }
+
+    void VulkanDevice::DestroySwapchain(VulkanSwapchain* swapchain)
+    {
+        if (swapchain == nullptr) return;
+
+        vkDeviceWaitIdle(device);
+
+        for (int i = 0; i < swapchain->renderPasses.Size(); ++i)
+        {
+            vkDestroyRenderPass(device, swapchain->renderPasses[i].renderPass, nullptr);
+            vkDestroyFramebuffer(device, swapchain->renderPasses[i].framebuffer, nullptr);
+        }
+
+        for (int i = 0; i < swapchain->imageViews.Size(); ++i)
+        {
+            vkDestroyImageView(device, swapchain->imageViews[i], nullptr);
+        }
 
         vkDestroySwapchainKHR(device, swapchain->swapchainKHR, nullptr);
         vkDestroySurfaceKHR(instance, swapchain->surfaceKHR, nullptr);
@@ -601,7 +1193,7 @@ namespace Fyrion
     {
         VulkanSwapchain* vulkanSwapchain = allocator.Alloc<VulkanSwapchain>(VulkanSwapchain{
             .window = swapchainCreation.window,
-            .vsync = swapchainCreation.vsync
+            .presentMode = swapchainCreation.presentMode
         });
         return CreateSwapchain(vulkanSwapchain) ? Swapchain{vulkanSwapchain} : Swapchain{};
     }
@@ -624,10 +1216,10 @@ namespace Fyrion
 		{
 			const AttachmentCreation& attachment = renderPassCreation.attachments[i];
 
-			VulkanTexture* vulkanTexture = static_cast<VulkanTexture*>(attachment.texture.handler);
+			VulkanTexture* vulkanTexture = GetTexture(attachment.texture);
 			FY_ASSERT(vulkanTexture, "texture is mandatory");
 
-			imageViews.EmplaceBack(static_cast<VulkanTextureView*>(vulkanTexture->textureView.handler)->imageView);
+			imageViews.EmplaceBack(GetTextureView(vulkanTexture->textureView)->imageView);
 
 			VkFormat format = Vulkan::CastFormat(vulkanTexture->creation.format);
 			framebufferSize = vulkanTexture->creation.extent;
@@ -663,7 +1255,7 @@ namespace Fyrion
 			attachmentDescriptions.EmplaceBack(attachmentDescription);
 		}
 
-		vulkanRenderPass->extent = {framebufferSize.height, framebufferSize.width};
+		vulkanRenderPass->extent = {framebufferSize.width, framebufferSize.height};
 
 		VkSubpassDescription subPass = {};
 		subPass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
@@ -699,7 +1291,8 @@ namespace Fyrion
 
     Buffer VulkanDevice::CreateBuffer(const BufferCreation& bufferCreation)
     {
-        VulkanBuffer* vulkanBuffer = allocator.Alloc<VulkanBuffer>(bufferCreation);
+        VoidPtr       handler = buffers.Create(bufferCreation);
+        VulkanBuffer* vulkanBuffer = buffers.Get(handler);
 
         VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
         bufferInfo.size = bufferCreation.size;
@@ -730,12 +1323,23 @@ namespace Fyrion
             break;
         }
         vmaCreateBuffer(vmaAllocator, &bufferInfo, &vmaAllocInfo, &vulkanBuffer->buffer, &vulkanBuffer->allocation, &vulkanBuffer->allocInfo);
-        return {vulkanBuffer};
+
+        if (deviceFeatures.bindlessSupported && (bufferCreation.usage && BufferUsage::StorageBuffer))
+        {
+            vulkanBuffer->bindlessIndex = bindlessBufferIndices.Allocate();
+            if (vulkanBuffer->bindlessIndex != U32_MAX)
+            {
+                VkDescriptorBufferInfo descriptorBufferInfo{vulkanBuffer->buffer, 0, VK_WHOLE_SIZE};
+                WriteBindlessDescriptor(BindlessBufferBinding, vulkanBuffer->bindlessIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &descriptorBufferInfo);
+            }
+        }
+        return {handler};
     }
 
     Texture VulkanDevice::CreateTexture(const TextureCreation& textureCreation)
     {
-        VulkanTexture* vulkanTexture = allocator.Alloc<VulkanTexture>(textureCreation);
+        Texture        texture = Texture{textures.Create(textureCreation)};
+        VulkanTexture* vulkanTexture = textures.Get(texture.handler);
 
         VkImageCreateInfo imageCreateInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
         imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -760,8 +1364,6 @@ namespace Fyrion
 
         vmaCreateImage(vmaAllocator, &imageCreateInfo, &allocInfo, &vulkanTexture->image, &vulkanTexture->allocation, nullptr);
 
-        Texture texture = Texture{vulkanTexture};
-
         TextureViewCreation textureViewCreation{
             .texture = texture,
             .viewType = textureCreation.defaultView != ViewType::Undefined ? textureCreation.defaultView : ViewType::Type2D,
@@ -782,10 +1384,15 @@ namespace Fyrion
 
     TextureView VulkanDevice::CreateTextureView(const TextureViewCreation& textureViewCreation)
     {
-        VulkanTextureView* vulkanTextureView = allocator.Alloc<VulkanTextureView>();
-        vulkanTextureView->texture = textureViewCreation.texture;
+        VulkanTexture* vulkanTexture = GetTexture(textureViewCreation.texture);
+        if (!vulkanTexture)
+        {
+            return {};
+        }
 
-        VulkanTexture* vulkanTexture = static_cast<VulkanTexture*>(textureViewCreation.texture.handler);
+        VoidPtr            handler = textureViews.Create();
+        VulkanTextureView* vulkanTextureView = textureViews.Get(handler);
+        vulkanTextureView->texture = textureViewCreation.texture;
 
         VkImageViewCreateInfo viewCreateInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
         viewCreateInfo.viewType = Vulkan::CastViewType(textureViewCreation.viewType);
@@ -807,12 +1414,24 @@ namespace Fyrion
 
         vkCreateImageView(device, &viewCreateInfo, nullptr, &vulkanTextureView->imageView);
 
-        return {vulkanTextureView};
+        TextureUsage usage = vulkanTexture->creation.usage;
+        if (deviceFeatures.bindlessSupported && (usage == TextureUsage::None || (usage && TextureUsage::ShaderResource)))
+        {
+            vulkanTextureView->bindlessIndex = bindlessTextureIndices.Allocate();
+            if (vulkanTextureView->bindlessIndex != U32_MAX)
+            {
+                VkDescriptorImageInfo descriptorImageInfo{VK_NULL_HANDLE, vulkanTextureView->imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+                WriteBindlessDescriptor(BindlessTextureBinding, vulkanTextureView->bindlessIndex, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &descriptorImageInfo, nullptr);
+            }
+        }
+
+        return {handler};
     }
 
     Sampler VulkanDevice::CreateSampler(const SamplerCreation& samplerCreation)
     {
-        VulkanSampler* vulkanSampler = allocator.Alloc<VulkanSampler>();
+        VoidPtr        handler = samplers.Create();
+        VulkanSampler* vulkanSampler = samplers.Get(handler);
         VkSamplerCreateInfo vkSamplerInfo{};
         vkSamplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
         vkSamplerInfo.magFilter = Vulkan::CastFilter(samplerCreation.filter);
@@ -831,11 +1450,41 @@ namespace Fyrion
         vkSamplerInfo.minLod = samplerCreation.minLod;
         vkSamplerInfo.maxLod = samplerCreation.maxLod;
         vkCreateSampler(device, &vkSamplerInfo, nullptr, &vulkanSampler->sampler);
+
+        if (deviceFeatures.bindlessSupported)
+        {
+            vulkanSampler->bindlessIndex = bindlessSamplerIndices.Allocate();
+            if (vulkanSampler->bindlessIndex != U32_MAX)
+            {
+                VkDescriptorImageInfo descriptorImageInfo{vulkanSampler->sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED};
+                WriteBindlessDescriptor(BindlessSamplerBinding, vulkanSampler->bindlessIndex, VK_DESCRIPTOR_TYPE_SAMPLER, &descriptorImageInfo, nullptr);
+            }
+        }
         return {vulkanSampler};
     }
 
     PipelineState VulkanDevice::CreateGraphicsPipelineState(const GraphicsPipelineCreation& graphicsPipelineCreation)
     {
+        std::unique_lock lock(pipelineMutex);
+
+        usize hash = HashGraphicsPipeline(graphicsPipelineCreation);
+        auto it = graphicsPipelines.Find(hash);
+        if (it != graphicsPipelines.end())
+        {
+            for (VulkanPipelineState* pipelineState : it->second)
+            {
+                if (MatchGraphicsPipeline(*pipelineState, graphicsPipelineCreation))
+                {
+                    pipelineState->references++;
+                    return {pipelineState};
+                }
+            }
+        }
+        else
+        {
+            it = graphicsPipelines.Insert(hash, {}).first;
+        }
+
         ResourceObject shader = Repository::Read(graphicsPipelineCreation.shader);
 
         Span<u8>              bytes = shader[ShaderAsset::Bytes].As<Span<u8>>();
@@ -843,7 +1492,12 @@ namespace Fyrion
         ShaderInfo            shaderInfo = shader[ShaderAsset::Info].As<ShaderInfo>();
 
         VulkanPipelineState* vulkanPipelineState = allocator.Alloc<VulkanPipelineState>();
+        vulkanPipelineState->attachments = Array<Format>(graphicsPipelineCreation.attachments);
         vulkanPipelineState->graphicsPipelineCreation = graphicsPipelineCreation;
+        vulkanPipelineState->graphicsPipelineCreation.attachments = vulkanPipelineState->attachments;
+        vulkanPipelineState->shaderVersion = Repository::GetVersion(graphicsPipelineCreation.shader);
+        vulkanPipelineState->hash = hash;
+        vulkanPipelineState->references = 1;
 
         Array<VkPushConstantRange>                 pushConstants{};
         Array<VkPipelineColorBlendAttachmentState> attachments{};
@@ -914,7 +1568,7 @@ namespace Fyrion
             attachments.EmplaceBack(attachmentState);
         }
 
-        Vulkan::CreatePipelineLayout(device, shaderInfo.descriptors, shaderInfo.pushConstants, &vulkanPipelineState->layout);
+        vulkanPipelineState->bindless = Vulkan::CreatePipelineLayout(device, shaderInfo.descriptors, shaderInfo.pushConstants, &vulkanPipelineState->layout, bindlessDescriptorSetLayout);
 
         VkVertexInputBindingDescription bindingDescription{};
         bindingDescription.binding = 0;
@@ -980,67 +1634,6 @@ namespace Fyrion
         dynamicState.pDynamicStates = dynamicStateEnables.Data();
         dynamicState.dynamicStateCount = dynamicStateEnables.Size();
 
-        Array<VkAttachmentDescription> attachmentDescriptions{};
-        Array<VkAttachmentReference>   colorAttachmentReference{};
-        VkAttachmentReference          depthReference{};
-
-        for (Format attachmentFormat : graphicsPipelineCreation.attachments)
-        {
-            VkAttachmentDescription attachmentDescription{};
-            attachmentDescription.format = Vulkan::CastFormat(attachmentFormat);
-            attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
-            attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            attachmentDescriptions.EmplaceBack(attachmentDescription);
-
-            VkAttachmentReference reference{};
-            reference.attachment = colorAttachmentReference.Size();
-            reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            colorAttachmentReference.EmplaceBack(reference);
-        }
-
-        if (graphicsPipelineCreation.depthFormat != Format::Undefined)
-        {
-            VkAttachmentDescription attachmentDescription{};
-            attachmentDescription.format = VK_FORMAT_D32_SFLOAT;
-            attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
-            attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            attachmentDescriptions.EmplaceBack(attachmentDescription);
-
-            VkAttachmentReference reference{};
-            depthReference.attachment = colorAttachmentReference.Size();
-            depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            colorAttachmentReference.EmplaceBack(reference);
-        }
-
-        VkSubpassDescription subPass = {};
-        subPass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subPass.colorAttachmentCount = colorAttachmentReference.Size();
-        subPass.pColorAttachments = colorAttachmentReference.Data();
-        if (graphicsPipelineCreation.depthFormat != Format::Undefined)
-        {
-            subPass.pDepthStencilAttachment = &depthReference;
-        }
-
-        VkRenderPass           renderPass = {};
-        VkRenderPassCreateInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
-        renderPassInfo.attachmentCount = attachmentDescriptions.Size();
-        renderPassInfo.pAttachments = attachmentDescriptions.Data();
-        renderPassInfo.subpassCount = 1;
-        renderPassInfo.pSubpasses = &subPass;
-        renderPassInfo.dependencyCount = 0;
-        vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass);
-
-
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         pipelineInfo.stageCount = shaderStages.Size();
@@ -1055,7 +1648,7 @@ namespace Fyrion
         pipelineInfo.layout = vulkanPipelineState->layout;
         pipelineInfo.subpass = 0;
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-        pipelineInfo.renderPass = renderPass;
+        pipelineInfo.renderPass = GetCompatibleRenderPass(graphicsPipelineCreation);
 
         VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo = {VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO};
         if (graphicsPipelineCreation.depthFormat != Format::Undefined)
@@ -1073,21 +1666,84 @@ namespace Fyrion
             pipelineInfo.pDepthStencilState = &depthStencilStateCreateInfo;
         }
 
-        vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vulkanPipelineState->pipeline);
+        vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &vulkanPipelineState->pipeline);
 
         for (const auto shaderModule : shaderModules)
         {
             vkDestroyShaderModule(device, shaderModule, nullptr);
         }
 
-        vkDestroyRenderPass(device, renderPass, nullptr);
+        it->second.EmplaceBack(vulkanPipelineState);
 
         return {vulkanPipelineState};
     }
 
     PipelineState VulkanDevice::CreateComputePipelineState(const ComputePipelineCreation& computePipelineCreation)
     {
-        return {};
+        ResourceObject shader = Repository::Read(computePipelineCreation.shader);
+        if (!shader)
+        {
+            logger.Error("compute shader not found");
+            return {};
+        }
+
+        Span<u8>              bytes = shader[ShaderAsset::Bytes].As<Span<u8>>();
+        Span<ShaderStageInfo> stages = shader[ShaderAsset::Stages].As<Span<ShaderStageInfo>>();
+        ShaderInfo            shaderInfo = shader[ShaderAsset::Info].As<ShaderInfo>();
+
+        const ShaderStageInfo* computeStage = nullptr;
+        for (const ShaderStageInfo& stage : stages)
+        {
+            if (stage.stage == ShaderStage::Compute)
+            {
+                computeStage = &stage;
+                break;
+            }
+        }
+
+        if (computeStage == nullptr)
+        {
+            logger.Error("shader has no compute stage");
+            return {};
+        }
+
+        VkShaderModuleCreateInfo createInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+        createInfo.codeSize = computeStage->size;
+        createInfo.pCode = reinterpret_cast<const u32*>(bytes.Data() + computeStage->offset);
+
+        VkShaderModule shaderModule{};
+        VkResult moduleResult = vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule);
+        if (moduleResult != VK_SUCCESS)
+        {
+            logger.Error("error on create compute shader module {}", static_cast<i32>(moduleResult));
+            return {};
+        }
+
+        VulkanPipelineState* vulkanPipelineState = allocator.Alloc<VulkanPipelineState>();
+        vulkanPipelineState->computePipelineCreation = computePipelineCreation;
+        vulkanPipelineState->bindingPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+        vulkanPipelineState->references = 1;
+        vulkanPipelineState->bindless = Vulkan::CreatePipelineLayout(device, shaderInfo.descriptors, shaderInfo.pushConstants, &vulkanPipelineState->layout, bindlessDescriptorSetLayout);
+
+        VkComputePipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = shaderModule;
+        pipelineInfo.stage.pName = computeStage->entryPoint.CStr();
+        pipelineInfo.layout = vulkanPipelineState->layout;
+
+        VkResult result = vkCreateComputePipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &vulkanPipelineState->pipeline);
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+
+        if (result != VK_SUCCESS)
+        {
+            logger.Error("error on create compute pipeline {}", static_cast<i32>(result));
+            vkDestroyPipelineLayout(device, vulkanPipelineState->layout, nullptr);
+            allocator.DestroyAndFree(vulkanPipelineState);
+            return {};
+        }
+
+        return {vulkanPipelineState};
     }
 
     BindingSet& VulkanDevice::CreateBindingSet(RID shader, const BindingSetType& bindingSetType)
@@ -1112,46 +1768,164 @@ namespace Fyrion
 
     void VulkanDevice::DestroyBuffer(const Buffer& buffer)
     {
-        VulkanBuffer* vulkanBuffer = static_cast<VulkanBuffer*>(buffer.handler);
-        if (vulkanBuffer->buffer && vulkanBuffer->allocation)
+        //bindless indices have their own frame delay, they are freed right away.
+        VulkanBuffer* vulkanBuffer = buffers.Release(buffer.handler, frameCount);
+        if (!vulkanBuffer)
         {
-            vmaDestroyBuffer(vmaAllocator, vulkanBuffer->buffer, vulkanBuffer->allocation);
+            logger.Error("DestroyBuffer with destroyed buffer");
+            return;
         }
-        allocator.DestroyAndFree(vulkanBuffer);
+        bindlessBufferIndices.Free(vulkanBuffer->bindlessIndex);
     }
 
     void VulkanDevice::DestroyTexture(const Texture& texture)
     {
-        VulkanTexture* vulkanTexture = static_cast<VulkanTexture*>(texture.handler);
+        VulkanTexture* vulkanTexture = textures.Release(texture.handler, frameCount);
+        if (!vulkanTexture)
+        {
+            logger.Error("DestroyTexture with destroyed texture");
+            return;
+        }
 
         if (vulkanTexture->textureView.handler)
         {
             DestroyTextureView(vulkanTexture->textureView);
         }
+    }
 
-        if (vulkanTexture->allocation)
+    void VulkanDevice::DestroyTextureView(const TextureView& textureView)
+    {
+        VulkanTextureView* vulkanTextureView = textureViews.Release(textureView.handler, frameCount);
+        if (!vulkanTextureView)
         {
-            vmaDestroyImage(vmaAllocator, vulkanTexture->image, vulkanTexture->allocation);
-            vulkanTexture->allocation = nullptr;
+            logger.Error("DestroyTextureView with destroyed texture view");
+            return;
         }
-        allocator.DestroyAndFree(vulkanTexture);
+        bindlessTextureIndices.Free(vulkanTextureView->bindlessIndex);
     }
 
-    void VulkanDevice::DestroyTextureView(const TextureView& textureView)
+    void VulkanDevice::DestroySampler(const Sampler& sampler)
     {
-        VulkanTextureView* vulkanTextureView = static_cast<VulkanTextureView*>(textureView.handler);
-        vkDestroyImageView(device, vulkanTextureView->imageView, nullptr);
-        allocator.DestroyAndFree(vulkanTextureView);
+        VulkanSampler* vulkanSampler = samplers.Release(sampler.handler, frameCount);
+        if (!vulkanSampler)
+        {
+            logger.Error("DestroySampler with destroyed sampler");
+            return;
+        }
+        bindlessSamplerIndices.Free(vulkanSampler->bindlessIndex);
     }
 
-    void VulkanDevice::DestroySampler(const Sampler& sampler)
+    void VulkanDevice::CollectResources(u64 completedFrame)
     {
-        VulkanSampler* vulkanSampler = static_cast<VulkanSampler*>(sampler.handler);
-        vkDestroySampler(device, vulkanSampler->sampler, nullptr);
-        allocator.DestroyAndFree(vulkanSampler);
+        buffers.Collect(completedFrame, [&](VulkanBuffer& vulkanBuffer)
+        {
+            if (vulkanBuffer.buffer && vulkanBuffer.allocation)
+            {
+                vmaDestroyBuffer(vmaAllocator, vulkanBuffer.buffer, vulkanBuffer.allocation);
+            }
+        });
+
+        textureViews.Collect(completedFrame, [&](VulkanTextureView& vulkanTextureView)
+        {
+            vkDestroyImageView(device, vulkanTextureView.imageView, nullptr);
+        });
+
+        textures.Collect(completedFrame, [&](VulkanTexture& vulkanTexture)
+        {
+            if (vulkanTexture.allocation)
+            {
+                vmaDestroyImage(vmaAllocator, vulkanTexture.image, vulkanTexture.allocation);
+            }
+        });
+
+        samplers.Collect(completedFrame, [&](VulkanSampler& vulkanSampler)
+        {
+            vkDestroySampler(device, vulkanSampler.sampler, nullptr);
+        });
+
+        usize i = 0;
+        while (i < pendingDescriptorSets.Size())
+        {
+            if (pendingDescriptorSets[i].frame <= completedFrame)
+            {
+                vkFreeDescriptorSets(device, descriptorPool, 1, &pendingDescriptorSets[i].descriptorSet);
+                pendingDescriptorSets[i] = pendingDescriptorSets.Back();
+                pendingDescriptorSets.PopBack();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    VulkanBuffer* VulkanDevice::GetBuffer(const Buffer& buffer) const
+    {
+        VulkanBuffer* vulkanBuffer = buffers.Get(buffer.handler);
+        FY_ASSERT(vulkanBuffer, "buffer used after destroy");
+        return vulkanBuffer;
+    }
+
+    VulkanTexture* VulkanDevice::GetTexture(const Texture& texture) const
+    {
+        VulkanTexture* vulkanTexture = textures.Get(texture.handler);
+        FY_ASSERT(vulkanTexture, "texture used after destroy");
+        return vulkanTexture;
+    }
+
+    VulkanTextureView* VulkanDevice::GetTextureView(const TextureView& textureView) const
+    {
+        VulkanTextureView* vulkanTextureView = textureViews.Get(textureView.handler);
+        FY_ASSERT(vulkanTextureView, "texture view used after destroy");
+        return vulkanTextureView;
+    }
+
+    VulkanSampler* VulkanDevice::GetSampler(const Sampler& sampler) const
+    {
+        VulkanSampler* vulkanSampler = samplers.Get(sampler.handler);
+        FY_ASSERT(vulkanSampler, "sampler used after destroy");
+        return vulkanSampler;
+    }
+
+    void VulkanDevice::DestroyGraphicsPipelineState(const PipelineState& pipelineState)
+    {
+        std::unique_lock lock(pipelineMutex);
+
+        VulkanPipelineState* vulkanPipelineState = static_cast<VulkanPipelineState*>(pipelineState.handler);
+        if (--vulkanPipelineState->references > 0)
+        {
+            return;
+        }
+
+        if (auto it = graphicsPipelines.Find(vulkanPipelineState->hash))
+        {
+            Array<VulkanPipelineState*>& pipelineStates = it->second;
+            for (usize i = 0; i < pipelineStates.Size(); ++i)
+            {
+                if (pipelineStates[i] == vulkanPipelineState)
+                {
+                    pipelineStates.Erase(pipelineStates.begin() + i);
+                    break;
+                }
+            }
+            if (pipelineStates.Empty())
+            {
+                graphicsPipelines.Erase(it);
+            }
+        }
+
+        if (vulkanPipelineState->pipeline)
+        {
+            vkDestroyPipeline(device, vulkanPipelineState->pipeline, nullptr);
+        }
+        if (vulkanPipelineState->layout)
+        {
+            vkDestroyPipelineLayout(device, vulkanPipelineState->layout, nullptr);
+        }
+        allocator.DestroyAndFree(vulkanPipelineState);
     }
 
-    void VulkanDevice::DestroyGraphicsPipelineState(const PipelineState& pipelineState)
+    void VulkanDevice::DestroyComputePipelineState(const PipelineState& pipelineState)
     {
         VulkanPipelineState* vulkanPipelineState = static_cast<VulkanPipelineState*>(pipelineState.handler);
         if (vulkanPipelineState->pipeline)
@@ -1165,10 +1939,6 @@ namespace Fyrion
         allocator.DestroyAndFree(vulkanPipelineState);
     }
 
-    void VulkanDevice::DestroyComputePipelineState(const PipelineState& pipelineState)
-    {
-    }
-
     void VulkanDevice::DestroyBindingSet(BindingSet& bindingSet)
     {
         allocator.DestroyAndFree(static_cast<VulkanBindingSet*>(&bindingSet));
@@ -1178,7 +1948,7 @@ namespace Fyrion
     {
         VulkanSwapchain* vulkanSwapchain = static_cast<VulkanSwapchain*>(swapchain.handler);
         Extent           extent = Platform::GetWindowExtent(vulkanSwapchain->window);
-        if (extent.width != vulkanSwapchain->extent.width || extent.height != vulkanSwapchain->extent.height)
+        if (vulkanSwapchain->recreate || extent.width != vulkanSwapchain->extent.width || extent.height != vulkanSwapchain->extent.height)
         {
             while (extent.width == 0 || extent.height == 0)
             {
@@ -1207,8 +1977,35 @@ namespace Fyrion
 
     RenderCommands& VulkanDevice::BeginFrame()
     {
-        vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+        WaitFrame();
+        frameReady = false;
+
+        //frames up to the one that used this slot are completed, frameCount is the number of frames started.
+        if (frameCount + 1 >= framesInFlight)
+        {
+            CollectResources(frameCount + 1 - framesInFlight);
+        }
+
         vkResetFences(device, 1, &inFlightFences[currentFrame]);
+        stagingInUse[currentFrame] = false;
+
+        bindlessTextureIndices.NextFrame();
+        bindlessSamplerIndices.NextFrame();
+        bindlessBufferIndices.NextFrame();
+
+        for (VkDescriptorPool pool : frameDescriptorPools[currentFrame])
+        {
+            vkResetDescriptorPool(device, pool, 0);
+        }
+        frameDescriptorPoolIndex[currentFrame] = 0;
+        frameDescriptorSets[currentFrame].Clear();
+
+        lastDescriptorStats = descriptorStats;
+        descriptorStats = {};
+
+        ResolveTimestamps(*defaultCommands[currentFrame]);
+        defaultCommands[currentFrame]->timestampFrame = frameCount;
+        frameCount++;
 
         return *defaultCommands[currentFrame];
     }
@@ -1217,17 +2014,45 @@ namespace Fyrion
     {
         VulkanSwapchain* vulkanSwapchain = static_cast<VulkanSwapchain*>(swapchain.handler);
 
-        VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+        RetireAsyncUploads();
+
+        VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+        VkSemaphore          waitSemaphores[] = {vulkanSwapchain->imageAvailableSemaphores[currentFrame], transferSemaphore};
+        uint64_t             waitValues[] = {0, 0};
+
+        //binary semaphore values are ignored.
+        VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+        timelineInfo.waitSemaphoreValueCount = 2;
+        timelineInfo.pWaitSemaphoreValues = waitValues;
+
+        //uploads are executed before the frame commands in the same submit.
+        FixedArray<VkCommandBuffer, 2> commandBuffers{};
+        u32 commandBufferCount = 0;
+        if (uploadRecording)
+        {
+            EndUploads();
+            stagingInUse[currentFrame] = true;
+            commandBuffers[commandBufferCount++] = uploadCommands[currentFrame]->commandBuffer;
+        }
+        commandBuffers[commandBufferCount++] = defaultCommands[currentFrame]->commandBuffer;
 
         VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
         submitInfo.waitSemaphoreCount = 1;
-        submitInfo.pWaitSemaphores = &vulkanSwapchain->imageAvailableSemaphores[currentFrame];
+        submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores = &renderFinishedSemaphores[currentFrame];
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &defaultCommands[currentFrame]->commandBuffer;
+        submitInfo.commandBufferCount = commandBufferCount;
+        submitInfo.pCommandBuffers = commandBuffers.Data();
         submitInfo.pWaitDstStageMask = waitStages;
 
+        if (TakeTransferWaitValue(waitValues[1]))
+        {
+            submitInfo.pNext = &timelineInfo;
+            submitInfo.waitSemaphoreCount = 2;
+        }
+
+        std::unique_lock queueLock = LockSharedQueue();
+
         if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
         {
             FY_ASSERT(false, "failed to execute vkQueueSubmit");
@@ -1246,12 +2071,478 @@ namespace Fyrion
             FY_ASSERT(false, "failed to execute vkQueuePresentKHR");
         }
 
-        currentFrame = (currentFrame + 1) % FY_FRAMES_IN_FLIGHT;
+        currentFrame = (currentFrame + 1) % framesInFlight;
+    }
+
+    void VulkanDevice::WaitFrame()
+    {
+        if (!frameReady)
+        {
+            vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+            frameReady = true;
+        }
+    }
+
+    void VulkanDevice::SetFramesInFlight(u32 framesInFlight)
+    {
+        framesInFlight = Math::Clamp(framesInFlight, 1u, static_cast<u32>(FY_FRAMES_IN_FLIGHT));
+        if (framesInFlight == this->framesInFlight)
+        {
+            return;
+        }
+
+        //all frame fences are signaled once the queue is idle, the next frame can start on any slot.
+        WaitQueue();
+        this->framesInFlight = framesInFlight;
+        currentFrame = 0;
+        frameReady = false;
+    }
+
+    u32 VulkanDevice::GetFramesInFlight()
+    {
+        return framesInFlight;
+    }
+
+    void VulkanDevice::SetPresentMode(Swapchain swapchain, PresentMode presentMode)
+    {
+        VulkanSwapchain* vulkanSwapchain = static_cast<VulkanSwapchain*>(swapchain.handler);
+        if (vulkanSwapchain->presentMode != presentMode)
+        {
+            vulkanSwapchain->presentMode = presentMode;
+            vulkanSwapchain->recreate = true;
+        }
+    }
+
+    PresentMode VulkanDevice::GetPresentMode(Swapchain swapchain)
+    {
+        return static_cast<VulkanSwapchain*>(swapchain.handler)->activePresentMode;
     }
 
     void VulkanDevice::WaitQueue()
     {
+        FlushUploads();
+        {
+            std::unique_lock queueLock = LockSharedQueue();
+            vkQueueWaitIdle(graphicsQueue);
+        }
+        CollectResources(U64_MAX);
+    }
+
+    bool VulkanDevice::StageUpload(const BufferDataInfo& bufferDataInfo)
+    {
+        if (bufferDataInfo.size > StagingFrameSize)
+        {
+            return false;
+        }
+
+        //offsets are kept 16 bytes aligned, enough for any copy on any device.
+        usize size = (bufferDataInfo.size + 15) & ~static_cast<usize>(15);
+        if (stagingOffset + size > StagingFrameSize)
+        {
+            FlushUploads();
+            uploadStats.stalls++;
+        }
+
+        BeginUploads();
+
+        usize srcOffset = currentFrame * StagingFrameSize + stagingOffset;
+        memcpy(static_cast<u8*>(stagingBuffer.allocInfo.pMappedData) + srcOffset, bufferDataInfo.data, bufferDataInfo.size);
+
+        BufferCopyInfo copy{};
+        copy.srcOffset = srcOffset;
+        copy.dstOffset = bufferDataInfo.offset;
+        copy.size = bufferDataInfo.size;
+        vkCmdCopyBuffer(uploadCommands[currentFrame]->commandBuffer, stagingBuffer.buffer, GetBuffer(bufferDataInfo.buffer)->buffer, 1, reinterpret_cast<const VkBufferCopy*>(&copy));
+
+        stagingOffset += size;
+        return true;
+    }
+
+    void VulkanDevice::BeginUploads()
+    {
+        if (uploadRecording)
+        {
+            return;
+        }
+
+        //the frame's staging memory is only reused after its previous submit is retired.
+        if (stagingInUse[currentFrame])
+        {
+            vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+            stagingInUse[currentFrame] = false;
+        }
+        stagingOffset = 0;
+        uploadCommands[currentFrame]->Begin();
+        uploadRecording = true;
+    }
+
+    void VulkanDevice::EndUploads()
+    {
+        //copies are visible to any command recorded after them.
+        VkMemoryBarrier memoryBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        vkCmdPipelineBarrier(uploadCommands[currentFrame]->commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+        uploadCommands[currentFrame]->End();
+        uploadRecording = false;
+    }
+
+    void VulkanDevice::FlushUploads()
+    {
+        RetireAsyncUploads();
+
+        if (!uploadRecording)
+        {
+            return;
+        }
+
+        EndUploads();
+
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        uint64_t waitValue = 0;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+        timelineInfo.waitSemaphoreValueCount = 1;
+        timelineInfo.pWaitSemaphoreValues = &waitValue;
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &uploadCommands[currentFrame]->commandBuffer;
+
+        //acquires of async uploads recorded on these commands wait the transfer release.
+        if (TakeTransferWaitValue(waitValue))
+        {
+            submitInfo.pNext = &timelineInfo;
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &transferSemaphore;
+            submitInfo.pWaitDstStageMask = &waitStage;
+        }
+
+        std::unique_lock queueLock = LockSharedQueue();
+        vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
         vkQueueWaitIdle(graphicsQueue);
+        stagingOffset = 0;
+    }
+
+    UploadToken VulkanDevice::UploadAsync(const BufferDataInfo& bufferDataInfo)
+    {
+        FY_ASSERT(bufferDataInfo.data, "data cannot be null");
+        FY_ASSERT(bufferDataInfo.size > 0, "size should be higher then zero");
+
+        VulkanBuffer& vulkanBuffer = *GetBuffer(bufferDataInfo.buffer);
+        if (vulkanBuffer.bufferCreation.allocation != BufferAllocation::GPUOnly)
+        {
+            UpdateBufferData(bufferDataInfo);
+            return {};
+        }
+
+        std::unique_lock lock(transferMutex);
+
+        VulkanAsyncUpload upload{};
+        upload.buffer = vulkanBuffer.buffer;
+        upload.offset = bufferDataInfo.offset;
+        upload.size = bufferDataInfo.size;
+        upload.value = ++transferValue;
+        upload.stagingBuffer = AcquireTransferStagingBuffer(bufferDataInfo.size);
+
+        memcpy(upload.stagingBuffer.allocInfo.pMappedData, bufferDataInfo.data, bufferDataInfo.size);
+
+        if (!freeTransferCommandBuffers.Empty())
+        {
+            upload.commandBuffer = freeTransferCommandBuffers.Back();
+            freeTransferCommandBuffers.PopBack();
+        }
+        else
+        {
+            VkCommandBufferAllocateInfo allocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = transferCommandPool;
+            allocInfo.commandBufferCount = 1;
+            vkAllocateCommandBuffers(device, &allocInfo, &upload.commandBuffer);
+        }
+
+        VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(upload.commandBuffer, &beginInfo);
+
+        VkBufferCopy copy{};
+        copy.srcOffset = 0;
+        copy.dstOffset = bufferDataInfo.offset;
+        copy.size = bufferDataInfo.size;
+        vkCmdCopyBuffer(upload.commandBuffer, upload.stagingBuffer.buffer, upload.buffer, 1, &copy);
+
+        if (transferFamily != graphicsFamily)
+        {
+            VkBufferMemoryBarrier release{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            release.dstAccessMask = 0;
+            release.srcQueueFamilyIndex = transferFamily;
+            release.dstQueueFamilyIndex = graphicsFamily;
+            release.buffer = upload.buffer;
+            release.offset = upload.offset;
+            release.size = upload.size;
+            vkCmdPipelineBarrier(upload.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &release, 0, nullptr);
+        }
+
+        vkEndCommandBuffer(upload.commandBuffer);
+
+        uint64_t signalValue = upload.value;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &upload.commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &transferSemaphore;
+
+        {
+            std::unique_lock queueLock = LockSharedQueue();
+            if (vkQueueSubmit(transferQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+            {
+                FY_ASSERT(false, "failed to execute vkQueueSubmit");
+            }
+        }
+
+        asyncUploads.EmplaceBack(upload);
+
+        uploadStats.uploads++;
+        uploadStats.bytesUploaded += bufferDataInfo.size;
+        uploadWindowBytes += bufferDataInfo.size;
+
+        return {upload.value};
+    }
+
+    //best fit between the free staging buffers, new ones are rounded up to reuse them for close sizes.
+    VulkanBuffer VulkanDevice::AcquireTransferStagingBuffer(usize size)
+    {
+        usize best = nPos;
+        for (usize i = 0; i < freeTransferStagingBuffers.Size(); ++i)
+        {
+            usize bufferSize = freeTransferStagingBuffers[i].bufferCreation.size;
+            if (bufferSize >= size && (best == nPos || bufferSize < freeTransferStagingBuffers[best].bufferCreation.size))
+            {
+                best = i;
+            }
+        }
+
+        if (best != nPos)
+        {
+            VulkanBuffer stagingBuffer = freeTransferStagingBuffers[best];
+            freeTransferStagingSize -= stagingBuffer.bufferCreation.size;
+            freeTransferStagingBuffers.Erase(freeTransferStagingBuffers.begin() + best);
+            return stagingBuffer;
+        }
+
+        VulkanBuffer stagingBuffer{};
+        stagingBuffer.bufferCreation.size = (size + TransferStagingBlockSize - 1) / TransferStagingBlockSize * TransferStagingBlockSize;
+        stagingBuffer.bufferCreation.allocation = BufferAllocation::TransferToGPU;
+
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size = stagingBuffer.bufferCreation.size;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo vmaAllocInfo = {};
+        vmaAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        vmaCreateBuffer(vmaAllocator, &bufferInfo, &vmaAllocInfo, &stagingBuffer.buffer, &stagingBuffer.allocation, &stagingBuffer.allocInfo);
+
+        return stagingBuffer;
+    }
+
+    void VulkanDevice::ReleaseTransferStagingBuffer(const VulkanBuffer& stagingBuffer)
+    {
+        if (freeTransferStagingSize + stagingBuffer.bufferCreation.size > TransferStagingMaxFreeSize)
+        {
+            vmaDestroyBuffer(vmaAllocator, stagingBuffer.buffer, stagingBuffer.allocation);
+            return;
+        }
+        freeTransferStagingSize += stagingBuffer.bufferCreation.size;
+        freeTransferStagingBuffers.EmplaceBack(stagingBuffer);
+    }
+
+    //finished uploads are acquired on the upload commands, the next graphics submit waits their release.
+    //records on the frame's upload commands, only called on the render thread.
+    void VulkanDevice::RetireAsyncUploads()
+    {
+        std::unique_lock lock(transferMutex);
+
+        if (asyncUploads.Empty())
+        {
+            return;
+        }
+
+        uint64_t value = 0;
+        vkGetSemaphoreCounterValue(device, transferSemaphore, &value);
+
+        usize retired = 0;
+        for (VulkanAsyncUpload& upload : asyncUploads)
+        {
+            if (upload.value > value)
+            {
+                break;
+            }
+
+            if (transferFamily != graphicsFamily)
+            {
+                BeginUploads();
+
+                VkBufferMemoryBarrier acquire{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+                acquire.srcAccessMask = 0;
+                acquire.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+                acquire.srcQueueFamilyIndex = transferFamily;
+                acquire.dstQueueFamilyIndex = graphicsFamily;
+                acquire.buffer = upload.buffer;
+                acquire.offset = upload.offset;
+                acquire.size = upload.size;
+                vkCmdPipelineBarrier(uploadCommands[currentFrame]->commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &acquire, 0, nullptr);
+            }
+
+            ReleaseTransferStagingBuffer(upload.stagingBuffer);
+            freeTransferCommandBuffers.EmplaceBack(upload.commandBuffer);
+
+            transferWaitValue = upload.value;
+            retired++;
+        }
+
+        if (retired > 0)
+        {
+            asyncUploads.Erase(asyncUploads.begin(), asyncUploads.begin() + retired);
+        }
+    }
+
+    //the value of the last upload acquired on the graphics queue, false if no new one needs to be waited.
+    bool VulkanDevice::TakeTransferWaitValue(uint64_t& waitValue)
+    {
+        std::unique_lock lock(transferMutex);
+        if (transferWaitValue <= transferWaitedValue)
+        {
+            return false;
+        }
+        waitValue = transferWaitValue;
+        transferWaitedValue = transferWaitValue;
+        return true;
+    }
+
+    //submits and waits on a queue used by async uploads are serialized with the loader threads.
+    std::unique_lock<std::mutex> VulkanDevice::LockSharedQueue()
+    {
+        if (transferQueueShared)
+        {
+            return std::unique_lock(queueMutex);
+        }
+        return {};
+    }
+
+    //uploads submitted before the frame's end are acquired by it, so completion of the transfer is enough.
+    bool VulkanDevice::IsUploadComplete(UploadToken uploadToken)
+    {
+        uint64_t value = 0;
+        vkGetSemaphoreCounterValue(device, transferSemaphore, &value);
+        return uploadToken.value <= value;
+    }
+
+    //only waits the transfer semaphore, the ownership is acquired by the render thread on the next frame.
+    void VulkanDevice::WaitUpload(UploadToken uploadToken)
+    {
+        uint64_t value = uploadToken.value;
+
+        VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &transferSemaphore;
+        waitInfo.pValues = &value;
+        vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+    }
+
+    DeviceFeatures VulkanDevice::GetFeatures()
+    {
+        return deviceFeatures;
+    }
+
+    DescriptorStats VulkanDevice::GetDescriptorStats()
+    {
+        return lastDescriptorStats;
+    }
+
+    void VulkanDevice::ResolveTimestamps(VulkanCommands& commands)
+    {
+        if (!commands.timestampPool || commands.timestampFrame == U64_MAX || commands.timestampCount == 0)
+        {
+            return;
+        }
+
+        //the frame fence was waited, all queries of the frame are available.
+        timestampResults.Resize(commands.timestampCount);
+        VkResult result = vkGetQueryPoolResults(device, commands.timestampPool, 0, commands.timestampCount, timestampResults.Size() * sizeof(u64),
+                                                timestampResults.Data(), sizeof(u64), VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS)
+        {
+            return;
+        }
+
+        f64 period = vulkanDeviceProperties.limits.timestampPeriod * 1e-9;
+        u64 frameBegin = timestampResults[commands.timestampScopes[0].beginQuery];
+
+        gpuFrameTimings.frame = commands.timestampFrame;
+        gpuFrameTimings.scopes.Clear();
+
+        for (const VulkanTimestampScope& scope : commands.timestampScopes)
+        {
+            u64 begin = Math::Max(timestampResults[scope.beginQuery], frameBegin);
+            u64 end = Math::Max(timestampResults[scope.beginQuery + 1], begin);
+
+            gpuFrameTimings.scopes.EmplaceBack(ProfileScope{
+                .name = scope.name,
+                .depth = scope.depth,
+                .begin = static_cast<f64>(begin - frameBegin) * period,
+                .end = static_cast<f64>(end - frameBegin) * period
+            });
+        }
+    }
+
+    const GPUFrameTimings& VulkanDevice::GetGPUFrameTimings()
+    {
+        return gpuFrameTimings;
+    }
+
+    ResourceStats VulkanDevice::GetResourceStats()
+    {
+        return ResourceStats{
+            .buffers = buffers.GetStats(),
+            .textures = textures.GetStats(),
+            .textureViews = textureViews.GetStats(),
+            .samplers = samplers.GetStats()
+        };
+    }
+
+    u32 VulkanDevice::GetBindlessIndex(const Texture& texture)
+    {
+        return GetBindlessIndex(GetTexture(texture)->textureView);
+    }
+
+    u32 VulkanDevice::GetBindlessIndex(const TextureView& textureView)
+    {
+        return GetTextureView(textureView)->bindlessIndex;
+    }
+
+    u32 VulkanDevice::GetBindlessIndex(const Sampler& sampler)
+    {
+        return GetSampler(sampler)->bindlessIndex;
+    }
+
+    u32 VulkanDevice::GetBindlessIndex(const Buffer& buffer)
+    {
+        return GetBuffer(buffer)->bindlessIndex;
     }
 
     void VulkanDevice::UpdateBufferData(const BufferDataInfo& bufferDataInfo)
@@ -1259,17 +2550,28 @@ namespace Fyrion
         FY_ASSERT(bufferDataInfo.data, "data cannot be null");
         FY_ASSERT(bufferDataInfo.size > 0, "size should be higher then zero");
 
-        VulkanBuffer& vulkanBuffer = *static_cast<VulkanBuffer*>(bufferDataInfo.buffer.handler);
+        VulkanBuffer& vulkanBuffer = *GetBuffer(bufferDataInfo.buffer);
         if (vulkanBuffer.bufferCreation.allocation != BufferAllocation::GPUOnly)
         {
             if (bufferDataInfo.data)
             {
                 memcpy((i8*)vulkanBuffer.allocInfo.pMappedData + bufferDataInfo.offset, bufferDataInfo.data, bufferDataInfo.size);
             }
+            return;
         }
-        else
+
+        uploadStats.uploads++;
+        uploadStats.bytesUploaded += bufferDataInfo.size;
+        uploadWindowBytes += bufferDataInfo.size;
+
+        if (!StageUpload(bufferDataInfo))
         {
-            VulkanBuffer stagingBuffer = {};
+            //oversize uploads get their own staging buffer, pending uploads go first to keep the order.
+            FlushUploads();
+            uploadStats.oversizeUploads++;
+            uploadStats.stalls++;
+
+            VulkanBuffer oversizeBuffer = {};
 
             VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
             bufferInfo.size = bufferDataInfo.size;
@@ -1279,22 +2581,38 @@ namespace Fyrion
             VmaAllocationCreateInfo vmaAllocInfo = {};
             vmaAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
             vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
-            vmaCreateBuffer(vmaAllocator, &bufferInfo, &vmaAllocInfo, &stagingBuffer.buffer, &stagingBuffer.allocation, &stagingBuffer.allocInfo);
+            vmaCreateBuffer(vmaAllocator, &bufferInfo, &vmaAllocInfo, &oversizeBuffer.buffer, &oversizeBuffer.allocation, &oversizeBuffer.allocInfo);
 
-            memcpy(stagingBuffer.allocInfo.pMappedData, bufferDataInfo.data, bufferDataInfo.size);
+            memcpy(oversizeBuffer.allocInfo.pMappedData, bufferDataInfo.data, bufferDataInfo.size);
 
             temporaryCmd->Begin();
 
             BufferCopyInfo copy{};
-            copy.dstOffset = 0;
-            copy.srcOffset = bufferDataInfo.offset;
+            copy.srcOffset = 0;
+            copy.dstOffset = bufferDataInfo.offset;
             copy.size = bufferDataInfo.size;
 
-            temporaryCmd->CopyBuffer({&stagingBuffer}, bufferDataInfo.buffer, &copy);
-            temporaryCmd->SubmitAndWait({graphicsQueue});
+            vkCmdCopyBuffer(temporaryCmd->commandBuffer, oversizeBuffer.buffer, GetBuffer(bufferDataInfo.buffer)->buffer, 1, reinterpret_cast<const VkBufferCopy*>(&copy));
+            {
+                std::unique_lock queueLock = LockSharedQueue();
+                temporaryCmd->SubmitAndWait({graphicsQueue});
+            }
 
-            vmaDestroyBuffer(vmaAllocator, stagingBuffer.buffer, stagingBuffer.allocation);
+            vmaDestroyBuffer(vmaAllocator, oversizeBuffer.buffer, oversizeBuffer.allocation);
+        }
+    }
+
+    UploadStats VulkanDevice::GetUploadStats()
+    {
+        f64 now = Platform::GetTime();
+        f64 elapsed = now - uploadWindowStart;
+        if (elapsed >= 1.0)
+        {
+            uploadStats.bytesPerSecond = static_cast<f64>(uploadWindowBytes) / elapsed;
+            uploadWindowBytes = 0;
+            uploadWindowStart = now;
         }
+        return uploadStats;
     }
 
 
@@ -1322,7 +2640,7 @@ namespace Fyrion
         Info.Device = device;
         Info.QueueFamily = graphicsFamily;
         Info.Queue = graphicsQueue;
-        Info.PipelineCache = VK_NULL_HANDLE;
+        Info.PipelineCache = pipelineCache;
         Info.DescriptorPool = descriptorPool;
         Info.UseDynamicRendering = false;
         Info.Subpass = 0;
@@ -8,7 +8,12 @@
 #include "volk.h"
 #include "vk_mem_alloc.h"
 #include "Fyrion/Core/FixedArray.hpp"
+#include "Fyrion/Core/HashMap.hpp"
 #include "VulkanTypes.hpp"
+#include "Fyrion/Graphics/Device/BindlessIndexAllocator.hpp"
+#include "Fyrion/Graphics/Device/ResourcePool.hpp"
+
+#include <mutex>
 
 namespace Fyrion
 {
@@ -45,13 +50,84 @@ namespace Fyrion
 
         VkQueue graphicsQueue{};
         VkQueue presentQueue{};
+
+        //async uploads, a transfer only family is preferred. ownership is released on the transfer queue
+        //and acquired on the graphics queue, which waits the transfer timeline semaphore.
+        //staging buffers and command buffers of retired uploads are kept for the next ones.
+        //single queue devices submit the uploads on the graphics queue, queueMutex serializes them.
+        u32                      transferFamily{U32_MAX};
+        u32                      transferQueueIndex{};
+        VkQueue                  transferQueue{};
+        bool                     transferQueueShared{};
+        std::mutex               queueMutex{};
+        VkCommandPool            transferCommandPool{};
+        VkSemaphore              transferSemaphore{};
+        std::mutex               transferMutex{};
+        u64                      transferValue{};
+        u64                      transferWaitValue{};
+        u64                      transferWaitedValue{};
+        Array<VulkanAsyncUpload> asyncUploads{};
+        Array<VulkanBuffer>      freeTransferStagingBuffers{};
+        usize                    freeTransferStagingSize{};
+        Array<VkCommandBuffer>   freeTransferCommandBuffers{};
         SharedPtr<VulkanCommands> temporaryCmd;
 
         FixedArray<VkFence, FY_FRAMES_IN_FLIGHT>                   inFlightFences{};
         FixedArray<VkSemaphore, FY_FRAMES_IN_FLIGHT>               renderFinishedSemaphores{};
         FixedArray<SharedPtr<VulkanCommands>, FY_FRAMES_IN_FLIGHT> defaultCommands{};
 
-        u32 currentFrame = 0;
+        u32  currentFrame = 0;
+        u64  frameCount = 0;
+        u32  framesInFlight = FY_DEFAULT_FRAMES_IN_FLIGHT;
+        bool frameReady = false;
+
+        //binding set descriptors, dynamic sets are allocated from the frame pools which are reset when the frame starts.
+        //static sets freed by binding sets go back to the pool once the frames that can use them are completed.
+        HashMap<usize, Array<VulkanDescriptorSetLayout>>                                  descriptorSetLayouts{};
+        FixedArray<Array<VkDescriptorPool>, FY_FRAMES_IN_FLIGHT>                          frameDescriptorPools{};
+        FixedArray<u32, FY_FRAMES_IN_FLIGHT>                                              frameDescriptorPoolIndex{};
+        FixedArray<HashMap<usize, Array<VulkanCachedDescriptorSet>>, FY_FRAMES_IN_FLIGHT> frameDescriptorSets{};
+        Array<VulkanPendingDescriptorSet>                                                 pendingDescriptorSets{};
+        DescriptorStats                                                                   descriptorStats{};
+        DescriptorStats                                                                   lastDescriptorStats{};
+
+        GPUFrameTimings gpuFrameTimings{};
+        Array<u64>      timestampResults{};
+
+        //uploads to GPUOnly buffers are sub-allocated from the frame's part of a persistently mapped staging buffer,
+        //recorded on the frame's upload commands and submitted with the frame.
+        VulkanBuffer                                               stagingBuffer{};
+        usize                                                      stagingOffset{};
+        FixedArray<bool, FY_FRAMES_IN_FLIGHT>                      stagingInUse{};
+        FixedArray<SharedPtr<VulkanCommands>, FY_FRAMES_IN_FLIGHT> uploadCommands{};
+        bool                                                       uploadRecording{};
+        UploadStats                                                uploadStats{};
+        f64                                                        uploadWindowStart{};
+        u64                                                        uploadWindowBytes{};
+
+        //pipeline cache is loaded from disk on device creation and saved on destruction.
+        //identical pipeline creations share the same pipeline state, entries with the same hash are compared by their creation.
+        //pipelines can be created and destroyed from any thread.
+        VkPipelineCache                                 pipelineCache{};
+        String                                          pipelineCachePath{};
+        std::mutex                                      pipelineMutex{};
+        HashMap<usize, Array<VulkanPipelineState*>>     graphicsPipelines{};
+        HashMap<usize, Array<VulkanCompatibleRenderPass>> compatibleRenderPasses{};
+
+        //bindless heap, a single update-after-bind set with all sampled images, samplers and storage buffers.
+        //descriptors are written on creation and the slot is kept until the resource is destroyed.
+        VkDescriptorPool       bindlessDescriptorPool{};
+        VkDescriptorSetLayout  bindlessDescriptorSetLayout{};
+        VkDescriptorSet        bindlessDescriptorSet{};
+        BindlessIndexAllocator bindlessTextureIndices{};
+        BindlessIndexAllocator bindlessSamplerIndices{};
+        BindlessIndexAllocator bindlessBufferIndices{};
+
+        //destroyed resources are released from the pools and destroyed once the frames that can use them are completed.
+        ResourcePool<VulkanBuffer>      buffers{};
+        ResourcePool<VulkanTexture>     textures{};
+        ResourcePool<VulkanTextureView> textureViews{};
+        ResourcePool<VulkanSampler>     samplers{};
 
         VulkanDevice();
         ~VulkanDevice() override;
@@ -78,14 +154,61 @@ namespace Fyrion
         void            DestroyBindingSet(BindingSet& bindingSet) override;
         RenderCommands& BeginFrame() override;
         RenderPass      AcquireNextRenderPass(Swapchain swapchain) override;
+        void            SetPresentMode(Swapchain swapchain, PresentMode presentMode) override;
+        PresentMode     GetPresentMode(Swapchain swapchain) override;
+        void            SetFramesInFlight(u32 framesInFlight) override;
+        u32             GetFramesInFlight() override;
+        void            WaitFrame() override;
         void            EndFrame(Swapchain swapchain) override;
         void            WaitQueue() override;
         void            UpdateBufferData(const BufferDataInfo& bufferDataInfo) override;
+        UploadStats     GetUploadStats() override;
+        UploadToken     UploadAsync(const BufferDataInfo& bufferDataInfo) override;
+        bool            IsUploadComplete(UploadToken uploadToken) override;
+        void            WaitUpload(UploadToken uploadToken) override;
+        DeviceFeatures  GetFeatures() override;
+        DescriptorStats GetDescriptorStats() override;
+        const GPUFrameTimings& GetGPUFrameTimings() override;
+        ResourceStats   GetResourceStats() override;
+        u32             GetBindlessIndex(const Texture& texture) override;
+        u32             GetBindlessIndex(const TextureView& textureView) override;
+        u32             GetBindlessIndex(const Sampler& sampler) override;
+        u32             GetBindlessIndex(const Buffer& buffer) override;
 
 
         bool CreateSwapchain(VulkanSwapchain* vulkanSwapchain);
         void DestroySwapchain(VulkanSwapchain* vulkanSwapchain);
 
+        bool         StageUpload(const BufferDataInfo& bufferDataInfo);
+        void         BeginUploads();
+        void         FlushUploads();
+        void         EndUploads();
+        void         RetireAsyncUploads();
+        bool         TakeTransferWaitValue(uint64_t& waitValue);
+        VulkanBuffer AcquireTransferStagingBuffer(usize size);
+        void         ReleaseTransferStagingBuffer(const VulkanBuffer& stagingBuffer);
+        void         ResolveTimestamps(VulkanCommands& commands);
+
+        std::unique_lock<std::mutex> LockSharedQueue();
+
+        void         CreateBindlessHeap();
+
+        VulkanBuffer*      GetBuffer(const Buffer& buffer) const;
+        VulkanTexture*     GetTexture(const Texture& texture) const;
+        VulkanTextureView* GetTextureView(const TextureView& textureView) const;
+        VulkanSampler*     GetSampler(const Sampler& sampler) const;
+        void               CollectResources(u64 completedFrame);
+
+        VkDescriptorSetLayout GetDescriptorSetLayout(const DescriptorLayout& descriptorLayout);
+        VkDescriptorSet       AllocateDescriptorSet(VkDescriptorSetLayout layout, BindingSetType bindingSetType);
+        void                  FreeDescriptorSet(VkDescriptorSet descriptorSet);
+        VkDescriptorPool      CreateFrameDescriptorPool();
+        void         WriteBindlessDescriptor(u32 binding, u32 index, VkDescriptorType descriptorType, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo);
+
+        void         LoadPipelineCache();
+        void         SavePipelineCache();
+        VkRenderPass GetCompatibleRenderPass(const GraphicsPipelineCreation& graphicsPipelineCreation);
+
         void    ImGuiInit(Swapchain renderSwapchain) override;
         void    ImGuiNewFrame() override;
         void    ImGuiRender(RenderCommands& renderCommands) override;
@@ -10,7 +10,10 @@
 namespace Fyrion
 {
 
-    static const u32 MaxBindlessResources = 16536;
+    static const usize StagingFrameSize = 8 * 1024 * 1024;
+    static const usize TransferStagingBlockSize = 64 * 1024;
+    static const usize TransferStagingMaxFreeSize = 64 * 1024 * 1024;
+    static const usize MaxCachedDescriptorSets = 8;
 
     struct VulkanSwapChainSupportDetails
     {
@@ -37,7 +40,9 @@ namespace Fyrion
     struct VulkanSwapchain
     {
         Window                  window{};
-        bool                    vsync{};
+        PresentMode             presentMode{};
+        PresentMode             activePresentMode{};
+        bool                    recreate{};
         VkSurfaceKHR            surfaceKHR{};
         VkSwapchainKHR          swapchainKHR{};
         VkExtent2D              extent{};
@@ -56,12 +61,24 @@ namespace Fyrion
         VkBuffer          buffer{};
         VmaAllocation     allocation{};
         VmaAllocationInfo allocInfo{};
+        u32               bindlessIndex{U32_MAX};
+    };
+
+    struct VulkanAsyncUpload
+    {
+        u64             value{};
+        VulkanBuffer    stagingBuffer{};
+        VkCommandBuffer commandBuffer{};
+        VkBuffer        buffer{};
+        usize           offset{};
+        usize           size{};
     };
 
     struct VulkanTextureView
     {
         Texture     texture{};
         VkImageView imageView{};
+        u32         bindlessIndex{U32_MAX};
     };
 
     struct VulkanTexture
@@ -75,15 +92,56 @@ namespace Fyrion
     struct VulkanSampler
     {
         VkSampler sampler{};
+        u32       bindlessIndex{U32_MAX};
     };
 
     struct VulkanPipelineState
     {
         GraphicsPipelineCreation graphicsPipelineCreation{};
         ComputePipelineCreation  computePipelineCreation{};
+        Array<Format>            attachments{};
+        u32                      shaderVersion{};
         VkPipelineBindPoint      bindingPoint{};
         VkPipeline               pipeline{};
         VkPipelineLayout         layout{};
         VkPipelineCache          cache{};
+        usize                    hash{};
+        u32                      references{};
+        bool                     bindless{};
+    };
+
+    struct VulkanCompatibleRenderPass
+    {
+        Array<Format> attachments{};
+        Format        depthFormat{};
+        VkRenderPass  renderPass{};
+    };
+
+    struct VulkanDescriptorSetLayout
+    {
+        Array<DescriptorBinding> bindings{};
+        VkDescriptorSetLayout    layout{};
+    };
+
+    struct VulkanDescriptorSetValue
+    {
+        VoidPtr handler{};
+        bool    texture{};
+    };
+
+    //a written descriptor set with its full key, the hash only skips the comparison.
+    struct VulkanCachedDescriptorSet
+    {
+        usize                           hash{};
+        VkDescriptorSetLayout           layout{};
+        Array<VulkanDescriptorSetValue> values{};
+        VkDescriptorSet                 descriptorSet{};
+        u64                             lastUse{};
+    };
+
+    struct VulkanPendingDescriptorSet
+    {
+        VkDescriptorSet descriptorSet{};
+        u64             frame{};
     };
 }
\ No newline at end of file
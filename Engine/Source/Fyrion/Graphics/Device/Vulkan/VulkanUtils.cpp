@@ -329,10 +329,20 @@ namespace Fyrion::Vulkan
 		}
 	}
 
-	void CreatePipelineLayout(VkDevice vkDevice, Array<DescriptorLayout>& descriptors, Array<ShaderPushConstant>& pushConstants, VkPipelineLayout* vkPipelineLayout)
+	//set layouts are indexed by set number, sets not declared by the shader get an empty layout.
+	//returns true if the shader declares unbounded arrays at BindlessSet and the set uses bindlessLayout.
+	bool CreatePipelineLayout(VkDevice vkDevice, Array<DescriptorLayout>& descriptors, Array<ShaderPushConstant>& pushConstants, VkPipelineLayout* vkPipelineLayout, VkDescriptorSetLayout bindlessLayout)
 	{
+		u32 setCount = 0;
+		for (const DescriptorLayout& descriptor : descriptors)
+		{
+			setCount = Math::Max(setCount, descriptor.set + 1);
+		}
+
 		Array<VkDescriptorSetLayout> descriptorSetLayouts{};
-		descriptorSetLayouts.Resize(descriptors.Size());
+		descriptorSetLayouts.Resize(setCount);
+
+		bool bindless = false;
 
 
 		Array<VkPushConstantRange> pushConstantRanges{};
@@ -346,9 +356,29 @@ namespace Fyrion::Vulkan
 			});
 		}
 
-		for (int i = 0; i < descriptors.Size(); ++i)
+		for (const DescriptorLayout& descriptor : descriptors)
 		{
-			CreateDescriptorSetLayout(vkDevice, descriptors[i], &descriptorSetLayouts[i]);
+			bool hasRuntimeArrays = false;
+			for (const DescriptorBinding& binding : descriptor.bindings)
+			{
+				hasRuntimeArrays |= binding.renderType == RenderType::RuntimeArray;
+			}
+
+			if (bindlessLayout != VK_NULL_HANDLE && descriptor.set == BindlessSet && hasRuntimeArrays)
+			{
+				descriptorSetLayouts[descriptor.set] = bindlessLayout;
+				bindless = true;
+				continue;
+			}
+			CreateDescriptorSetLayout(vkDevice, descriptor, &descriptorSetLayouts[descriptor.set]);
+		}
+
+		for (VkDescriptorSetLayout& descriptorSetLayout : descriptorSetLayouts)
+		{
+			if (descriptorSetLayout == VK_NULL_HANDLE)
+			{
+				CreateDescriptorSetLayout(vkDevice, DescriptorLayout{}, &descriptorSetLayout);
+			}
 		}
 
 		VkPipelineLayoutCreateInfo layoutCreateInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
@@ -361,8 +391,13 @@ namespace Fyrion::Vulkan
 
 		for (int i = 0; i < descriptorSetLayouts.Size(); ++i)
 		{
-			vkDestroyDescriptorSetLayout(vkDevice, descriptorSetLayouts[i], nullptr);
+			if (descriptorSetLayouts[i] != bindlessLayout)
+			{
+				vkDestroyDescriptorSetLayout(vkDevice, descriptorSetLayouts[i], nullptr);
+			}
 		}
+
+		return bindless;
 	}
 
 	VkShaderStageFlags CastStage(const ShaderStage& shaderStage)
@@ -23,7 +23,8 @@ namespace Fyrion::Vulkan
     VkFormat                      CastFormat(const Format& textureFormat);
     VkImageUsageFlags             CastTextureUsage(TextureUsage textureUsage);
     void                          CreateDescriptorSetLayout(VkDevice vkDevice, const DescriptorLayout& descriptor, VkDescriptorSetLayout* descriptorSetLayout, bool* hasRuntimeArray = nullptr);
-    void                          CreatePipelineLayout(VkDevice vkDevice, Array<DescriptorLayout>& descriptors, Array<ShaderPushConstant>& pushConstants, VkPipelineLayout* vkPipelineLayout);
+    bool                          CreatePipelineLayout(VkDevice vkDevice, Array<DescriptorLayout>& descriptors, Array<ShaderPushConstant>& pushConstants, VkPipelineLayout* vkPipelineLayout,
+                                                       VkDescriptorSetLayout bindlessLayout = VK_NULL_HANDLE);
     VkShaderStageFlags            CastStage(const ShaderStage& shaderStage);
     VkPolygonMode                 CastPolygonMode(const PolygonMode& polygonMode);
     VkCullModeFlags               CastCull(const CullMode& cullMode);
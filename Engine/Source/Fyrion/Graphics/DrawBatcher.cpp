@@ -0,0 +1,405 @@
+#include "DrawBatcher.hpp"
+
+#include "Graphics.hpp"
+#include "Fyrion/Core/HashMap.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Resource/Repository.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::DrawBatcher");
+
+        constexpr u32 CullGroupSize = 64;
+
+        //planes point inwards, extracted from the rows of the view projection for a 0..1 depth range.
+        void FrustumPlanes(const Mat4& m, Vec4* planes)
+        {
+            Vec4 row0{m[0].x, m[1].x, m[2].x, m[3].x};
+            Vec4 row1{m[0].y, m[1].y, m[2].y, m[3].y};
+            Vec4 row2{m[0].z, m[1].z, m[2].z, m[3].z};
+            Vec4 row3{m[0].w, m[1].w, m[2].w, m[3].w};
+
+            planes[0] = row3 + row0;
+            planes[1] = row3 - row0;
+            planes[2] = row3 + row1;
+            planes[3] = row3 - row1;
+            planes[4] = row2;
+            planes[5] = row3 - row2;
+        }
+    }
+
+    DrawBatcher::DrawBatcher(const DrawBatcherCreation& creation) : m_creation(creation)
+    {
+        m_multiDraw = Graphics::GetFeatures().multiDrawIndirectSupported;
+
+        m_vertexBuffer = Graphics::CreateBuffer(BufferCreation{
+            .usage = BufferUsage::VertexBuffer | BufferUsage::StorageBuffer,
+            .size = static_cast<usize>(creation.vertexStride) * creation.maxVertices,
+            .allocation = BufferAllocation::GPUOnly
+        });
+
+        m_indexBuffer = Graphics::CreateBuffer(BufferCreation{
+            .usage = BufferUsage::IndexBuffer | BufferUsage::StorageBuffer,
+            .size = sizeof(u32) * creation.maxIndices,
+            .allocation = BufferAllocation::GPUOnly
+        });
+
+        //one per frame in flight, the arguments of a frame are written while the previous frames are still reading theirs.
+        for (Buffer& indirectBuffer : m_indirectBuffers)
+        {
+            indirectBuffer = Graphics::CreateBuffer(BufferCreation{
+                .usage = BufferUsage::IndirectBuffer | BufferUsage::StorageBuffer,
+                .size = sizeof(DrawIndexedIndirectArguments) * creation.maxDraws,
+                .allocation = BufferAllocation::GPUOnly
+            });
+        }
+
+        if (creation.gpuCulling)
+        {
+            RID shader = Repository::GetByPath("Fyrion://Shaders/GPUCulling.comp");
+            m_cullPipeline = Graphics::CreateComputePipelineState(ComputePipelineCreation{.shader = shader});
+
+            if (m_cullPipeline)
+            {
+                m_gpuCulling = true;
+                m_compact = m_multiDraw && Graphics::GetFeatures().drawIndirectCountSupported;
+                m_cullBindingSet = &Graphics::CreateBindingSet(shader, BindingSetType::Static);
+
+                for (u32 i = 0; i < FY_FRAMES_IN_FLIGHT; ++i)
+                {
+                    m_cullBuffers[i] = Graphics::CreateBuffer(BufferCreation{
+                        .usage = BufferUsage::StorageBuffer,
+                        .size = sizeof(DrawCullData) * creation.maxDraws,
+                        .allocation = BufferAllocation::GPUOnly
+                    });
+
+                    //one count per batch, a batch has at least one draw.
+                    m_countBuffers[i] = Graphics::CreateBuffer(BufferCreation{
+                        .usage = BufferUsage::IndirectBuffer | BufferUsage::StorageBuffer,
+                        .size = sizeof(u32) * creation.maxDraws,
+                        .allocation = BufferAllocation::GPUOnly
+                    });
+                }
+            }
+            else
+            {
+                logger.Error("culling pipeline could not be created, draws will not be culled");
+            }
+        }
+    }
+
+    DrawBatcher::~DrawBatcher()
+    {
+        Graphics::DestroyBuffer(m_vertexBuffer);
+        Graphics::DestroyBuffer(m_indexBuffer);
+        for (Buffer& indirectBuffer : m_indirectBuffers)
+        {
+            Graphics::DestroyBuffer(indirectBuffer);
+        }
+
+        if (m_gpuCulling)
+        {
+            for (u32 i = 0; i < FY_FRAMES_IN_FLIGHT; ++i)
+            {
+                Graphics::DestroyBuffer(m_cullBuffers[i]);
+                Graphics::DestroyBuffer(m_countBuffers[i]);
+            }
+            Graphics::DestroyBindingSet(*m_cullBindingSet);
+        }
+
+        if (m_cullPipeline)
+        {
+            Graphics::DestroyComputePipelineState(m_cullPipeline);
+        }
+    }
+
+    GeometryRender DrawBatcher::AddGeometry(const Span<u8>& vertexData, const Span<u32>& indexData)
+    {
+        FY_ASSERT(vertexData.Size() % m_creation.vertexStride == 0, "vertex data is not a multiple of the stride");
+
+        u32 vertexCount = static_cast<u32>(vertexData.Size() / m_creation.vertexStride);
+        u32 indexCount = static_cast<u32>(indexData.Size());
+
+        if (m_vertexCount + vertexCount > m_creation.maxVertices || m_indexCount + indexCount > m_creation.maxIndices)
+        {
+            logger.Error("geometry buffers are full, {} vertices and {} indices can't be added", vertexCount, indexCount);
+            return {};
+        }
+
+        Graphics::UpdateBufferData(BufferDataInfo{
+            .buffer = m_vertexBuffer,
+            .data = vertexData.Data(),
+            .size = vertexData.Size(),
+            .offset = static_cast<usize>(m_vertexCount) * m_creation.vertexStride
+        });
+
+        Graphics::UpdateBufferData(BufferDataInfo{
+            .buffer = m_indexBuffer,
+            .data = indexData.Data(),
+            .size = indexData.Size() * sizeof(u32),
+            .offset = static_cast<usize>(m_indexCount) * sizeof(u32)
+        });
+
+        GeometryRender geometryRender{
+            .vertexBuffer = m_vertexBuffer,
+            .indexBuffer = m_indexBuffer,
+            .firstIndex = m_indexCount,
+            .indexCount = indexCount,
+            .vertexOffset = static_cast<i32>(m_vertexCount)
+        };
+
+        m_vertexCount += vertexCount;
+        m_indexCount += indexCount;
+
+        m_stats.geometries++;
+        m_stats.vertices = m_vertexCount;
+        m_stats.indices = m_indexCount;
+
+        return geometryRender;
+    }
+
+    DrawBatcher::DrawItem* DrawBatcher::AddDraw(const PipelineState& pipeline, const GeometryRender& geometry, u32 instanceIndex)
+    {
+        FY_ASSERT(geometry.vertexBuffer == m_vertexBuffer, "geometry was not added to this batcher");
+
+        if (m_draws.Size() == m_creation.maxDraws)
+        {
+            logger.Error("max draws reached, draw discarded");
+            return nullptr;
+        }
+
+        return &m_draws.EmplaceBack(DrawItem{
+            .pipeline = pipeline,
+            .firstIndex = geometry.firstIndex,
+            .indexCount = geometry.indexCount,
+            .vertexOffset = geometry.vertexOffset,
+            .instanceIndex = instanceIndex
+        });
+    }
+
+    void DrawBatcher::Draw(const PipelineState& pipeline, const GeometryRender& geometry, u32 instanceIndex)
+    {
+        AddDraw(pipeline, geometry, instanceIndex);
+    }
+
+    void DrawBatcher::Draw(const PipelineState& pipeline, const GeometryRender& geometry, u32 instanceIndex, const AABB& bounds)
+    {
+        if (DrawItem* draw = AddDraw(pipeline, geometry, instanceIndex))
+        {
+            draw->cull = true;
+            draw->center = Vec4{(bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f, 0.0f};
+            draw->extents = Vec4{(bounds.max.x - bounds.min.x) * 0.5f, (bounds.max.y - bounds.min.y) * 0.5f, (bounds.max.z - bounds.min.z) * 0.5f, 0.0f};
+        }
+    }
+
+    void DrawBatcher::Build()
+    {
+        m_frame = (m_frame + 1) % FY_FRAMES_IN_FLIGHT;
+        m_culled = false;
+        m_batches.Clear();
+        m_arguments.Clear();
+        m_cullData.Clear();
+
+        //counting sort by pipeline, batches keep the order of the first draw of each pipeline and draws keep their order.
+        HashMap<usize, u32> batchLookup{};
+        Array<u32>          drawBatches{};
+        drawBatches.Resize(m_draws.Size());
+
+        for (usize i = 0; i < m_draws.Size(); ++i)
+        {
+            usize key = reinterpret_cast<usize>(m_draws[i].pipeline.handler);
+            auto  it = batchLookup.Find(key);
+            if (it == batchLookup.end())
+            {
+                it = batchLookup.Insert(key, static_cast<u32>(m_batches.Size())).first;
+                m_batches.EmplaceBack(Batch{.pipeline = m_draws[i].pipeline});
+            }
+            drawBatches[i] = it->second;
+            m_batches[it->second].drawCount++;
+        }
+
+        u32 firstDraw = 0;
+        for (Batch& batch : m_batches)
+        {
+            batch.firstDraw = firstDraw;
+            firstDraw += batch.drawCount;
+        }
+
+        Array<u32> batchOffsets{};
+        batchOffsets.Resize(m_batches.Size());
+
+        m_arguments.Resize(m_draws.Size());
+        if (m_gpuCulling)
+        {
+            m_cullData.Resize(m_draws.Size());
+        }
+
+        for (usize i = 0; i < m_draws.Size(); ++i)
+        {
+            const DrawItem& draw = m_draws[i];
+            u32             batchIndex = drawBatches[i];
+            u32             drawIndex = m_batches[batchIndex].firstDraw + batchOffsets[batchIndex]++;
+
+            DrawIndexedIndirectArguments arguments{
+                .indexCount = draw.indexCount,
+                .instanceCount = 1,
+                .firstIndex = draw.firstIndex,
+                .vertexOffset = draw.vertexOffset,
+                .firstInstance = draw.instanceIndex
+            };
+
+            if (m_gpuCulling)
+            {
+                //compacted draws are appended to the batch by the shader, otherwise each draw keeps its slot.
+                m_cullData[i] = DrawCullData{
+                    .arguments = arguments,
+                    .batchIndex = batchIndex,
+                    .outputIndex = m_compact ? m_batches[batchIndex].firstDraw : drawIndex,
+                    .cull = draw.cull ? 1u : 0u,
+                    .center = draw.center,
+                    .extents = draw.extents
+                };
+            }
+            else
+            {
+                m_arguments[drawIndex] = arguments;
+            }
+        }
+
+        if (m_gpuCulling && !m_cullData.Empty())
+        {
+            Graphics::UpdateBufferData(BufferDataInfo{
+                .buffer = m_cullBuffers[m_frame],
+                .data = m_cullData.Data(),
+                .size = m_cullData.Size() * sizeof(DrawCullData)
+            });
+        }
+        else if (!m_gpuCulling && !m_arguments.Empty())
+        {
+            Graphics::UpdateBufferData(BufferDataInfo{
+                .buffer = m_indirectBuffers[m_frame],
+                .data = m_arguments.Data(),
+                .size = m_arguments.Size() * sizeof(DrawIndexedIndirectArguments)
+            });
+        }
+
+        m_stats.draws = static_cast<u32>(m_draws.Size());
+        m_stats.batches = static_cast<u32>(m_batches.Size());
+        m_stats.drawCalls = m_multiDraw ? m_stats.batches : m_stats.draws;
+    }
+
+    void DrawBatcher::Cull(RenderCommands& cmd, const Mat4& viewProjection)
+    {
+        m_culled = true;
+
+        if (!m_gpuCulling || m_cullData.Empty())
+        {
+            return;
+        }
+
+        Buffer indirectBuffer = m_indirectBuffers[m_frame];
+        Buffer countBuffer = m_countBuffers[m_frame];
+
+        if (m_compact)
+        {
+            cmd.FillBuffer(countBuffer, 0, m_batches.Size() * sizeof(u32), 0);
+            cmd.BufferBarrier(BufferBarrierInfo{.buffer = countBuffer, .srcAccess = BufferAccess::TransferWrite, .dstAccess = BufferAccess::ShaderReadWrite});
+        }
+
+        BindingSet& bindingSet = *m_cullBindingSet;
+        bindingSet["draws"] = m_cullBuffers[m_frame];
+        bindingSet["arguments"] = indirectBuffer;
+        bindingSet["counts"] = countBuffer;
+
+        DrawCullConstants constants{
+            .drawCount = static_cast<u32>(m_cullData.Size()),
+            .compact = m_compact ? 1u : 0u
+        };
+        FrustumPlanes(viewProjection, constants.planes);
+
+        cmd.BindPipelineState(m_cullPipeline);
+        cmd.BindBindingSet(m_cullPipeline, bindingSet);
+        cmd.PushConstants(m_cullPipeline, ShaderStage::Compute, &constants, sizeof(DrawCullConstants));
+        cmd.Dispatch((constants.drawCount + CullGroupSize - 1) / CullGroupSize, 1, 1);
+
+        cmd.BufferBarrier(BufferBarrierInfo{.buffer = indirectBuffer, .srcAccess = BufferAccess::ShaderWrite, .dstAccess = BufferAccess::IndirectRead});
+        if (m_compact)
+        {
+            cmd.BufferBarrier(BufferBarrierInfo{.buffer = countBuffer, .srcAccess = BufferAccess::ShaderWrite, .dstAccess = BufferAccess::IndirectRead});
+        }
+    }
+
+    void DrawBatcher::Record(RenderCommands& cmd) const
+    {
+        if (m_batches.Empty())
+        {
+            return;
+        }
+
+        FY_ASSERT(!m_gpuCulling || m_culled, "Cull must be called between Build and Record");
+
+        cmd.BindVertexBuffer(m_vertexBuffer);
+        cmd.BindIndexBuffer(m_indexBuffer);
+
+        constexpr u32 stride = sizeof(DrawIndexedIndirectArguments);
+
+        for (u32 b = 0; b < m_batches.Size(); ++b)
+        {
+            const Batch& batch = m_batches[b];
+            cmd.BindPipelineState(batch.pipeline);
+
+            if (m_compact)
+            {
+                cmd.DrawIndexedIndirectCount(m_indirectBuffers[m_frame], static_cast<usize>(batch.firstDraw) * stride, m_countBuffers[m_frame], b * sizeof(u32), batch.drawCount, stride);
+            }
+            else if (m_multiDraw)
+            {
+                cmd.DrawIndexedIndirect(m_indirectBuffers[m_frame], static_cast<usize>(batch.firstDraw) * stride, batch.drawCount, stride);
+            }
+            else
+            {
+                for (u32 i = 0; i < batch.drawCount; ++i)
+                {
+                    cmd.DrawIndexedIndirect(m_indirectBuffers[m_frame], static_cast<usize>(batch.firstDraw + i) * stride, 1, stride);
+                }
+            }
+        }
+    }
+
+    void DrawBatcher::Reset()
+    {
+        m_draws.Clear();
+    }
+
+    Buffer DrawBatcher::GetVertexBuffer() const
+    {
+        return m_vertexBuffer;
+    }
+
+    Buffer DrawBatcher::GetIndexBuffer() const
+    {
+        return m_indexBuffer;
+    }
+
+    Buffer DrawBatcher::GetIndirectBuffer() const
+    {
+        return m_indirectBuffers[m_frame];
+    }
+
+    Buffer DrawBatcher::GetCullBuffer() const
+    {
+        return m_cullBuffers[m_frame];
+    }
+
+    Buffer DrawBatcher::GetCountBuffer() const
+    {
+        return m_countBuffers[m_frame];
+    }
+
+    const DrawBatcherStats& DrawBatcher::GetStats() const
+    {
+        return m_stats;
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Fyrion/Graphics/GraphicsTypes.hpp"
+#include "Fyrion/Core/FixedArray.hpp"
+#include "Fyrion/Graphics/DefaultRenderPipeline/GraphNodes.hpp"
+
+namespace Fyrion
+{
+    //same layout as VkDrawIndexedIndirectCommand
+    struct DrawIndexedIndirectArguments
+    {
+        u32 indexCount{};
+        u32 instanceCount{};
+        u32 firstIndex{};
+        i32 vertexOffset{};
+        u32 firstInstance{};
+    };
+
+    struct DrawBatcherCreation
+    {
+        u32  vertexStride{};
+        u32  maxVertices{};
+        u32  maxIndices{};
+        u32  maxDraws{};
+        bool gpuCulling{};
+    };
+
+    //same layout as CullDraw in Fyrion://Shaders/GPUCulling.comp
+    struct DrawCullData
+    {
+        DrawIndexedIndirectArguments arguments{};
+        u32                          batchIndex{};
+        u32                          outputIndex{};
+        u32                          cull{};
+        Vec4                         center{};
+        Vec4                         extents{};
+    };
+
+    //same layout as CullConstants in Fyrion://Shaders/GPUCulling.comp
+    struct DrawCullConstants
+    {
+        Vec4 planes[6]{};
+        u32  drawCount{};
+        u32  compact{};
+        u32  padding[2]{};
+    };
+
+    struct DrawBatcherStats
+    {
+        u32 geometries{};
+        u32 vertices{};
+        u32 indices{};
+        u32 draws{};
+        u32 batches{};
+        u32 drawCalls{};
+    };
+
+    //geometry is appended into shared vertex and index buffers, draws are grouped by pipeline and their arguments
+    //written into an indirect buffer, so a pipeline costs one multi-draw regardless of how many objects it draws.
+    //firstInstance carries the instance index given to Draw, shaders use it to fetch the object data.
+    //with gpuCulling the arguments are written by a compute pass instead, visible draws are packed at the start of
+    //their batch and drawn with DrawIndexedIndirectCount, or culled draws get no instances when it is unsupported.
+    class FY_API DrawBatcher
+    {
+    public:
+        explicit DrawBatcher(const DrawBatcherCreation& creation);
+        DrawBatcher(const DrawBatcher&) = delete;
+        DrawBatcher& operator=(const DrawBatcher&) = delete;
+        ~DrawBatcher();
+
+        //copies the geometry into the shared buffers, returns an empty GeometryRender when they are full.
+        GeometryRender AddGeometry(const Span<u8>& vertexData, const Span<u32>& indexData);
+
+        void Draw(const PipelineState& pipeline, const GeometryRender& geometry, u32 instanceIndex);
+
+        //bounds are in world space, only tested when the batcher was created with gpuCulling.
+        void Draw(const PipelineState& pipeline, const GeometryRender& geometry, u32 instanceIndex, const AABB& bounds);
+
+        //groups the draws and uploads the arguments to the indirect buffer of the frame, called once per frame.
+        void Build();
+
+        //records the culling dispatch, called after Build and outside a render pass.
+        void Cull(RenderCommands& cmd, const Mat4& viewProjection);
+        void Record(RenderCommands& cmd) const;
+        void Reset();
+
+        Buffer                  GetVertexBuffer() const;
+        Buffer                  GetIndexBuffer() const;
+        Buffer                  GetIndirectBuffer() const;
+        Buffer                  GetCullBuffer() const;
+        Buffer                  GetCountBuffer() const;
+        const DrawBatcherStats& GetStats() const;
+
+    private:
+        struct DrawItem
+        {
+            PipelineState pipeline{};
+            u32           firstIndex{};
+            u32           indexCount{};
+            i32           vertexOffset{};
+            u32           instanceIndex{};
+            bool          cull{};
+            Vec4          center{};
+            Vec4          extents{};
+        };
+
+        struct Batch
+        {
+            PipelineState pipeline{};
+            u32           firstDraw{};
+            u32           drawCount{};
+        };
+
+        DrawItem* AddDraw(const PipelineState& pipeline, const GeometryRender& geometry, u32 instanceIndex);
+
+        DrawBatcherCreation                          m_creation{};
+        bool                                         m_multiDraw{};
+        bool                                         m_gpuCulling{};
+        bool                                         m_compact{};
+        bool                                         m_culled{};
+        PipelineState                                m_cullPipeline{};
+        BindingSet*                                  m_cullBindingSet{};
+        FixedArray<Buffer, FY_FRAMES_IN_FLIGHT>      m_cullBuffers{};
+        FixedArray<Buffer, FY_FRAMES_IN_FLIGHT>      m_countBuffers{};
+        Buffer                                       m_vertexBuffer{};
+        Buffer                                       m_indexBuffer{};
+        FixedArray<Buffer, FY_FRAMES_IN_FLIGHT>      m_indirectBuffers{};
+        u32                                          m_frame{};
+        u32                                          m_vertexCount{};
+        u32                                          m_indexCount{};
+        Array<DrawItem>                              m_draws{};
+        Array<Batch>                                 m_batches{};
+        Array<DrawIndexedIndirectArguments>          m_arguments{};
+        Array<DrawCullData>                          m_cullData{};
+        DrawBatcherStats                             m_stats{};
+    };
+}
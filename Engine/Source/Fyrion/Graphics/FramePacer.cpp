@@ -0,0 +1,108 @@
+#include "FramePacer.hpp"
+
+#include "Fyrion/Core/Math.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        //weight of the last frame on the smoothed times.
+        constexpr f64 SmoothFactor = 0.1;
+
+        //the cpu estimate is padded so a slower frame doesn't leave the gpu waiting.
+        constexpr f64 SafetyMargin = 0.0005;
+        constexpr f64 SafetyFactor = 1.2;
+
+        f64 Smooth(f64 current, f64 value)
+        {
+            return current == 0 ? value : current + (value - current) * SmoothFactor;
+        }
+    }
+
+    void FramePacer::SetLowLatency(bool lowLatency)
+    {
+        m_lowLatency = lowLatency;
+    }
+
+    bool FramePacer::IsLowLatency() const
+    {
+        return m_lowLatency;
+    }
+
+    void FramePacer::Reset()
+    {
+        m_stats = {};
+        m_gpuIdleTime = 0;
+        m_totalInputLatency = 0;
+        m_completedFrames = 0;
+        m_pending = {};
+    }
+
+    f64 FramePacer::GetDelay(f64 now) const
+    {
+        if (!m_lowLatency || m_stats.frames == 0)
+        {
+            return 0;
+        }
+
+        f64 start = m_gpuIdleTime - (m_stats.cpuTime * SafetyFactor + SafetyMargin);
+
+        //never waits longer than a gpu frame, the prediction can be far off after a hitch.
+        return Math::Clamp(start - now, 0.0, m_stats.gpuTime);
+    }
+
+    void FramePacer::BeginFrame(u64 frame, f64 now, f64 delay)
+    {
+        m_stats.delay = delay;
+        m_pending[frame % m_pending.Size()] = PendingFrame{
+            .frame = frame,
+            .inputTime = now
+        };
+    }
+
+    void FramePacer::EndFrame(u64 frame, f64 now)
+    {
+        //the gpu starts the frame after the ones already queued.
+        m_gpuIdleTime = Math::Max(now, m_gpuIdleTime) + m_stats.gpuTime;
+        m_stats.frames++;
+
+        PendingFrame& pending = m_pending[frame % m_pending.Size()];
+        if (pending.frame == frame)
+        {
+            m_stats.cpuTime = Smooth(m_stats.cpuTime, now - pending.inputTime);
+            pending.gpuCompletion = m_gpuIdleTime;
+        }
+    }
+
+    void FramePacer::SetGPUTime(f64 gpuTime)
+    {
+        m_stats.gpuTime = Smooth(m_stats.gpuTime, gpuTime);
+    }
+
+    void FramePacer::FrameCompleted(u64 frame, f64 now)
+    {
+        PendingFrame& pending = m_pending[frame % m_pending.Size()];
+        if (pending.frame != frame)
+        {
+            return;
+        }
+        pending.frame = U64_MAX;
+
+        //the frame finished before it was predicted to, the frames queued after it start earlier too.
+        if (pending.gpuCompletion > now)
+        {
+            m_gpuIdleTime = Math::Max(m_gpuIdleTime - (pending.gpuCompletion - now), now);
+        }
+
+        m_stats.inputLatency = now - pending.inputTime;
+        m_stats.maxInputLatency = Math::Max(m_stats.maxInputLatency, m_stats.inputLatency);
+        m_totalInputLatency += m_stats.inputLatency;
+        m_completedFrames++;
+        m_stats.averageInputLatency = m_totalInputLatency / static_cast<f64>(m_completedFrames);
+    }
+
+    const FramePacingStats& FramePacer::GetStats() const
+    {
+        return m_stats;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Fyrion/Common.hpp"
+#include "Fyrion/Core/FixedArray.hpp"
+
+namespace Fyrion
+{
+    //times in seconds. input latency is measured from the input sampling until the engine sees the frame fence signaled,
+    //it's an upper bound of the gpu completion and doesn't include the time the image waits to be displayed.
+    struct FramePacingStats
+    {
+        u64 frames{};
+        f64 cpuTime{};
+        f64 gpuTime{};
+        f64 delay{};
+        f64 inputLatency{};
+        f64 averageInputLatency{};
+        f64 maxInputLatency{};
+    };
+
+    //predicts when the gpu finishes the queued frames from the measured cpu and gpu frame times. in low latency mode
+    //the next frame is delayed so its commands are submitted just before the gpu gets idle, sampling input later.
+    class FY_API FramePacer
+    {
+    public:
+        void SetLowLatency(bool lowLatency);
+        bool IsLowLatency() const;
+        void Reset();
+
+        f64  GetDelay(f64 now) const;
+        void BeginFrame(u64 frame, f64 now, f64 delay);
+        void EndFrame(u64 frame, f64 now);
+        void SetGPUTime(f64 gpuTime);
+        void FrameCompleted(u64 frame, f64 now);
+
+        const FramePacingStats& GetStats() const;
+
+    private:
+        struct PendingFrame
+        {
+            u64 frame{U64_MAX};
+            f64 inputTime{};
+            f64 gpuCompletion{};
+        };
+
+        bool                         m_lowLatency{};
+        FramePacingStats             m_stats{};
+        f64                          m_gpuIdleTime{};
+        f64                          m_totalInputLatency{};
+        u64                          m_completedFrames{};
+        FixedArray<PendingFrame, 8>  m_pending{};
+    };
+}
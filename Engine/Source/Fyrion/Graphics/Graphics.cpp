@@ -4,20 +4,22 @@
 
 namespace Fyrion
 {
-    void GraphicsInit();
+    void GraphicsInit(bool headless);
     void GraphicsShutdown();
     void GraphicsCreateDevice(Adapter adapter);
+    FY_API RenderDevice& GetRenderDevice();
 
     SharedPtr<RenderDevice> CreateVulkanDevice();
+    SharedPtr<RenderDevice> CreateNullDevice();
 
     namespace
     {
         SharedPtr<RenderDevice> renderDevice = {};
     }
 
-    void GraphicsInit()
+    void GraphicsInit(bool headless)
     {
-        renderDevice = CreateVulkanDevice();
+        renderDevice = headless ? CreateNullDevice() : CreateVulkanDevice();
     }
 
     void GraphicsShutdown()
@@ -145,18 +147,103 @@ namespace Fyrion
         return renderDevice->AcquireNextRenderPass(swapchain);
     }
 
+    void Graphics::SetPresentMode(Swapchain swapchain, PresentMode presentMode)
+    {
+        renderDevice->SetPresentMode(swapchain, presentMode);
+    }
+
+    PresentMode Graphics::GetPresentMode(Swapchain swapchain)
+    {
+        return renderDevice->GetPresentMode(swapchain);
+    }
+
     void Graphics::WaitQueue()
     {
         renderDevice->WaitQueue();
     }
 
+    void Graphics::SetFramesInFlight(u32 framesInFlight)
+    {
+        renderDevice->SetFramesInFlight(framesInFlight);
+    }
+
+    u32 Graphics::GetFramesInFlight()
+    {
+        return renderDevice->GetFramesInFlight();
+    }
+
+    void Graphics::WaitFrame()
+    {
+        renderDevice->WaitFrame();
+    }
+
     void Graphics::UpdateBufferData(const BufferDataInfo& bufferDataInfo)
     {
         renderDevice->UpdateBufferData(bufferDataInfo);
     }
 
+    UploadStats Graphics::GetUploadStats()
+    {
+        return renderDevice->GetUploadStats();
+    }
+
+    DescriptorStats Graphics::GetDescriptorStats()
+    {
+        return renderDevice->GetDescriptorStats();
+    }
+
+    const GPUFrameTimings& Graphics::GetGPUFrameTimings()
+    {
+        return renderDevice->GetGPUFrameTimings();
+    }
+
+    ResourceStats Graphics::GetResourceStats()
+    {
+        return renderDevice->GetResourceStats();
+    }
+
+    UploadToken Graphics::UploadAsync(const BufferDataInfo& bufferDataInfo)
+    {
+        return renderDevice->UploadAsync(bufferDataInfo);
+    }
+
+    bool Graphics::IsUploadComplete(UploadToken uploadToken)
+    {
+        return renderDevice->IsUploadComplete(uploadToken);
+    }
+
+    void Graphics::WaitUpload(UploadToken uploadToken)
+    {
+        renderDevice->WaitUpload(uploadToken);
+    }
+
     RenderApiType Graphics::GetRenderApi()
     {
         return RenderApiType::Vulkan;
     }
+
+    DeviceFeatures Graphics::GetFeatures()
+    {
+        return renderDevice->GetFeatures();
+    }
+
+    u32 Graphics::GetBindlessIndex(const Texture& texture)
+    {
+        return renderDevice->GetBindlessIndex(texture);
+    }
+
+    u32 Graphics::GetBindlessIndex(const TextureView& textureView)
+    {
+        return renderDevice->GetBindlessIndex(textureView);
+    }
+
+    u32 Graphics::GetBindlessIndex(const Sampler& sampler)
+    {
+        return renderDevice->GetBindlessIndex(sampler);
+    }
+
+    u32 Graphics::GetBindlessIndex(const Buffer& buffer)
+    {
+        return renderDevice->GetBindlessIndex(buffer);
+    }
 }
@@ -24,7 +24,38 @@ namespace Fyrion::Graphics
     FY_API void          DestroyComputePipelineState(const PipelineState& pipelineState);
     FY_API void          DestroyBindingSet(BindingSet& bindingSet);
     FY_API RenderPass    AcquireNextRenderPass(Swapchain swapchain);
+    FY_API void          SetPresentMode(Swapchain swapchain, PresentMode presentMode);
+    FY_API PresentMode   GetPresentMode(Swapchain swapchain);
     FY_API void          WaitQueue();
+
+    //frames recorded while the gpu executes the previous ones, from 1 to FY_FRAMES_IN_FLIGHT. waits the queue when changed.
+    FY_API void          SetFramesInFlight(u32 framesInFlight);
+    FY_API u32           GetFramesInFlight();
+
+    //blocks until the gpu finished the frame that last used the resources of the next frame.
+    //called by the engine before sampling input, BeginFrame only waits if it wasn't called.
+    FY_API void          WaitFrame();
     FY_API void          UpdateBufferData(const BufferDataInfo& bufferDataInfo);
+    FY_API UploadStats   GetUploadStats();
+    FY_API DescriptorStats GetDescriptorStats();
+    FY_API const GPUFrameTimings& GetGPUFrameTimings();
+
+    //occupancy of the resource pools, destroyed resources are pending until the frames using them are completed.
+    FY_API ResourceStats GetResourceStats();
+
+    //uploads on the transfer queue, running alongside the frames. the buffer can be used by commands recorded
+    //after IsUploadComplete returns true or after WaitUpload, the render thread acquires it at the frame's end.
+    //UploadAsync, IsUploadComplete and WaitUpload can be called from any thread.
+    FY_API UploadToken   UploadAsync(const BufferDataInfo& bufferDataInfo);
+    FY_API bool          IsUploadComplete(UploadToken uploadToken);
+    FY_API void          WaitUpload(UploadToken uploadToken);
     FY_API RenderApiType GetRenderApi();
+    FY_API DeviceFeatures GetFeatures();
+
+    //index of the resource in the bindless heap, stable until the resource is destroyed.
+    //U32_MAX if bindless is not supported, or for textures without ShaderResource usage and buffers without StorageBuffer usage.
+    FY_API u32 GetBindlessIndex(const Texture& texture);
+    FY_API u32 GetBindlessIndex(const TextureView& textureView);
+    FY_API u32 GetBindlessIndex(const Sampler& sampler);
+    FY_API u32 GetBindlessIndex(const Buffer& buffer);
 }
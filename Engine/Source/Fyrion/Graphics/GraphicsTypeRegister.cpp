@@ -32,6 +32,7 @@ namespace Fyrion
         Registry::Type<ShaderInfo>();
         Registry::Type<Buffer>();
         Registry::Type<Texture>();
+        Registry::Type<RenderGraphPass>();
 
         auto bufferUsage = Registry::Type<BufferUsage>();
         bufferUsage.Value<BufferUsage::VertexBuffer>("VertexBuffer");
@@ -46,6 +47,7 @@ namespace Fyrion
 
         ResourceTypeBuilder<RenderGraphPassAsset>::Builder()
             .Value<RenderGraphPassAsset::Pass, String>("Pass")
+            .Value<RenderGraphPassAsset::Name, String>("Name")
             .Build();
 
         ResourceTypeBuilder<RenderGraphEdgeAsset>::Builder()
@@ -6,6 +6,7 @@
 #include "Fyrion/Core/StringView.hpp"
 #include "Fyrion/Core/Math.hpp"
 #include "Fyrion/Core/Span.hpp"
+#include "Fyrion/Core/Profiler.hpp"
 #include "Fyrion/Resource/ResourceTypes.hpp"
 
 namespace Fyrion
@@ -20,6 +21,13 @@ namespace Fyrion
     FY_HANDLER(Sampler);
     FY_HANDLER(GPUQueue);
 
+    //bindless heap, shaders opt in by declaring unbounded arrays at BindlessSet. see Fyrion://Shaders/Bindless.inc
+    static const u32 MaxBindlessResources = 16536;
+    static const u32 BindlessSet = 0;
+    static const u32 BindlessTextureBinding = 0;
+    static const u32 BindlessSamplerBinding = 1;
+    static const u32 BindlessBufferBinding = 2;
+
     enum class Format
     {
         R,
@@ -110,6 +118,16 @@ namespace Fyrion
 
     ENUM_FLAGS(BufferUsage, u32)
 
+    enum class BufferAccess
+    {
+        None,
+        TransferWrite,
+        ShaderRead,
+        ShaderWrite,
+        ShaderReadWrite,
+        IndirectRead
+    };
+
     enum class BufferAllocation
     {
         GPUOnly       = 1,
@@ -250,10 +268,19 @@ namespace Fyrion
         Static
     };
 
+    //Fifo waits for the vertical blank, Mailbox replaces the queued image without tearing and Immediate can tear.
+    //unsupported modes fall back to Mailbox and then to Fifo.
+    enum class PresentMode
+    {
+        Fifo,
+        Mailbox,
+        Immediate
+    };
+
     struct SwapchainCreation
     {
-        Window window{};
-        bool vsync{true};
+        Window      window{};
+        PresentMode presentMode{PresentMode::Fifo};
     };
 
     struct AttachmentCreation
@@ -316,6 +343,8 @@ namespace Fyrion
         StringView    entryPoint{};
         ShaderStage   shaderStage{};
         RenderApiType renderApi{};
+        StringView    path{};
+        Span<String>  defines{};
     };
 
 
@@ -376,6 +405,13 @@ namespace Fyrion
         bool isDepth{false};
     };
 
+    struct BufferBarrierInfo
+    {
+        Buffer       buffer{};
+        BufferAccess srcAccess{};
+        BufferAccess dstAccess{};
+    };
+
     struct InterfaceVariable
     {
         u32    location{};
@@ -446,6 +482,12 @@ namespace Fyrion
         usize       offset{};
     };
 
+    //value of the transfer timeline, an upload is complete when the timeline reaches it. zero is always complete.
+    struct UploadToken
+    {
+        u64 value{};
+    };
+
     struct BufferCopyInfo
     {
         usize srcOffset;
@@ -555,6 +597,14 @@ namespace Fyrion
         virtual void ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo) = 0;
         virtual void CopyBuffer(Buffer srcBuffer, Buffer dstBuffer, const Span<BufferCopyInfo>& info) = 0;
 
+        //binds the bindless heap at BindlessSet, once per command buffer and bind point is enough.
+        virtual void BindBindlessHeap(const PipelineState& pipeline) = 0;
+
+        //the draw count is read from countBuffer at countOffset and clamped to maxDrawCount.
+        virtual void DrawIndexedIndirectCount(const Buffer& buffer, usize offset, const Buffer& countBuffer, usize countOffset, u32 maxDrawCount, u32 stride) = 0;
+        virtual void FillBuffer(const Buffer& buffer, usize offset, usize size, u32 value) = 0;
+        virtual void BufferBarrier(const BufferBarrierInfo& bufferBarrierInfo) = 0;
+
         virtual void SubmitAndWait(GPUQueue queue) = 0;
 
     };
@@ -564,6 +614,50 @@ namespace Fyrion
         bool raytraceSupported{};
         bool bindlessSupported{};
         bool multiDrawIndirectSupported{};
+        bool drawIndirectCountSupported{};
+    };
+
+    struct UploadStats
+    {
+        u64 uploads{};
+        u64 bytesUploaded{};
+        u64 oversizeUploads{};
+        u64 stalls{};
+        f64 bytesPerSecond{};
+    };
+
+    //binding set descriptors of the last completed frame.
+    struct DescriptorStats
+    {
+        u32 allocations{};
+        u32 updates{};
+        u32 writes{};
+        u32 cacheHits{};
+    };
+
+    //stale accesses counts handles used after their resource was destroyed.
+    struct ResourcePoolStats
+    {
+        u32 live{};
+        u32 pendingDestroy{};
+        u32 capacity{};
+        u32 staleAccesses{};
+    };
+
+    struct ResourceStats
+    {
+        ResourcePoolStats buffers{};
+        ResourcePoolStats textures{};
+        ResourcePoolStats textureViews{};
+        ResourcePoolStats samplers{};
+    };
+
+    //gpu time of the labels recorded on the default commands, read back when the frame resources are reused.
+    //frame is U64_MAX until the first frame is resolved, scope times are relative to the first label of the frame.
+    struct GPUFrameTimings
+    {
+        u64                 frame{U64_MAX};
+        Array<ProfileScope> scopes{};
     };
 
 
@@ -584,7 +678,7 @@ namespace Fyrion
         case Format::RGBA16F: return 16 * 4;
         case Format::RGBA32F: return 32 * 4;
         case Format::BGRA: return 8 * 4;
-        case Format::Depth:
+        case Format::Depth: return 32;
         case Format::Undefined:
             break;
         }
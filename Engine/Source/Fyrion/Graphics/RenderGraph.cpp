@@ -1,30 +1,603 @@
 #include "RenderGraph.hpp"
 
+#include "Graphics.hpp"
+#include "Fyrion/Core/Algorithm.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Resource/Repository.hpp"
+
 
 namespace Fyrion
 {
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::RenderGraph");
+
+        bool IsDepth(Format format)
+        {
+            return format == Format::Depth;
+        }
+
+        //splits "pass.slot"
+        bool SplitSlot(StringView slot, StringView& pass, StringView& name)
+        {
+            usize pos = slot.FindLastOf('.');
+            if (pos == nPos)
+            {
+                return false;
+            }
+            pass = slot.Substr(0, pos);
+            name = slot.Substr(pos + 1);
+            return true;
+        }
+    }
+
+    RenderGraph::~RenderGraph()
+    {
+        DestroyResources();
+
+        for (PassNode& passNode : m_passes)
+        {
+            passNode.typeHandler->Destroy(passNode.instance);
+        }
+    }
+
     Extent RenderGraph::GetViewportExtent()
     {
-        return {};
+        return m_extent;
     }
 
     void RenderGraph::Resize(const Extent& extent)
     {
+        if (m_extent == extent)
+        {
+            return;
+        }
 
+        Graphics::WaitQueue();
+        DestroyResources();
+        m_extent = extent;
+        CreateResources();
     }
 
     Texture RenderGraph::GetColorOutput() const
     {
+        if (m_colorOutput != U32_MAX && m_resources[m_colorOutput].physical != U32_MAX)
+        {
+            return m_physicalTextures[m_resources[m_colorOutput].physical].texture;
+        }
         return {};
     }
 
     Texture RenderGraph::GetDepthOutput() const
     {
+        if (m_depthOutput != U32_MAX && m_resources[m_depthOutput].physical != U32_MAX)
+        {
+            return m_physicalTextures[m_resources[m_depthOutput].physical].texture;
+        }
         return {};
     }
 
+    const RenderGraphStats& RenderGraph::GetStats() const
+    {
+        return m_stats;
+    }
+
+    Array<String> RenderGraph::GetExecutionOrder() const
+    {
+        Array<String> order{};
+        for (u32 pass : m_order)
+        {
+            order.EmplaceBack(m_passes[pass].name);
+        }
+        return order;
+    }
+
+    void RenderGraph::Load(RID renderGraphId)
+    {
+        ResourceObject graphObject = Repository::Read(renderGraphId);
+        if (!graphObject)
+        {
+            return;
+        }
+
+        for (RID passRid : graphObject.GetSubObjectSetAsArray(RenderGraphAsset::Passes))
+        {
+            ResourceObject passObject = Repository::Read(passRid);
+
+            StringView typeName = passObject[RenderGraphPassAsset::Pass].Value<StringView>();
+            StringView name = passObject[RenderGraphPassAsset::Name].Value<StringView>();
+
+            TypeHandler* typeHandler = Registry::FindTypeByName(typeName);
+            if (typeHandler == nullptr)
+            {
+                logger.Error("pass type {} not found", typeName);
+                continue;
+            }
+
+            VoidPtr instance = typeHandler->NewInstance();
+            RenderGraphPass* pass = typeHandler->Cast<RenderGraphPass>(instance);
+            if (pass == nullptr)
+            {
+                logger.Error("type {} is not a RenderGraphPass", typeName);
+                typeHandler->Destroy(instance);
+                continue;
+            }
+
+            PassNode& passNode = m_passes.EmplaceBack();
+            passNode.name = !name.Empty() ? name : typeName;
+            passNode.typeHandler = typeHandler;
+            passNode.instance = instance;
+            passNode.pass = pass;
+            pass->Setup(passNode.setup);
+        }
+
+        //sub object sets have no order, names keep the compilation deterministic.
+        Sort(m_passes.begin(), m_passes.end(), [](const PassNode& left, const PassNode& right)
+        {
+            return left.name < right.name;
+        });
+
+        HashMap<String, u32> passesByName{};
+        HashMap<String, u32> resourcesByName{};
+
+        for (u32 p = 0; p < m_passes.Size(); ++p)
+        {
+            PassNode& passNode = m_passes[p];
+            passesByName.Insert(passNode.name, p);
+            passNode.inputs.Resize(passNode.setup.inputs.Size(), U32_MAX);
+
+            for (const auto& output : passNode.setup.outputs)
+            {
+                String resourceName = passNode.name + "." + output.first;
+                passNode.outputs.EmplaceBack(static_cast<u32>(m_resources.Size()));
+                resourcesByName.Insert(resourceName, static_cast<u32>(m_resources.Size()));
+                m_resources.EmplaceBack(ResourceNode{
+                    .name = resourceName,
+                    .creation = output.second,
+                    .producer = p
+                });
+            }
+        }
+
+        for (RID edgeRid : graphObject.GetSubObjectSetAsArray(RenderGraphAsset::Edges))
+        {
+            ResourceObject edgeObject = Repository::Read(edgeRid);
+            StringView origin = edgeObject[RenderGraphEdgeAsset::Origin].Value<StringView>();
+            StringView dest = edgeObject[RenderGraphEdgeAsset::Dest].Value<StringView>();
+
+            auto itResource = resourcesByName.Find(origin);
+            if (itResource == resourcesByName.end())
+            {
+                logger.Error("edge origin {} not found", origin);
+                continue;
+            }
+
+            StringView passName, inputName;
+            auto itPass = SplitSlot(dest, passName, inputName) ? passesByName.Find(passName) : passesByName.end();
+            if (itPass == passesByName.end())
+            {
+                logger.Error("edge dest {} not found", dest);
+                continue;
+            }
+
+            PassNode& passNode = m_passes[itPass->second];
+            usize input = FindFirstIndex(passNode.setup.inputs.begin(), passNode.setup.inputs.end(), String{inputName});
+            if (input == nPos)
+            {
+                logger.Error("pass {} has no input {}", passNode.name, inputName);
+                continue;
+            }
+            passNode.inputs[input] = itResource->second;
+        }
+
+        if (auto it = resourcesByName.Find(graphObject[RenderGraphAsset::ColorOutput].Value<StringView>()))
+        {
+            m_colorOutput = it->second;
+        }
+
+        if (auto it = resourcesByName.Find(graphObject[RenderGraphAsset::DepthOutput].Value<StringView>()))
+        {
+            m_depthOutput = it->second;
+        }
+    }
+
+    void RenderGraph::Compile()
+    {
+        m_stats = {};
+
+        //culling, only producers of the graph outputs and passes with side effects are kept.
+        Array<u32> worklist{};
+        for (u32 output : {m_colorOutput, m_depthOutput})
+        {
+            if (output != U32_MAX && !m_passes[m_resources[output].producer].alive)
+            {
+                m_passes[m_resources[output].producer].alive = true;
+                worklist.EmplaceBack(m_resources[output].producer);
+            }
+        }
+
+        for (u32 p = 0; p < m_passes.Size(); ++p)
+        {
+            if (m_passes[p].setup.sideEffects && !m_passes[p].alive)
+            {
+                m_passes[p].alive = true;
+                worklist.EmplaceBack(p);
+            }
+        }
+
+        while (!worklist.Empty())
+        {
+            u32 p = worklist.Back();
+            worklist.PopBack();
+
+            for (u32 input : m_passes[p].inputs)
+            {
+                if (input != U32_MAX && !m_passes[m_resources[input].producer].alive)
+                {
+                    m_passes[m_resources[input].producer].alive = true;
+                    worklist.EmplaceBack(m_resources[input].producer);
+                }
+            }
+        }
+
+        //topological order, ties are resolved by name.
+        Array<u32>        pending(m_passes.Size(), 0);
+        Array<Array<u32>> consumers(m_passes.Size());
+        Array<u32>        ready{};
+        u32               aliveCount = 0;
+
+        for (u32 p = 0; p < m_passes.Size(); ++p)
+        {
+            if (!m_passes[p].alive) continue;
+            aliveCount++;
+
+            for (u32 input : m_passes[p].inputs)
+            {
+                if (input == U32_MAX) continue;
+                consumers[m_resources[input].producer].EmplaceBack(p);
+                pending[p]++;
+            }
+
+            if (pending[p] == 0)
+            {
+                ready.EmplaceBack(p);
+            }
+        }
+
+        while (!ready.Empty())
+        {
+            usize next = 0;
+            for (usize i = 1; i < ready.Size(); ++i)
+            {
+                if (ready[i] < ready[next]) next = i;
+            }
+
+            u32 p = ready[next];
+            ready.Erase(ready.begin() + next, ready.begin() + next + 1);
+            m_order.EmplaceBack(p);
+
+            for (u32 consumer : consumers[p])
+            {
+                if (--pending[consumer] == 0)
+                {
+                    ready.EmplaceBack(consumer);
+                }
+            }
+        }
+
+        if (m_order.Size() != aliveCount)
+        {
+            logger.Error("render graph has a cycle, {} passes will not be executed", aliveCount - m_order.Size());
+        }
+
+        for (PassNode& passNode : m_passes)
+        {
+            passNode.alive = false;
+        }
+
+        for (u32 p : m_order)
+        {
+            m_passes[p].alive = true;
+        }
+
+        m_stats.passes = m_order.Size();
+        m_stats.culledPasses = m_passes.Size() - m_order.Size();
+
+        //lifetimes and usages
+        for (u32 i = 0; i < m_order.Size(); ++i)
+        {
+            PassNode& passNode = m_passes[m_order[i]];
+            for (u32 output : passNode.outputs)
+            {
+                ResourceNode& resource = m_resources[output];
+                resource.firstUse = i;
+                resource.lastUse = i;
+
+                if (passNode.setup.type == RenderGraphPassType::Compute)
+                {
+                    resource.usage |= TextureUsage::Storage;
+                }
+                else
+                {
+                    resource.usage |= IsDepth(resource.creation.format) ? TextureUsage::DepthStencil : TextureUsage::RenderPass;
+                }
+            }
+
+            for (u32 input : passNode.inputs)
+            {
+                if (input == U32_MAX) continue;
+                m_resources[input].lastUse = Math::Max(m_resources[input].lastUse, i);
+                m_resources[input].usage |= TextureUsage::ShaderResource;
+            }
+        }
+
+        //graph outputs are read after the graph, they are never reused.
+        for (u32 output : {m_colorOutput, m_depthOutput})
+        {
+            if (output != U32_MAX)
+            {
+                m_resources[output].lastUse = U32_MAX;
+                m_resources[output].usage |= TextureUsage::ShaderResource;
+            }
+        }
+
+        //aliasing, a texture is reused by the next resource with the same description that starts after its last use.
+        for (u32 p : m_order)
+        {
+            for (u32 output : m_passes[p].outputs)
+            {
+                ResourceNode& resource = m_resources[output];
+                m_stats.transientTextures++;
+
+                for (u32 i = 0; i < m_physicalTextures.Size(); ++i)
+                {
+                    const ResourceNode& other = m_resources[m_physicalTextures[i].resource];
+                    if (m_physicalTextures[i].lastUse < resource.firstUse &&
+                        other.creation.format == resource.creation.format &&
+                        other.creation.scale == resource.creation.scale &&
+                        other.usage == resource.usage)
+                    {
+                        resource.physical = i;
+                        break;
+                    }
+                }
+
+                if (resource.physical == U32_MAX)
+                {
+                    resource.physical = m_physicalTextures.Size();
+                    m_physicalTextures.EmplaceBack(PhysicalTexture{.resource = output});
+                }
+                m_physicalTextures[resource.physical].lastUse = resource.lastUse;
+            }
+        }
+
+        m_stats.physicalTextures = m_physicalTextures.Size();
+
+        //barriers, contents are discarded on the first write so aliased textures don't need to be preserved.
+        Array<ResourceLayout> layouts(m_physicalTextures.Size(), ResourceLayout::Undefined);
+
+        for (u32 p : m_order)
+        {
+            PassNode& passNode = m_passes[p];
+
+            for (u32 input : passNode.inputs)
+            {
+                if (input == U32_MAX) continue;
+                const ResourceNode& resource = m_resources[input];
+                if (layouts[resource.physical] != ResourceLayout::ShaderReadOnly)
+                {
+                    passNode.barriers.EmplaceBack(Barrier{resource.physical, layouts[resource.physical], ResourceLayout::ShaderReadOnly, IsDepth(resource.creation.format)});
+                    layouts[resource.physical] = ResourceLayout::ShaderReadOnly;
+                }
+            }
+
+            for (u32 output : passNode.outputs)
+            {
+                const ResourceNode& resource = m_resources[output];
+                bool depth = IsDepth(resource.creation.format);
+
+                ResourceLayout layout = ResourceLayout::General;
+                if (passNode.setup.type == RenderGraphPassType::Graphics)
+                {
+                    layout = depth ? ResourceLayout::DepthStencilAttachment : ResourceLayout::ColorAttachment;
+                }
+
+                passNode.barriers.EmplaceBack(Barrier{resource.physical, ResourceLayout::Undefined, layout, depth});
+                layouts[resource.physical] = layout;
+            }
+
+            m_stats.barriers += passNode.barriers.Size();
+        }
+
+        for (u32 output : {m_colorOutput, m_depthOutput})
+        {
+            if (output != U32_MAX && m_resources[output].physical != U32_MAX)
+            {
+                const ResourceNode& resource = m_resources[output];
+                if (layouts[resource.physical] != ResourceLayout::ShaderReadOnly)
+                {
+                    m_finalBarriers.EmplaceBack(Barrier{resource.physical, layouts[resource.physical], ResourceLayout::ShaderReadOnly, IsDepth(resource.creation.format)});
+                    layouts[resource.physical] = ResourceLayout::ShaderReadOnly;
+                }
+            }
+        }
+
+        m_stats.barriers += m_finalBarriers.Size();
+    }
+
+    TextureCreation RenderGraph::GetTextureCreation(const ResourceNode& resource) const
+    {
+        return TextureCreation{
+            .extent = {
+                Math::Max(static_cast<u32>(static_cast<f32>(m_extent.width) * resource.creation.scale.x), 1u),
+                Math::Max(static_cast<u32>(static_cast<f32>(m_extent.height) * resource.creation.scale.y), 1u),
+                1
+            },
+            .format = resource.creation.format,
+            .usage = resource.usage
+        };
+    }
+
+    void RenderGraph::CreateResources()
+    {
+        m_stats.textureMemory = 0;
+        m_stats.memorySaved = 0;
+
+        for (PhysicalTexture& physicalTexture : m_physicalTextures)
+        {
+            TextureCreation textureCreation = GetTextureCreation(m_resources[physicalTexture.resource]);
+            physicalTexture.texture = Graphics::CreateTexture(textureCreation);
+            m_stats.textureMemory += static_cast<usize>(textureCreation.extent.width) * textureCreation.extent.height * GetFormatSize(textureCreation.format) / 8;
+        }
+
+        usize requiredMemory = 0;
+        for (const ResourceNode& resource : m_resources)
+        {
+            if (resource.physical != U32_MAX)
+            {
+                TextureCreation textureCreation = GetTextureCreation(resource);
+                requiredMemory += static_cast<usize>(textureCreation.extent.width) * textureCreation.extent.height * GetFormatSize(textureCreation.format) / 8;
+            }
+        }
+        m_stats.memorySaved = requiredMemory - m_stats.textureMemory;
+
+        for (u32 p : m_order)
+        {
+            PassNode& passNode = m_passes[p];
+
+            //passes render at the extent of their outputs, which can be scaled from the viewport.
+            passNode.context.extent = m_extent;
+            if (!passNode.outputs.Empty())
+            {
+                TextureCreation textureCreation = GetTextureCreation(m_resources[passNode.outputs[0]]);
+                passNode.context.extent = {textureCreation.extent.width, textureCreation.extent.height};
+            }
+            passNode.context.inputs.Clear();
+            passNode.context.outputs.Clear();
+
+            for (usize i = 0; i < passNode.inputs.Size(); ++i)
+            {
+                if (passNode.inputs[i] != U32_MAX)
+                {
+                    passNode.context.inputs.Insert(passNode.setup.inputs[i], m_physicalTextures[m_resources[passNode.inputs[i]].physical].texture);
+                }
+            }
+
+            Array<AttachmentCreation> attachments{};
+            for (usize i = 0; i < passNode.outputs.Size(); ++i)
+            {
+                const ResourceNode& resource = m_resources[passNode.outputs[i]];
+                Texture texture = m_physicalTextures[resource.physical].texture;
+                passNode.context.outputs.Insert(passNode.setup.outputs[i].first, texture);
+
+                ResourceLayout layout = IsDepth(resource.creation.format) ? ResourceLayout::DepthStencilAttachment : ResourceLayout::ColorAttachment;
+                attachments.EmplaceBack(AttachmentCreation{
+                    .texture = texture,
+                    .initialLayout = layout,
+                    .finalLayout = layout
+                });
+            }
+
+            if (passNode.setup.type == RenderGraphPassType::Graphics && !attachments.Empty())
+            {
+                passNode.renderPass = Graphics::CreateRenderPass(RenderPassCreation{
+                    .attachments = attachments
+                });
+                passNode.clearValues.Resize(attachments.Size(), Vec4{0, 0, 0, 1});
+            }
+        }
+    }
+
+    void RenderGraph::DestroyResources()
+    {
+        for (PassNode& passNode : m_passes)
+        {
+            if (passNode.renderPass)
+            {
+                Graphics::DestroyRenderPass(passNode.renderPass);
+                passNode.renderPass = {};
+            }
+        }
+
+        for (PhysicalTexture& physicalTexture : m_physicalTextures)
+        {
+            if (physicalTexture.texture)
+            {
+                Graphics::DestroyTexture(physicalTexture.texture);
+                physicalTexture.texture = {};
+            }
+        }
+    }
+
+    void RenderGraph::RecordBarriers(Span<Barrier> barriers, RenderCommands& cmd) const
+    {
+        for (const Barrier& barrier : barriers)
+        {
+            cmd.ResourceBarrier(ResourceBarrierInfo{
+                .texture = m_physicalTextures[barrier.physical].texture,
+                .oldLayout = barrier.oldLayout,
+                .newLayout = barrier.newLayout,
+                .isDepth = barrier.isDepth
+            });
+        }
+    }
+
+    void RenderGraph::Execute(RenderCommands& cmd)
+    {
+        for (u32 p : m_order)
+        {
+            PassNode& passNode = m_passes[p];
+
+            cmd.BeginLabel(passNode.name, Vec4{0, 0, 0, 1});
+            RecordBarriers(passNode.barriers, cmd);
+
+            if (passNode.renderPass)
+            {
+                cmd.BeginRenderPass(BeginRenderPassInfo{
+                    .renderPass = passNode.renderPass,
+                    .clearValues = passNode.clearValues
+                });
+
+                const Extent& extent = passNode.context.extent;
+
+                ViewportInfo viewportInfo{};
+                viewportInfo.width = static_cast<f32>(extent.width);
+                viewportInfo.height = static_cast<f32>(extent.height);
+                viewportInfo.maxDepth = 0.;
+                viewportInfo.minDepth = 1.;
+                cmd.SetViewport(viewportInfo);
+                cmd.SetScissor(Rect{.x = 0, .y = 0, .width = extent.width, .height = extent.height});
+            }
+
+            passNode.pass->Render(passNode.context, cmd);
+
+            if (passNode.renderPass)
+            {
+                cmd.EndRenderPass();
+            }
+
+            cmd.EndLabel();
+        }
+
+        RecordBarriers(m_finalBarriers, cmd);
+    }
+
     RenderGraph* RenderGraph::Create(const Extent& extent, RID renderGraphId)
     {
-        return nullptr;
+        RenderGraph* renderGraph = MemoryGlobals::GetDefaultAllocator().Alloc<RenderGraph>();
+        renderGraph->m_extent = extent;
+        if (renderGraphId)
+        {
+            renderGraph->Load(renderGraphId);
+            renderGraph->Compile();
+            renderGraph->CreateResources();
+        }
+        return renderGraph;
+    }
+
+    void RenderGraph::Destroy(RenderGraph* renderGraph)
+    {
+        MemoryGlobals::GetDefaultAllocator().DestroyAndFree(renderGraph);
     }
 }
@@ -1,22 +1,27 @@
 #pragma once
 #include "GraphicsTypes.hpp"
 #include "Fyrion/Core/Math.hpp"
+#include "Fyrion/Core/HashMap.hpp"
 
 
 namespace Fyrion
 {
+    class TypeHandler;
 
     struct RenderGraphPassAsset
     {
         constexpr static u32 Pass = 0;
+        constexpr static u32 Name = 1;
     };
 
+    //Origin is "pass.output" and Dest is "pass.input"
     struct RenderGraphEdgeAsset
     {
         constexpr static u32 Origin = 0;
         constexpr static u32 Dest = 1;
     };
 
+    //ColorOutput and DepthOutput are "pass.output"
     struct RenderGraphAsset
     {
         constexpr static u32 Passes = 0;
@@ -25,17 +30,150 @@ namespace Fyrion
         constexpr static u32 DepthOutput = 3;
     };
 
+    enum class RenderGraphPassType
+    {
+        Graphics,
+        Compute
+    };
+
+    struct RenderGraphTextureCreation
+    {
+        Format format{Format::RGBA};
+        Vec2   scale{1.0, 1.0};
+    };
+
+    struct RenderGraphPassSetup
+    {
+        RenderGraphPassType type{RenderGraphPassType::Graphics};
+        bool                sideEffects{};
+
+        Array<String>                                    inputs{};
+        Array<Pair<String, RenderGraphTextureCreation>> outputs{};
+
+        void Input(const StringView& name)
+        {
+            inputs.EmplaceBack(name);
+        }
+
+        void Output(const StringView& name, const RenderGraphTextureCreation& textureCreation)
+        {
+            outputs.EmplaceBack(Pair<String, RenderGraphTextureCreation>{name, textureCreation});
+        }
+    };
+
+    struct RenderGraphPassContext
+    {
+        Extent                   extent{};
+        HashMap<String, Texture> inputs{};
+        HashMap<String, Texture> outputs{};
+
+        Texture GetInput(const StringView& name) const
+        {
+            auto it = inputs.Find(name);
+            return it != inputs.end() ? it->second : Texture{};
+        }
+
+        Texture GetOutput(const StringView& name) const
+        {
+            auto it = outputs.Find(name);
+            return it != outputs.end() ? it->second : Texture{};
+        }
+    };
+
+    class FY_API RenderGraphPass
+    {
+    public:
+        virtual ~RenderGraphPass() = default;
+
+        virtual void Setup(RenderGraphPassSetup& setup) {}
+        virtual void Render(const RenderGraphPassContext& context, RenderCommands& cmd) {}
+    };
+
+    struct RenderGraphStats
+    {
+        u32   passes{};
+        u32   culledPasses{};
+        u32   transientTextures{};
+        u32   physicalTextures{};
+        u32   barriers{};
+        usize textureMemory{};
+        usize memorySaved{};
+    };
 
     class FY_API RenderGraph
     {
     public:
+        ~RenderGraph();
+
         Extent  GetViewportExtent();
         void    Resize(const Extent& extent);
         Texture GetColorOutput() const;
         Texture GetDepthOutput() const;
 
+        void                    Execute(RenderCommands& cmd);
+        const RenderGraphStats& GetStats() const;
+        Array<String>           GetExecutionOrder() const;
+
         static RenderGraph* Create(const Extent& extent, RID renderGraphId);
+        static void         Destroy(RenderGraph* renderGraph);
     private:
+        struct Barrier
+        {
+            u32            physical{};
+            ResourceLayout oldLayout{};
+            ResourceLayout newLayout{};
+            bool           isDepth{};
+        };
+
+        struct PassNode
+        {
+            String                     name{};
+            TypeHandler*               typeHandler{};
+            VoidPtr                    instance{};
+            RenderGraphPass*           pass{};
+            RenderGraphPassSetup       setup{};
+            Array<u32>                 inputs{};
+            Array<u32>                 outputs{};
+            Array<Barrier>             barriers{};
+            Array<Vec4>                clearValues{};
+            RenderPass                 renderPass{};
+            RenderGraphPassContext     context{};
+            bool                       alive{};
+        };
+
+        struct ResourceNode
+        {
+            String                     name{};
+            RenderGraphTextureCreation creation{};
+            TextureUsage               usage{};
+            u32                        producer{};
+            u32                        firstUse{};
+            u32                        lastUse{};
+            u32                        physical{U32_MAX};
+        };
+
+        struct PhysicalTexture
+        {
+            u32     resource{};
+            u32     lastUse{};
+            Texture texture{};
+        };
+
+        Extent                     m_extent{};
+        Array<PassNode>            m_passes{};
+        Array<u32>                 m_order{};
+        Array<ResourceNode>        m_resources{};
+        Array<PhysicalTexture>     m_physicalTextures{};
+        Array<Barrier>             m_finalBarriers{};
+        u32                        m_colorOutput{U32_MAX};
+        u32                        m_depthOutput{U32_MAX};
+        RenderGraphStats           m_stats{};
 
+        void            Load(RID renderGraphId);
+        void            Compile();
+        void            CreateResources();
+        void            DestroyResources();
+        void            RecordBarriers(Span<Barrier> barriers, RenderCommands& cmd) const;
+        TextureCreation GetTextureCreation(const ResourceNode& resource) const;
     };
 }
@@ -9,11 +9,26 @@
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <cstring>
 
 #include "spirv_reflect.h"
 #include "Fyrion/Core/Logger.hpp"
 #include "dxc/dxcapi.h"
 #include "Fyrion/Core/HashMap.hpp"
+#include "Fyrion/Core/Hash.hpp"
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/Path.hpp"
+#include "Fyrion/IO/FileTransaction.hpp"
+#include "Fyrion/Resource/ResourceAssets.hpp"
+#include "Fyrion/Resource/Repository.hpp"
+#include "Fyrion/Assets/AssetTypes.hpp"
+#include "Graphics.hpp"
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Core/Event.hpp"
 
 #define SHADER_MODEL "6_5"
 
@@ -33,9 +48,443 @@ namespace Fyrion
     {
         Logger&               logger = Logger::GetLogger("Fyrion::ShaderManager", LogLevel::Debug);
 
-        IDxcUtils*            utils{};
-        IDxcCompiler3*        compiler{};
-        DxcCreateInstanceProc dxcCreateInstance;
+        //DXC instances are not thread-safe, each compile takes one from the pool.
+        struct CompilerInstance
+        {
+            IDxcUtils*     utils{};
+            IDxcCompiler3* compiler{};
+        };
+
+        DxcCreateInstanceProc     dxcCreateInstance{};
+        std::mutex                compilerMutex{};
+        std::condition_variable   compilerCondition{};
+        Array<CompilerInstance*>  compilers{};
+        Array<CompilerInstance*>  freeCompilers{};
+        u32                       maxCompilers{};
+
+        String                compilerVersion{};
+        String                cacheDirectory{};
+        std::mutex            cacheMutex{};
+        struct ShaderDependency
+        {
+            String path{};
+            String hash{};
+        };
+
+        struct CachedShader
+        {
+            Array<u8>               bytes{};
+            Array<ShaderDependency> dependencies{};
+        };
+
+        HashMap<String, CachedShader> compiledShaders{};
+        HashMap<String, ShaderInfo> reflectedShaders{};
+        ShaderCacheStats            cacheStats{};
+
+        //variants of a shader asset by the mask of its enabled permutation keys, variants with the same code share the resource.
+        struct ShaderVariantTable
+        {
+            u32                  version{};
+            HashMap<u64, RID>    variantsByMask{};
+            HashMap<String, RID> variantsByCode{};
+            Array<RID>           variants{};
+        };
+
+        //variants replaced by a reload, destroyed when the frames that could still use them are completed.
+        struct RetiredVariant
+        {
+            RID rid{};
+            u64 frame{};
+        };
+
+        std::mutex                          variantMutex{};
+        HashMap<RID, ShaderVariantTable>    variantTables{};
+        Array<RetiredVariant>               retiredVariants{};
+
+        void CollectRetiredVariants()
+        {
+            std::unique_lock lock(variantMutex);
+            u64 frame = Engine::GetFrame();
+            u32 framesInFlight = Graphics::GetFramesInFlight();
+
+            usize i = 0;
+            while (i < retiredVariants.Size())
+            {
+                if (retiredVariants[i].frame + framesInFlight <= frame)
+                {
+                    Repository::DestroyResource(retiredVariants[i].rid);
+                    retiredVariants[i] = retiredVariants.Back();
+                    retiredVariants.PopBack();
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        String HashToString(const u64 hash[2])
+        {
+            char buffer[32];
+            for (u32 i = 0; i < 16; ++i)
+            {
+                buffer[i] = "0123456789abcdef"[(hash[0] >> (60 - i * 4)) & 0xF];
+                buffer[i + 16] = "0123456789abcdef"[(hash[1] >> (60 - i * 4)) & 0xF];
+            }
+            return String{buffer, 32};
+        }
+
+        StringView GetTargetEnv(RenderApiType renderApi)
+        {
+            return renderApi != RenderApiType::D3D12 ? "vulkan1.2" : "dxil";
+        }
+
+        String GetShaderCacheKey(const ShaderCreation& shaderCreation)
+        {
+            StringView target = GetTargetEnv(shaderCreation.renderApi);
+
+            String key{};
+            key.Append(shaderCreation.source.begin(), shaderCreation.source.end());
+            key.Append('\n');
+            key.Append(shaderCreation.entryPoint.begin(), shaderCreation.entryPoint.end());
+            key.Append('\n');
+            key.Append(static_cast<u32>(shaderCreation.shaderStage));
+            key.Append('\n');
+            key.Append(target.begin(), target.end());
+            key.Append('\n');
+            for (const String& define : shaderCreation.defines)
+            {
+                key.Append(define);
+                key.Append(';');
+            }
+            key.Append('\n');
+            key.Append(compilerVersion);
+            key.Append('\n');
+
+            //includes are resolved relative to the shader, same sources on other directories can include other files.
+            if (!shaderCreation.path.Empty())
+            {
+                std::string path = std::filesystem::path(String{shaderCreation.path}.CStr()).lexically_normal().generic_string();
+                key.Append(path.c_str(), path.c_str() + path.size());
+            }
+
+            u64 hash[2];
+            MurmurHash3X64128(key.CStr(), static_cast<u32>(key.Size()), 0, hash);
+            return HashToString(hash);
+        }
+
+        String GetShaderCachePath(const StringView& key, const StringView& extension)
+        {
+            return Path::Join(cacheDirectory, key, extension);
+        }
+
+        String HashContents(const StringView& contents)
+        {
+            u64 hash[2];
+            MurmurHash3X64128(contents.Data(), static_cast<u32>(contents.Size()), 0, hash);
+            return HashToString(hash);
+        }
+
+        //a cached shader is valid only while all the files it included have the same contents.
+        bool IsDependenciesValid(const Array<ShaderDependency>& dependencies)
+        {
+            for (const ShaderDependency& dependency : dependencies)
+            {
+                if (HashContents(FileSystem::ReadFileAsString(dependency.path)) != dependency.hash)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //one dependency per line, "<hash> <path>".
+        Array<ShaderDependency> ParseDependencies(const StringView& buffer)
+        {
+            Array<ShaderDependency> dependencies{};
+            usize start = 0;
+            while (start < buffer.Size())
+            {
+                usize end = start;
+                while (end < buffer.Size() && buffer[end] != '\n') end++;
+
+                StringView line = buffer.Substr(start, end - start);
+                if (line.Size() > 33)
+                {
+                    dependencies.EmplaceBack(ShaderDependency{
+                        .path = line.Substr(33),
+                        .hash = line.Substr(0, 32)
+                    });
+                }
+                start = end + 1;
+            }
+            return dependencies;
+        }
+
+        void AddDependencies(const Array<ShaderDependency>& dependencies, Array<String>* files)
+        {
+            if (!files) return;
+
+            for (const ShaderDependency& dependency : dependencies)
+            {
+                bool found = false;
+                for (const String& file : *files)
+                {
+                    if (file == dependency.path)
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    files->EmplaceBack(dependency.path);
+                }
+            }
+        }
+
+        bool WriteCacheFile(const StringView& path, ConstPtr data, usize size)
+        {
+            //written to a temp file and renamed, a concurrent reader never sees a partial file.
+            String tempPath = String{path} + FY_TEMP_EXTENSION;
+            FileHandler fileHandler = FileSystem::OpenFile(tempPath, AccessMode::WriteOnly);
+            if (fileHandler)
+            {
+                bool written = FileSystem::WriteFile(fileHandler, data, size) == size;
+                FileSystem::CloseFile(fileHandler);
+                if (written && FileSystem::Rename(tempPath, path))
+                {
+                    return true;
+                }
+                FileSystem::Remove(tempPath);
+            }
+            logger.Warn("Failed to write shader cache {}", path);
+            return false;
+        }
+
+        bool FindCachedShader(const String& key, Array<u8>& bytes, Array<String>* dependencies)
+        {
+            CachedShader cached{};
+            bool         found = false;
+            {
+                std::unique_lock lock(cacheMutex);
+                if (auto it = compiledShaders.Find(key))
+                {
+                    cached = it->second;
+                    found = true;
+                }
+            }
+
+            if (found)
+            {
+                if (!IsDependenciesValid(cached.dependencies))
+                {
+                    std::unique_lock lock(cacheMutex);
+                    cacheStats.invalidations++;
+                    return false;
+                }
+
+                bytes.Insert(bytes.end(), cached.bytes.begin(), cached.bytes.end());
+                AddDependencies(cached.dependencies, dependencies);
+
+                std::unique_lock lock(cacheMutex);
+                cacheStats.memoryHits++;
+                return true;
+            }
+
+            String path = GetShaderCachePath(key, ".spv");
+            if (!FileSystem::GetFileStatus(path).exists)
+            {
+                return false;
+            }
+
+            cached.bytes = FileSystem::ReadFileAsByteArray(path);
+            if (cached.bytes.Empty())
+            {
+                return false;
+            }
+
+            String dependenciesPath = GetShaderCachePath(key, ".deps");
+            if (FileSystem::GetFileStatus(dependenciesPath).exists)
+            {
+                cached.dependencies = ParseDependencies(FileSystem::ReadFileAsString(dependenciesPath));
+            }
+
+            if (!IsDependenciesValid(cached.dependencies))
+            {
+                std::unique_lock lock(cacheMutex);
+                cacheStats.invalidations++;
+                return false;
+            }
+
+            bytes.Insert(bytes.end(), cached.bytes.begin(), cached.bytes.end());
+            AddDependencies(cached.dependencies, dependencies);
+
+            std::unique_lock lock(cacheMutex);
+            if (auto it = compiledShaders.Find(key))
+            {
+                it->second = Traits::Move(cached);
+            }
+            else
+            {
+                compiledShaders.Insert(key, Traits::Move(cached));
+            }
+            cacheStats.diskHits++;
+            return true;
+        }
+
+        void StoreCachedShader(const String& key, Span<u8> bytes, const Array<ShaderDependency>& dependencies)
+        {
+            {
+                std::unique_lock lock(cacheMutex);
+                CachedShader cached{Array<u8>{bytes}, dependencies};
+                if (auto it = compiledShaders.Find(key))
+                {
+                    it->second = Traits::Move(cached);
+                }
+                else
+                {
+                    compiledShaders.Insert(key, Traits::Move(cached));
+                }
+                cacheStats.compiles++;
+            }
+
+            if (!FileSystem::GetFileStatus(cacheDirectory).exists)
+            {
+                FileSystem::CreateDirectory(cacheDirectory);
+            }
+
+            //dependencies go first, a .spv on disk always has its dependencies next to it.
+            String dependenciesPath = GetShaderCachePath(key, ".deps");
+            if (!dependencies.Empty())
+            {
+                String buffer{};
+                for (const ShaderDependency& dependency : dependencies)
+                {
+                    buffer.Append(dependency.hash);
+                    buffer.Append(' ');
+                    buffer.Append(dependency.path);
+                    buffer.Append('\n');
+                }
+
+                if (!WriteCacheFile(dependenciesPath, buffer.CStr(), buffer.Size()))
+                {
+                    return;
+                }
+            }
+            else if (FileSystem::GetFileStatus(dependenciesPath).exists)
+            {
+                FileSystem::Remove(dependenciesPath);
+            }
+
+            WriteCacheFile(GetShaderCachePath(key, ".spv"), bytes.Data(), bytes.Size());
+        }
+
+        String ToString(LPCWSTR str)
+        {
+            String ret{};
+            for (; *str != 0; ++str)
+            {
+                ret.Append(static_cast<char>(*str));
+            }
+            return ret;
+        }
+
+        //includes are searched relative to the including file, "Name://path" resolves through the asset root with that name.
+        String ResolveIncludePath(const StringView& fileName)
+        {
+            String path = fileName;
+            usize separator = path.Find(':');
+            if (separator != nPos && separator + 2 < path.Size() && path[separator + 1] == '/' && path[separator + 2] == '/')
+            {
+                usize nameStart = separator;
+                while (nameStart > 0 && path[nameStart - 1] != '/' && path[nameStart - 1] != '\\')
+                {
+                    nameStart--;
+                }
+
+                StringView rootName = StringView{path}.Substr(nameStart, separator - nameStart);
+                RID root = ResourceAssets::GetAssetRootByName(rootName);
+                if (!root)
+                {
+                    return {};
+                }
+                path = Path::Join(ResourceAssets::GetAbsolutePath(root), StringView{path}.Substr(separator + 3));
+            }
+
+            std::filesystem::path normalized = std::filesystem::path(path.CStr()).lexically_normal();
+            std::string str = normalized.generic_string();
+            return String{str.c_str(), str.size()};
+        }
+
+        class IncludeHandler : public IDxcIncludeHandler
+        {
+        public:
+            IncludeHandler(IDxcUtils* utils, Array<ShaderDependency>& dependencies) : m_utils(utils), m_dependencies(dependencies) {}
+
+            HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource) override
+            {
+                *ppIncludeSource = nullptr;
+
+                String path = ResolveIncludePath(ToString(pFilename));
+                if (path.Empty() || !FileSystem::GetFileStatus(path).exists)
+                {
+                    logger.Error("Shader include {} not found", ToString(pFilename));
+                    return E_FAIL;
+                }
+
+                String source = FileSystem::ReadFileAsString(path);
+
+                bool found = false;
+                for (const ShaderDependency& dependency : m_dependencies)
+                {
+                    if (dependency.path == path)
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    m_dependencies.EmplaceBack(ShaderDependency{.path = path, .hash = HashContents(source)});
+                }
+
+                IDxcBlobEncoding* blob{};
+                HRESULT result = m_utils->CreateBlob(source.CStr(), source.Size(), CP_UTF8, &blob);
+                *ppIncludeSource = blob;
+                return result;
+            }
+
+            HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+            {
+                IID includeHandler = __uuidof(IDxcIncludeHandler);
+                IID unknown = __uuidof(IUnknown);
+                if (memcmp(&riid, &includeHandler, sizeof(IID)) == 0 || memcmp(&riid, &unknown, sizeof(IID)) == 0)
+                {
+                    *ppvObject = this;
+                    return S_OK;
+                }
+                *ppvObject = nullptr;
+                return E_NOINTERFACE;
+            }
+
+            //lives on the stack of the compile.
+            ULONG STDMETHODCALLTYPE AddRef() override
+            {
+                return 1;
+            }
+
+            ULONG STDMETHODCALLTYPE Release() override
+            {
+                return 1;
+            }
+
+        private:
+            IDxcUtils*               m_utils;
+            Array<ShaderDependency>& m_dependencies;
+        };
     }
 
     constexpr auto GetShaderStage(ShaderStage shader)
@@ -66,28 +515,117 @@ namespace Fyrion
     }
 
 
-    void ShaderManagerInit()
+    CompilerInstance* CreateCompilerInstance()
     {
-        VoidPtr instance = Platform::LoadDynamicLib("dxcompiler");
-        if (instance)
+        CompilerInstance* instance = MemoryGlobals::GetDefaultAllocator().Alloc<CompilerInstance>();
+        dxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&instance->utils));
+        dxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&instance->compiler));
+        return instance;
+    }
+
+    void DestroyCompilerInstance(CompilerInstance* instance)
+    {
+        if (instance->utils)
+        {
+            instance->utils->Release();
+        }
+
+        if (instance->compiler)
         {
-            dxcCreateInstance = reinterpret_cast<DxcCreateInstanceProc>(Platform::GetFunctionAddress(instance, "DxcCreateInstance"));
-            dxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils));
-            dxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler));
+            instance->compiler->Release();
         }
+        MemoryGlobals::GetDefaultAllocator().DestroyAndFree(instance);
     }
 
-    bool ShaderManager::CompileShader(const ShaderCreation& shaderCreation, Array<u8>& bytes)
+    //instances are created on demand up to the worker count, after that the caller waits for a free one.
+    CompilerInstance* AcquireCompiler()
     {
-        bool shaderCompilerValid = utils && compiler;
-        if (!shaderCompilerValid)
+        std::unique_lock lock(compilerMutex);
+        compilerCondition.wait(lock, []
         {
-            logger.Warn("DxShaderCompiler not loaded");
-            return false;
+            return !freeCompilers.Empty() || compilers.Size() < maxCompilers;
+        });
+
+        if (!freeCompilers.Empty())
+        {
+            CompilerInstance* instance = freeCompilers.Back();
+            freeCompilers.PopBack();
+            return instance;
+        }
+
+        CompilerInstance* instance = CreateCompilerInstance();
+        compilers.EmplaceBack(instance);
+        return instance;
+    }
+
+    void ReleaseCompiler(CompilerInstance* instance)
+    {
+        {
+            std::unique_lock lock(compilerMutex);
+            freeCompilers.EmplaceBack(instance);
+        }
+        compilerCondition.notify_one();
+    }
+
+    void ShaderManagerInit()
+    {
+        Event::Bind<OnEndFrame, &CollectRetiredVariants>();
+
+        VoidPtr library = Platform::LoadDynamicLib("dxcompiler");
+        if (library)
+        {
+            dxcCreateInstance = reinterpret_cast<DxcCreateInstanceProc>(Platform::GetFunctionAddress(library, "DxcCreateInstance"));
+        }
+
+        if (dxcCreateInstance)
+        {
+            maxCompilers = Parallel::GetWorkerCount();
+
+            CompilerInstance* instance = CreateCompilerInstance();
+            compilers.EmplaceBack(instance);
+            freeCompilers.EmplaceBack(instance);
+
+            IDxcCompiler3* compiler = instance->compiler;
+            IDxcVersionInfo* versionInfo{};
+            if (compiler && SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&versionInfo))))
+            {
+                u32 major{}, minor{};
+                versionInfo->GetVersion(&major, &minor);
+                compilerVersion.Append(major);
+                compilerVersion.Append('.');
+                compilerVersion.Append(minor);
+
+                IDxcVersionInfo2* versionInfo2{};
+                if (SUCCEEDED(versionInfo->QueryInterface(IID_PPV_ARGS(&versionInfo2))))
+                {
+                    u32   commitCount{};
+                    char* commitHash{};
+                    versionInfo2->GetCommitInfo(&commitCount, &commitHash);
+                    compilerVersion.Append('.');
+                    compilerVersion.Append(commitCount);
+                    if (commitHash)
+                    {
+                        compilerVersion.Append('.');
+                        compilerVersion.Append(static_cast<const char*>(commitHash));
+                        CoTaskMemFree(commitHash);
+                    }
+                    versionInfo2->Release();
+                }
+                versionInfo->Release();
+            }
+            logger.Debug("DxShaderCompiler version {}", compilerVersion);
         }
 
+        if (cacheDirectory.Empty())
+        {
+            cacheDirectory = Path::Join(FileSystem::CurrentDir(), "ShaderCache");
+        }
+    }
+
+    bool CompileShaderWithInstance(CompilerInstance* instance, const ShaderCreation& shaderCreation, Array<u8>& bytes, Array<ShaderDependency>& dependencies)
+    {
         IDxcBlobEncoding* pSource = {};
-        utils->CreateBlob(shaderCreation.source.CStr(), shaderCreation.source.Size(), CP_UTF8, &pSource);
+        instance->utils->CreateBlob(shaderCreation.source.CStr(), shaderCreation.source.Size(), CP_UTF8, &pSource);
 
         DxcBuffer source{};
         source.Ptr = pSource->GetBufferPointer();
@@ -95,8 +633,14 @@ namespace Fyrion
         source.Encoding = DXC_CP_ACP;
 
         std::wstring entryPoint = std::wstring{shaderCreation.entryPoint.begin(), shaderCreation.entryPoint.end()};
+        std::wstring sourcePath = std::wstring{shaderCreation.path.begin(), shaderCreation.path.end()};
 
         Array<LPCWSTR> args;
+        if (!sourcePath.empty())
+        {
+            //the source name is the base for relative includes.
+            args.EmplaceBack(sourcePath.c_str());
+        }
         args.EmplaceBack(L"-E");
         args.EmplaceBack(entryPoint.c_str());
         args.EmplaceBack(L"-Wno-ignored-attributes");
@@ -110,23 +654,42 @@ namespace Fyrion
             args.EmplaceBack(L"-fspv-target-env=vulkan1.2");
         }
 
+        Array<std::wstring> defines{};
+        defines.Reserve(shaderCreation.defines.Size());
+        for (const String& define : shaderCreation.defines)
+        {
+            defines.EmplaceBack(define.begin(), define.end());
+            args.EmplaceBack(L"-D");
+            args.EmplaceBack(defines.Back().c_str());
+        }
+
         IDxcResult* pResults{};
-        //IncludeHandler includeHandler{rid};
-        compiler->Compile(&source, args.Data(), args.Size(), nullptr, IID_PPV_ARGS(&pResults));
+        IncludeHandler includeHandler{instance->utils, dependencies};
+        instance->compiler->Compile(&source, args.Data(), args.Size(), &includeHandler, IID_PPV_ARGS(&pResults));
 
         IDxcBlobUtf8* pErrors = {};
         pResults->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&pErrors), nullptr);
         if (pErrors != nullptr && pErrors->GetStringLength() != 0)
         {
             logger.Error("Error on compile shader {} ", pErrors->GetStringPointer());
+            pErrors->Release();
+            pResults->Release();
+            pSource->Release();
             return false;
         }
 
+        if (pErrors)
+        {
+            pErrors->Release();
+        }
+
         HRESULT hrStatus;
         pResults->GetStatus(&hrStatus);
         if (FAILED(hrStatus))
         {
             logger.Error("Compilation Failed ");
+            pResults->Release();
+            pSource->Release();
             return false;
         }
 
@@ -154,6 +717,36 @@ namespace Fyrion
         return true;
     }
 
+    bool ShaderManager::CompileShader(const ShaderCreation& shaderCreation, Array<u8>& bytes, Array<String>* dependencies)
+    {
+        bool shaderCompilerValid = !compilers.Empty() && compilers[0]->utils && compilers[0]->compiler;
+        if (!shaderCompilerValid)
+        {
+            logger.Warn("DxShaderCompiler not loaded");
+            return false;
+        }
+
+        String cacheKey = GetShaderCacheKey(shaderCreation);
+        if (FindCachedShader(cacheKey, bytes, dependencies))
+        {
+            return true;
+        }
+
+        usize offset = bytes.Size();
+        Array<ShaderDependency> shaderDependencies{};
+
+        CompilerInstance* instance = AcquireCompiler();
+        bool result = CompileShaderWithInstance(instance, shaderCreation, bytes, shaderDependencies);
+        ReleaseCompiler(instance);
+
+        if (result)
+        {
+            StoreCachedShader(cacheKey, Span<u8>{bytes.Data() + offset, bytes.Data() + bytes.Size()}, shaderDependencies);
+            AddDependencies(shaderDependencies, dependencies);
+        }
+        return result;
+    }
+
     namespace SpirvUtils
     {
 
@@ -410,6 +1003,32 @@ namespace Fyrion
 
     ShaderInfo ShaderManager::ExtractShaderInfo(const Span<u8>& bytes, const Span<ShaderStageInfo>& stages, RenderApiType renderApi)
     {
+        //the reflection depends only on the compiled bytes and how they are split in stages.
+        String key{};
+        {
+            u64 hash[2];
+            MurmurHash3X64128(bytes.Data(), static_cast<u32>(bytes.Size()), static_cast<u32>(renderApi), hash);
+            key.Append(HashToString(hash));
+            for (const ShaderStageInfo& stageInfo : stages)
+            {
+                key.Append(':');
+                key.Append(static_cast<u32>(stageInfo.stage));
+                key.Append(':');
+                key.Append(stageInfo.offset);
+                key.Append(':');
+                key.Append(stageInfo.size);
+            }
+        }
+
+        {
+            std::unique_lock lock(cacheMutex);
+            if (auto it = reflectedShaders.Find(key))
+            {
+                cacheStats.reflectionHits++;
+                return it->second;
+            }
+        }
+
         ShaderInfo shaderInfo;
 
         if (renderApi != RenderApiType::D3D12)
@@ -537,21 +1156,272 @@ namespace Fyrion
             SortAndAddDescriptors(shaderInfo, descriptors);
 
         }
+
+        std::unique_lock lock(cacheMutex);
+        reflectedShaders.Insert(key, shaderInfo);
+
         return shaderInfo;
     }
 
-    void ShaderManagerShutdown()
+    void ShaderManager::SetCacheDirectory(const StringView& directory)
+    {
+        std::unique_lock lock(cacheMutex);
+        cacheDirectory = directory;
+    }
+
+    StringView ShaderManager::GetCacheDirectory()
+    {
+        return cacheDirectory;
+    }
+
+    void ShaderManager::ClearCache()
+    {
+        std::unique_lock lock(cacheMutex);
+        compiledShaders.Clear();
+        reflectedShaders.Clear();
+    }
+
+    ShaderCacheStats ShaderManager::GetCacheStats()
+    {
+        std::unique_lock lock(cacheMutex);
+        return cacheStats;
+    }
+
+    bool ShaderManager::CompileShaderStages(const StringView& source, const StringView& path, RenderApiType renderApi, const Span<String>& defines,
+                                            Span<ShaderStageInfo> stages, Array<u8>& bytes, Array<String>* dependencies)
     {
-        if (utils)
+        //stages are compiled in parallel into their own buffers and merged afterwards.
+        Array<Array<u8>>     stageBytes(stages.Size());
+        Array<Array<String>> stageDependencies(stages.Size());
+        Array<u8>            stageResults(stages.Size());
+
+        Parallel::For(stages.Size(), 0, [&](usize index)
+        {
+            stageResults[index] = CompileShader(ShaderCreation{
+                                                    .source = source,
+                                                    .entryPoint = stages[index].entryPoint,
+                                                    .shaderStage = stages[index].stage,
+                                                    .renderApi = renderApi,
+                                                    .path = path,
+                                                    .defines = defines
+                                                }, stageBytes[index], &stageDependencies[index]);
+        });
+
+        bool result = true;
+        for (usize i = 0; i < stages.Size(); ++i)
+        {
+            result &= stageResults[i] != 0;
+
+            stages[i].offset = static_cast<u32>(bytes.Size());
+            stages[i].size = static_cast<u32>(stageBytes[i].Size());
+            bytes.Insert(bytes.end(), stageBytes[i].begin(), stageBytes[i].end());
+
+            if (dependencies)
+            {
+                for (const String& dependency : stageDependencies[i])
+                {
+                    if (FindFirst(dependencies->begin(), dependencies->end(), dependency) == nullptr)
+                    {
+                        dependencies->EmplaceBack(dependency);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    Array<String> ShaderManager::ParsePermutations(String& source)
+    {
+        constexpr StringView directive = "#pragma permutation ";
+
+        Array<String> keys{};
+        usize start = 0;
+        while (start < source.Size())
+        {
+            usize end = start;
+            while (end < source.Size() && source[end] != '\n') end++;
+
+            usize first = start;
+            while (first < end && (source[first] == ' ' || source[first] == '\t')) first++;
+
+            StringView line = StringView{source}.Substr(first, end - first);
+            if (line.StartsWith(directive))
+            {
+                StringView key = line.Substr(directive.Size());
+                usize keyEnd = 0;
+                while (keyEnd < key.Size() && key[keyEnd] != ' ' && key[keyEnd] != '\t' && key[keyEnd] != '\r') keyEnd++;
+                key = key.Substr(0, keyEnd);
+
+                if (!key.Empty() && FindFirst(keys.begin(), keys.end(), String{key}) == nullptr)
+                {
+                    keys.EmplaceBack(key);
+                }
+
+                //blanked instead of removed, error lines stay the same.
+                for (usize i = first; i < end; ++i)
+                {
+                    source[i] = ' ';
+                }
+            }
+            start = end + 1;
+        }
+
+        FY_ASSERT(keys.Size() <= 64, "shaders support up to 64 permutation keys");
+        return keys;
+    }
+
+    Array<String> ShaderManager::GetPermutationDefines(const Span<String>& keys, u64 mask)
+    {
+        Array<String> defines{};
+        defines.Reserve(keys.Size());
+        for (usize i = 0; i < keys.Size(); ++i)
         {
-            utils->Release();
-            utils = nullptr;
+            String define = keys[i];
+            define.Append((mask & (1ull << i)) != 0 ? "=1" : "=0");
+            defines.EmplaceBack(Traits::Move(define));
         }
+        return defines;
+    }
+
+    RID ShaderManager::GetShaderVariant(RID shader, const Span<String>& enabledKeys)
+    {
+        ResourceObject shaderObject = Repository::Read(shader);
+        if (!shaderObject)
+        {
+            return {};
+        }
+
+        Span<String> keys = shaderObject[ShaderAsset::Permutations].Value<Span<String>>();
+
+        u64 mask = 0;
+        for (const String& enabledKey : enabledKeys)
+        {
+            usize index = FindFirstIndex(keys.begin(), keys.end(), enabledKey);
+            if (index != nPos)
+            {
+                mask |= 1ull << index;
+            }
+        }
+
+        //the asset itself is the variant with all keys disabled.
+        if (mask == 0 || keys.Empty())
+        {
+            return shader;
+        }
+
+        u32 version = Repository::GetVersion(shader);
+        {
+            std::unique_lock lock(variantMutex);
+            auto it = variantTables.Find(shader);
+            if (it != variantTables.end() && it->second.version == version)
+            {
+                if (auto itVariant = it->second.variantsByMask.Find(mask))
+                {
+                    return itVariant->second;
+                }
+            }
+        }
+
+        //compiled without the lock, a variant requested twice at the same time is deduplicated by its code.
+        String path = shaderObject[ShaderAsset::Path].Value<StringView>();
+        String source = FileSystem::ReadFileAsString(path);
+        ParsePermutations(source);
+
+        Array<ShaderStageInfo> stages = shaderObject[ShaderAsset::Stages].As<Array<ShaderStageInfo>>();
+        Array<String>          defines = GetPermutationDefines(keys, mask);
+        RenderApiType          renderApi = Graphics::GetRenderApi();
+
+        Array<u8> bytes{};
+        if (!CompileShaderStages(source, path, renderApi, defines, stages, bytes, nullptr))
+        {
+            logger.Error("Failed to compile variant {} of {}", mask, path);
+            return {};
+        }
+
+        u64 hash[2];
+        MurmurHash3X64128(bytes.Data(), static_cast<u32>(bytes.Size()), 0, hash);
+        String codeHash = HashToString(hash);
+
+        std::unique_lock lock(variantMutex);
+        auto it = variantTables.Find(shader);
+        if (it == variantTables.end())
+        {
+            it = variantTables.Insert(shader, ShaderVariantTable{}).first;
+        }
+
+        ShaderVariantTable& table = it->second;
+        if (table.version != version)
+        {
+            //the asset was reloaded, old variants may still be used by frames in flight.
+            for (RID variant : table.variants)
+            {
+                retiredVariants.EmplaceBack(RetiredVariant{.rid = variant, .frame = Engine::GetFrame()});
+            }
+            table = ShaderVariantTable{.version = version};
+        }
+
+        RID variant{};
+        if (auto itCode = table.variantsByCode.Find(codeHash))
+        {
+            variant = itCode->second;
+        }
+        else
+        {
+            Span<u8> shaderBytes = shaderObject[ShaderAsset::Bytes].Value<Span<u8>>();
+            MurmurHash3X64128(shaderBytes.Data(), static_cast<u32>(shaderBytes.Size()), 0, hash);
+            if (HashToString(hash) == codeHash)
+            {
+                variant = shader;
+            }
+            else
+            {
+                variant = Repository::CreateResource<ShaderAsset>();
+                ResourceObject write = Repository::Write(variant);
+                write[ShaderAsset::Bytes] = bytes;
+                write[ShaderAsset::Info] = ExtractShaderInfo(bytes, stages, renderApi);
+                write[ShaderAsset::Stages] = stages;
+                write[ShaderAsset::Permutations] = Array<String>{keys};
+                write[ShaderAsset::Path] = path;
+                write.Commit();
+                table.variants.EmplaceBack(variant);
+            }
+            table.variantsByCode.Insert(codeHash, variant);
+        }
+
+        table.variantsByMask.Insert(mask, variant);
+        return variant;
+    }
+
+    u32 ShaderManager::GetShaderVariantCount(RID shader)
+    {
+        std::unique_lock lock(variantMutex);
+        if (auto it = variantTables.Find(shader))
+        {
+            if (it->second.version == Repository::GetVersion(shader))
+            {
+                return static_cast<u32>(it->second.variants.Size());
+            }
+        }
+        return 0;
+    }
+
+    void ShaderManagerShutdown()
+    {
+        variantTables.Clear();
+        retiredVariants.Clear();
 
-        if (compiler)
+        for (CompilerInstance* instance : compilers)
         {
-            compiler->Release();
-            compiler = nullptr;
+            DestroyCompilerInstance(instance);
         }
+        compilers.Clear();
+        freeCompilers.Clear();
+        dxcCreateInstance = nullptr;
+
+        compilerVersion.Clear();
+        cacheDirectory.Clear();
+        compiledShaders.Clear();
+        reflectedShaders.Clear();
+        cacheStats = {};
     }
 }
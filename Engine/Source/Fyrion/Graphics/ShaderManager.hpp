@@ -3,8 +3,41 @@
 #include "GraphicsTypes.hpp"
 #include "Fyrion/Common.hpp"
 
+namespace Fyrion
+{
+    struct ShaderCacheStats
+    {
+        u64 memoryHits{};
+        u64 diskHits{};
+        u64 compiles{};
+        u64 reflectionHits{};
+        u64 invalidations{};
+    };
+}
+
 namespace Fyrion::ShaderManager
 {
-    FY_API bool       CompileShader(const ShaderCreation& shaderCreation, Array<u8>& bytes);
-    FY_API ShaderInfo ExtractShaderInfo(const Span<u8>& bytes, const Span<ShaderStageInfo>& stages, RenderApiType renderApi);
+    //compiled shaders are cached in memory and on disk, keyed by the source, entry point, stage, target and DXC version.
+    //included files are recorded as dependencies, a cached shader is compiled again when any of them changes.
+    FY_API bool             CompileShader(const ShaderCreation& shaderCreation, Array<u8>& bytes, Array<String>* dependencies = nullptr);
+    FY_API ShaderInfo       ExtractShaderInfo(const Span<u8>& bytes, const Span<ShaderStageInfo>& stages, RenderApiType renderApi);
+
+    //compiles all stages in parallel into one buffer, offset and size of each stage are written back to stages.
+    FY_API bool             CompileShaderStages(const StringView& source, const StringView& path, RenderApiType renderApi, const Span<String>& defines,
+                                                Span<ShaderStageInfo> stages, Array<u8>& bytes, Array<String>* dependencies = nullptr);
+
+    //permutation keys are declared in the source with "#pragma permutation KEY", the lines are blanked in source.
+    //each key is defined as KEY=1 when enabled or KEY=0 when disabled.
+    FY_API Array<String>    ParsePermutations(String& source);
+    FY_API Array<String>    GetPermutationDefines(const Span<String>& keys, u64 mask);
+
+    //variants are compiled on first request and reused, the asset itself is the variant with all keys disabled.
+    FY_API RID              GetShaderVariant(RID shader, const Span<String>& enabledKeys);
+    FY_API u32              GetShaderVariantCount(RID shader);
+
+    FY_API void             SetCacheDirectory(const StringView& directory);
+    FY_API StringView       GetCacheDirectory();
+    //clears the in-memory cache, the disk cache is kept.
+    FY_API void             ClearCache();
+    FY_API ShaderCacheStats GetCacheStats();
 }
@@ -0,0 +1,492 @@
+#include "AsyncIO.hpp"
+#include "FileSystem.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/Math.hpp"
+#include "Fyrion/Core/Algorithm.hpp"
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace Fyrion
+{
+    VoidPtr AsyncIONativeCreate(u32 entries);
+    bool    AsyncIONativeSubmit(VoidPtr native, const StringView& path, u64 offset, Span<AsyncIOBuffer> buffers, VoidPtr userData);
+    bool    AsyncIONativeComplete(VoidPtr native, Array<AsyncIOCompletion>& completions);
+    void    AsyncIONativeDestroy(VoidPtr native);
+
+#ifndef FY_LINUX
+    VoidPtr AsyncIONativeCreate(u32 entries)
+    {
+        return nullptr;
+    }
+
+    bool AsyncIONativeSubmit(VoidPtr native, const StringView& path, u64 offset, Span<AsyncIOBuffer> buffers, VoidPtr userData)
+    {
+        return false;
+    }
+
+    bool AsyncIONativeComplete(VoidPtr native, Array<AsyncIOCompletion>& completions)
+    {
+        return false;
+    }
+
+    void AsyncIONativeDestroy(VoidPtr native) {}
+#endif
+
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::AsyncIO");
+
+        constexpr u32   QueueDepth = 64;
+        constexpr u32   MaxWorkers = 4;
+        constexpr u32   PriorityCount = 3;
+        constexpr usize MaxBatchSize = 8 * 1024 * 1024;
+        constexpr usize MaxBatchRequests = 64;
+
+        struct Request
+        {
+            u64          id{};
+            String       path{};
+            u64          offset{};
+            usize        size{};
+            VoidPtr      buffer{};
+            VoidPtr      userData{};
+            FnIOCallback callback{};
+        };
+
+        //adjacent requests of the same file, sorted by offset.
+        struct Batch
+        {
+            String          path{};
+            u64             offset{};
+            usize           size{};
+            Array<Request*> requests{};
+        };
+
+        Allocator&              allocator = MemoryGlobals::GetDefaultAllocator();
+        std::mutex              mutex{};
+        std::condition_variable condition{};
+        std::condition_variable idleCondition{};
+        Array<std::thread>      threads{};
+        Array<Request*>         queues[PriorityCount]{};
+        VoidPtr                 native{};
+        bool                    nativeFailed{};
+        bool                    initialized{};
+        bool                    shutdown{};
+        u64                     nextId{1};
+        AsyncIOStats            stats{};
+        f64                     windowStart{};
+        u64                     windowBytes{};
+
+        void UpdateThroughput(f64 now)
+        {
+            f64 elapsed = now - windowStart;
+            if (elapsed >= 1.0)
+            {
+                stats.bytesPerSecond = static_cast<f64>(windowBytes) / elapsed;
+                windowBytes = 0;
+                windowStart = now;
+            }
+        }
+
+        //called with the mutex locked.
+        Batch* PopBatch()
+        {
+            Request* first = nullptr;
+            for (i32 p = PriorityCount - 1; p >= 0 && first == nullptr; --p)
+            {
+                if (!queues[p].Empty())
+                {
+                    first = queues[p][0];
+                    queues[p].Remove(0);
+                }
+            }
+
+            if (first == nullptr)
+            {
+                return nullptr;
+            }
+
+            Batch* batch = allocator.Alloc<Batch>();
+            batch->path = first->path;
+            batch->offset = first->offset;
+            batch->size = first->size;
+            batch->requests.EmplaceBack(first);
+
+            //neighbours are merged regardless of their priority, a low priority neighbour is read for free.
+            bool merged = true;
+            while (merged && batch->requests.Size() < MaxBatchRequests)
+            {
+                merged = false;
+                for (u32 p = 0; p < PriorityCount && !merged; ++p)
+                {
+                    for (usize i = 0; i < queues[p].Size(); ++i)
+                    {
+                        Request* request = queues[p][i];
+                        if (request->path != batch->path || batch->size + request->size > MaxBatchSize)
+                        {
+                            continue;
+                        }
+
+                        if (request->offset == batch->offset + batch->size)
+                        {
+                            batch->requests.EmplaceBack(request);
+                        }
+                        else if (request->offset + request->size == batch->offset)
+                        {
+                            batch->requests.Insert(batch->requests.begin(), &request, &request + 1);
+                            batch->offset = request->offset;
+                        }
+                        else
+                        {
+                            continue;
+                        }
+
+                        batch->size += request->size;
+                        queues[p].Remove(i);
+                        stats.coalesced++;
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+
+            stats.queued -= batch->requests.Size();
+            stats.inFlight += batch->requests.Size();
+
+            return batch;
+        }
+
+        void CompleteBatch(Batch* batch, i64 result)
+        {
+            usize remaining = result > 0 ? static_cast<usize>(result) : 0;
+
+            {
+                std::unique_lock lock(mutex);
+                stats.completed += batch->requests.Size();
+                stats.bytesRead += remaining;
+                windowBytes += remaining;
+                UpdateThroughput(Platform::GetTime());
+            }
+
+            if (result < 0)
+            {
+                logger.Error("Failed to read {} bytes from {} at {}", batch->size, batch->path, batch->offset);
+            }
+
+            for (Request* request : batch->requests)
+            {
+                usize bytes = Math::Min(request->size, remaining);
+                remaining -= bytes;
+                request->callback(request->userData, result < 0 ? IOResult::Failed : IOResult::Success, bytes);
+                allocator.DestroyAndFree(request);
+            }
+
+            //only leaves the in flight count after the callbacks, WaitIdle returns when all of them are done.
+            {
+                std::unique_lock lock(mutex);
+                stats.inFlight -= batch->requests.Size();
+            }
+            idleCondition.notify_all();
+
+            allocator.DestroyAndFree(batch);
+        }
+
+        i64 ReadBatch(Batch* batch, Array<u8>& temp)
+        {
+            FileHandler handler = FileSystem::OpenFile(batch->path, AccessMode::ReadOnly);
+            if (!handler)
+            {
+                return -1;
+            }
+
+            bool single = batch->requests.Size() == 1;
+            if (!single)
+            {
+                temp.Resize(batch->size);
+            }
+
+            u8* data = single ? static_cast<u8*>(batch->requests[0]->buffer) : temp.Data();
+            usize read = FileSystem::ReadFileAt(handler, data, batch->size, batch->offset);
+            FileSystem::CloseFile(handler);
+
+            if (!single)
+            {
+                usize offset = 0;
+                for (Request* request : batch->requests)
+                {
+                    if (offset >= read) break;
+                    MemCopy(request->buffer, data + offset, Math::Min(request->size, read - offset));
+                    offset += request->size;
+                }
+            }
+            return static_cast<i64>(read);
+        }
+
+        void WorkerThread()
+        {
+            Array<u8> temp{};
+            while (true)
+            {
+                Batch* batch = nullptr;
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, []
+                    {
+                        return shutdown || stats.queued > 0;
+                    });
+
+                    if (shutdown)
+                    {
+                        return;
+                    }
+                    batch = PopBatch();
+                }
+                CompleteBatch(batch, ReadBatch(batch, temp));
+            }
+        }
+
+        //a single thread keeps the ring full, it sleeps on the ring while there are reads in flight.
+        //if the ring fails its reads are completed with an error and the thread continues as a worker.
+        void NativeThread()
+        {
+            Array<Batch*>            batches{};
+            Array<AsyncIOBuffer>     buffers{};
+            Array<AsyncIOCompletion> completions{};
+            u32                      submitted = 0;
+
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, [&]
+                    {
+                        return shutdown || stats.queued > 0 || submitted > 0;
+                    });
+
+                    if (shutdown && submitted == 0)
+                    {
+                        return;
+                    }
+
+                    while (!shutdown && submitted + batches.Size() < QueueDepth)
+                    {
+                        Batch* batch = PopBatch();
+                        if (batch == nullptr) break;
+                        batches.EmplaceBack(batch);
+                    }
+                }
+
+                for (Batch* batch : batches)
+                {
+                    buffers.Clear();
+                    for (Request* request : batch->requests)
+                    {
+                        buffers.EmplaceBack(AsyncIOBuffer{request->buffer, request->size});
+                    }
+
+                    if (AsyncIONativeSubmit(native, batch->path, batch->offset, buffers, batch))
+                    {
+                        submitted++;
+                    }
+                    else
+                    {
+                        CompleteBatch(batch, -1);
+                    }
+                }
+                batches.Clear();
+
+                if (submitted > 0)
+                {
+                    completions.Clear();
+                    bool valid = AsyncIONativeComplete(native, completions);
+                    for (const AsyncIOCompletion& completion : completions)
+                    {
+                        CompleteBatch(static_cast<Batch*>(completion.userData), completion.result);
+                        submitted--;
+                    }
+
+                    if (!valid)
+                    {
+                        {
+                            std::unique_lock lock(mutex);
+                            nativeFailed = true;
+                        }
+                        logger.Error("io_uring failed, falling back to worker reads");
+                        WorkerThread();
+                        return;
+                    }
+                }
+            }
+        }
+
+        //called with the mutex locked.
+        void Init()
+        {
+            initialized = true;
+            shutdown = false;
+            nativeFailed = false;
+            windowStart = Platform::GetTime();
+
+            native = AsyncIONativeCreate(QueueDepth);
+            if (native)
+            {
+                threads.EmplaceBack(NativeThread);
+                logger.Debug("using io_uring with {} entries", QueueDepth);
+            }
+            else
+            {
+                u32 count = Math::Min(MaxWorkers, Parallel::GetWorkerCount());
+                for (u32 i = 0; i < count; ++i)
+                {
+                    threads.EmplaceBack(WorkerThread);
+                }
+                logger.Debug("using {} worker threads", count);
+            }
+        }
+    }
+
+    IORequest AsyncIO::Read(const StringView& path, u64 offset, usize size, VoidPtr buffer, IOPriority priority, VoidPtr userData, FnIOCallback callback)
+    {
+        if (size == 0)
+        {
+            callback(userData, IOResult::Success, 0);
+            return {};
+        }
+
+        Request* request = allocator.Alloc<Request>();
+        request->path = path;
+        request->offset = offset;
+        request->size = size;
+        request->buffer = buffer;
+        request->userData = userData;
+        request->callback = callback;
+
+        u64 id = 0;
+        {
+            std::unique_lock lock(mutex);
+            if (!initialized)
+            {
+                Init();
+            }
+            id = nextId++;
+            request->id = id;
+            queues[static_cast<u32>(priority)].EmplaceBack(request);
+            stats.queued++;
+        }
+        condition.notify_all();
+
+        return IORequest{reinterpret_cast<VoidPtr>(id)};
+    }
+
+    bool AsyncIO::Cancel(IORequest ioRequest)
+    {
+        u64 id = reinterpret_cast<u64>(ioRequest.handler);
+        Request* request = nullptr;
+        {
+            std::unique_lock lock(mutex);
+            for (u32 p = 0; p < PriorityCount && request == nullptr; ++p)
+            {
+                for (usize i = 0; i < queues[p].Size(); ++i)
+                {
+                    if (queues[p][i]->id == id)
+                    {
+                        request = queues[p][i];
+                        queues[p].Remove(i);
+                        break;
+                    }
+                }
+            }
+
+            if (request == nullptr)
+            {
+                return false;
+            }
+
+            stats.queued--;
+            stats.cancelled++;
+        }
+
+        request->callback(request->userData, IOResult::Cancelled, 0);
+        allocator.DestroyAndFree(request);
+        idleCondition.notify_all();
+
+        return true;
+    }
+
+    void AsyncIO::WaitIdle()
+    {
+        std::unique_lock lock(mutex);
+        idleCondition.wait(lock, []
+        {
+            return stats.queued == 0 && stats.inFlight == 0;
+        });
+    }
+
+    bool AsyncIO::IsNative()
+    {
+        std::unique_lock lock(mutex);
+        if (!initialized)
+        {
+            Init();
+        }
+        return native != nullptr && !nativeFailed;
+    }
+
+    AsyncIOStats AsyncIO::GetStats()
+    {
+        std::unique_lock lock(mutex);
+        UpdateThroughput(Platform::GetTime());
+        return stats;
+    }
+
+    void AsyncIOShutdown()
+    {
+        Array<Request*> cancelled{};
+        {
+            std::unique_lock lock(mutex);
+            if (!initialized)
+            {
+                return;
+            }
+
+            shutdown = true;
+            for (Array<Request*>& queue : queues)
+            {
+                for (Request* request : queue)
+                {
+                    cancelled.EmplaceBack(request);
+                }
+                queue.Clear();
+                queue.ShrinkToFit();
+            }
+            stats.queued = 0;
+            stats.cancelled += cancelled.Size();
+        }
+        condition.notify_all();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        threads.Clear();
+        threads.ShrinkToFit();
+
+        for (Request* request : cancelled)
+        {
+            request->callback(request->userData, IOResult::Cancelled, 0);
+            allocator.DestroyAndFree(request);
+        }
+
+        if (native)
+        {
+            AsyncIONativeDestroy(native);
+            native = nullptr;
+        }
+
+        initialized = false;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "FileTypes.hpp"
+#include "Fyrion/Core/Span.hpp"
+#include "Fyrion/Core/Array.hpp"
+
+namespace Fyrion
+{
+    //native backend interface, the backend opens the file on submit and closes it on completion.
+    struct AsyncIOBuffer
+    {
+        VoidPtr data{};
+        usize   size{};
+    };
+
+    struct AsyncIOCompletion
+    {
+        VoidPtr userData{};
+        i64     result{};
+    };
+}
+
+namespace Fyrion::AsyncIO
+{
+    //reads size bytes at offset of the file into buffer without blocking the caller.
+    //uses io_uring on linux when the kernel allows it, otherwise a small pool of worker threads.
+    //queued requests are served by priority, adjacent ranges of the same file are coalesced into a single read.
+    //the callback runs on the IO thread, the buffer must stay alive until it's called.
+    FY_API IORequest    Read(const StringView& path, u64 offset, usize size, VoidPtr buffer, IOPriority priority, VoidPtr userData, FnIOCallback callback);
+
+    //only requests that are still queued can be cancelled, the callback is called with IOResult::Cancelled on the calling thread.
+    FY_API bool         Cancel(IORequest request);
+    FY_API void         WaitIdle();
+    FY_API bool         IsNative();
+    FY_API AsyncIOStats GetStats();
+}
@@ -0,0 +1,256 @@
+#include "Fyrion/Common.hpp"
+
+#ifdef FY_LINUX
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include "AsyncIO.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/Math.hpp"
+#include "Fyrion/Core/Algorithm.hpp"
+
+//liburing is not a dependency, the ring is set up with the raw syscalls.
+namespace Fyrion
+{
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::AsyncIO");
+
+        struct IoUringOperation
+        {
+            i32          fd{};
+            Array<iovec> iovecs{};
+            VoidPtr      userData{};
+        };
+
+        struct IoUring
+        {
+            i32           fd{};
+            VoidPtr       sqRing{};
+            usize         sqRingSize{};
+            VoidPtr       cqRing{};
+            usize         cqRingSize{};
+            io_uring_sqe* sqes{};
+            usize         sqesSize{};
+            u32*          sqTail{};
+            u32*          sqMask{};
+            u32*          sqArray{};
+            u32*          cqHead{};
+            u32*          cqTail{};
+            u32*          cqMask{};
+            io_uring_cqe* cqes{};
+            u32           pending{};
+
+            Array<IoUringOperation*> operations{};
+        };
+
+        template<typename T>
+        T* RingPtr(VoidPtr ring, u32 offset)
+        {
+            return reinterpret_cast<T*>(static_cast<u8*>(ring) + offset);
+        }
+
+        void DestroyRing(IoUring* ring)
+        {
+            if (ring->sqes)
+            {
+                munmap(ring->sqes, ring->sqesSize);
+            }
+            if (ring->cqRing && ring->cqRing != ring->sqRing)
+            {
+                munmap(ring->cqRing, ring->cqRingSize);
+            }
+            if (ring->sqRing)
+            {
+                munmap(ring->sqRing, ring->sqRingSize);
+            }
+            close(ring->fd);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(ring);
+        }
+    }
+
+    VoidPtr AsyncIONativeCreate(u32 entries)
+    {
+        io_uring_params params{};
+        i32 fd = static_cast<i32>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0)
+        {
+            logger.Warn("io_uring not available, errno {}", errno);
+            return nullptr;
+        }
+
+        IoUring* ring = MemoryGlobals::GetDefaultAllocator().Alloc<IoUring>();
+        ring->fd = fd;
+        ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+        ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap)
+        {
+            ring->sqRingSize = Math::Max(ring->sqRingSize, ring->cqRingSize);
+            ring->cqRingSize = ring->sqRingSize;
+        }
+
+        ring->sqRing = mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (ring->sqRing == MAP_FAILED)
+        {
+            ring->sqRing = nullptr;
+            logger.Warn("io_uring sq ring mmap failed, errno {}", errno);
+            DestroyRing(ring);
+            return nullptr;
+        }
+
+        ring->cqRing = singleMap ? ring->sqRing : mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED)
+        {
+            ring->cqRing = nullptr;
+            logger.Warn("io_uring cq ring mmap failed, errno {}", errno);
+            DestroyRing(ring);
+            return nullptr;
+        }
+
+        ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (ring->sqes == MAP_FAILED)
+        {
+            ring->sqes = nullptr;
+            logger.Warn("io_uring sqes mmap failed, errno {}", errno);
+            DestroyRing(ring);
+            return nullptr;
+        }
+
+        ring->sqTail = RingPtr<u32>(ring->sqRing, params.sq_off.tail);
+        ring->sqMask = RingPtr<u32>(ring->sqRing, params.sq_off.ring_mask);
+        ring->sqArray = RingPtr<u32>(ring->sqRing, params.sq_off.array);
+        ring->cqHead = RingPtr<u32>(ring->cqRing, params.cq_off.head);
+        ring->cqTail = RingPtr<u32>(ring->cqRing, params.cq_off.tail);
+        ring->cqMask = RingPtr<u32>(ring->cqRing, params.cq_off.ring_mask);
+        ring->cqes = RingPtr<io_uring_cqe>(ring->cqRing, params.cq_off.cqes);
+
+        return ring;
+    }
+
+    //the caller never has more operations in flight than the ring entries.
+    bool AsyncIONativeSubmit(VoidPtr native, const StringView& path, u64 offset, Span<AsyncIOBuffer> buffers, VoidPtr userData)
+    {
+        IoUring* ring = static_cast<IoUring*>(native);
+
+        String filePath = path;
+        i32 fd = open(filePath.CStr(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        IoUringOperation* operation = MemoryGlobals::GetDefaultAllocator().Alloc<IoUringOperation>();
+        operation->fd = fd;
+        operation->userData = userData;
+        operation->iovecs.Reserve(buffers.Size());
+        for (const AsyncIOBuffer& buffer : buffers)
+        {
+            operation->iovecs.EmplaceBack(iovec{buffer.data, buffer.size});
+        }
+
+        u32 tail = *ring->sqTail;
+        u32 index = tail & *ring->sqMask;
+
+        io_uring_sqe* sqe = &ring->sqes[index];
+        memset(sqe, 0, sizeof(io_uring_sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<u64>(operation->iovecs.Data());
+        sqe->len = static_cast<u32>(operation->iovecs.Size());
+        sqe->off = offset;
+        sqe->user_data = reinterpret_cast<u64>(operation);
+
+        ring->sqArray[index] = index;
+        __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+        ring->pending++;
+        ring->operations.EmplaceBack(operation);
+
+        return true;
+    }
+
+    //submits the pending operations and waits for at least one completion.
+    //returns false if the ring can't be used anymore, all its operations are completed with the error.
+    bool AsyncIONativeComplete(VoidPtr native, Array<AsyncIOCompletion>& completions)
+    {
+        IoUring* ring = static_cast<IoUring*>(native);
+
+        i32 error = 0;
+        while (true)
+        {
+            i32 res = static_cast<i32>(syscall(__NR_io_uring_enter, ring->fd, ring->pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (res >= 0)
+            {
+                ring->pending -= Math::Min(static_cast<u32>(res), ring->pending);
+                break;
+            }
+            if (errno != EINTR)
+            {
+                error = errno;
+                break;
+            }
+        }
+
+        auto complete = [&](IoUringOperation* operation, i64 result)
+        {
+            completions.EmplaceBack(AsyncIOCompletion{operation->userData, result});
+            close(operation->fd);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(operation);
+        };
+
+        u32 head = *ring->cqHead;
+        u32 tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+        while (head != tail)
+        {
+            io_uring_cqe* cqe = &ring->cqes[head & *ring->cqMask];
+            IoUringOperation* operation = reinterpret_cast<IoUringOperation*>(cqe->user_data);
+
+            ring->operations.Erase(FindFirst(ring->operations.begin(), ring->operations.end(), operation));
+            complete(operation, cqe->res);
+            head++;
+        }
+
+        __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+
+        if (error == 0)
+        {
+            return true;
+        }
+
+        //the kernel is out of resources or the completion queue is full, the call is retried after the reaped completions.
+        if (error == EAGAIN || error == EBUSY)
+        {
+            if (completions.Empty())
+            {
+                usleep(1000);
+            }
+            return true;
+        }
+
+        logger.Error("io_uring_enter failed, errno {}", error);
+        for (IoUringOperation* operation : ring->operations)
+        {
+            complete(operation, -error);
+        }
+        ring->operations.Clear();
+        ring->pending = 0;
+        return false;
+    }
+
+    void AsyncIONativeDestroy(VoidPtr native)
+    {
+        DestroyRing(static_cast<IoUring*>(native));
+    }
+}
+
+#endif
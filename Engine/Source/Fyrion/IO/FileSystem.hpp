@@ -18,13 +18,19 @@ namespace Fyrion::FileSystem
     FY_API bool         Remove(const StringView &path);
     FY_API bool         Rename(const StringView &newName, const StringView &oldName);
     FY_API bool         CopyFile(const StringView &from, const StringView &to);
+    FY_API bool         SyncFile(const StringView &path);
+    FY_API bool         SyncDirectory(const StringView &path);
 
     FY_API FileHandler  OpenFile(const StringView &path, AccessMode accessMode);
     FY_API u64          GetFileSize(FileHandler fileHandler);
     FY_API u64          WriteFile(FileHandler fileHandler, ConstPtr data, usize size);
     FY_API u64          ReadFile(FileHandler fileHandler, VoidPtr data, usize size);
+    FY_API u64          ReadFileAt(FileHandler fileHandler, VoidPtr data, usize size, u64 offset);
     FY_API void         CloseFile(FileHandler fileHandler);
 
+    FY_API FileMapping  MapFile(const StringView &path);
+    FY_API void         UnmapFile(const FileMapping& fileMapping);
+
     FY_API String       ReadFileAsString(const StringView &path);
     FY_API Array<u8>    ReadFileAsByteArray(const StringView &path);
 }
\ No newline at end of file
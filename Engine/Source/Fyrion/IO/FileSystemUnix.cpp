@@ -10,6 +10,8 @@
 #include <pwd.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <cerrno>
 
 #include "FileSystem.hpp"
 #include "Path.hpp"
@@ -95,10 +97,18 @@ namespace Fyrion
     {
         struct stat st{};
         bool exists = stat(path.CStr(), &st) == 0;
+
+        //nanoseconds, second resolution is not enough to detect changes made right after a load or save.
+#ifdef FY_APPLE
+        u64 lastModifiedTime = static_cast<u64>(st.st_mtimespec.tv_sec) * 1000000000ull + st.st_mtimespec.tv_nsec;
+#else
+        u64 lastModifiedTime = static_cast<u64>(st.st_mtim.tv_sec) * 1000000000ull + st.st_mtim.tv_nsec;
+#endif
+
         return {
             .exists = exists,
             .isDirectory = S_ISDIR(st.st_mode),
-            .lastModifiedTime = static_cast<f64>(st.st_mtime),
+            .lastModifiedTime = lastModifiedTime,
             .fileSize = static_cast<u64>(st.st_size)
         };
     }
@@ -123,7 +133,7 @@ namespace Fyrion
                 break;
             case AccessMode::WriteOnly:
             {
-                flags = O_WRONLY | O_CREAT;
+                flags = O_WRONLY | O_CREAT | O_TRUNC;
                 permission = S_IWRITE | S_IREAD;
                 break;
             }
@@ -143,6 +153,35 @@ namespace Fyrion
         return {MemoryGlobals::GetDefaultAllocator().Alloc<LinuxFileHandler>(ptr, path)};
     }
 
+    bool FileSystem::SyncFile(const StringView& path)
+    {
+        i32 fd = open(path.CStr(), O_RDONLY);
+        if (fd == -1)
+        {
+            return false;
+        }
+#ifdef FY_LINUX
+        bool res = fdatasync(fd) == 0;
+#else
+        bool res = fsync(fd) == 0;
+#endif
+        close(fd);
+        return res;
+    }
+
+    bool FileSystem::SyncDirectory(const StringView& path)
+    {
+        //renames and removes are only durable after the directory entry is flushed.
+        i32 fd = open(path.CStr(), O_RDONLY | O_DIRECTORY);
+        if (fd == -1)
+        {
+            return false;
+        }
+        bool res = fsync(fd) == 0;
+        close(fd);
+        return res;
+    }
+
     u64 FileSystem::GetFileSize(FileHandler fileHandler)
     {
         LinuxFileHandler* linuxFileHandler = static_cast<LinuxFileHandler*>(fileHandler.handler);
@@ -163,6 +202,20 @@ namespace Fyrion
         return read(linuxFileHandler->handler, data, size);
     }
 
+    u64 FileSystem::ReadFileAt(FileHandler fileHandler, VoidPtr data, usize size, u64 offset)
+    {
+        LinuxFileHandler* linuxFileHandler = static_cast<LinuxFileHandler*>(fileHandler.handler);
+        usize total = 0;
+        while (total < size)
+        {
+            ssize_t res = pread(linuxFileHandler->handler, static_cast<u8*>(data) + total, size - total, offset + total);
+            if (res < 0 && errno == EINTR) continue;
+            if (res <= 0) break;
+            total += res;
+        }
+        return total;
+    }
+
 
     void FileSystem::CloseFile(FileHandler fileHandler)
     {
@@ -173,6 +226,45 @@ namespace Fyrion
         MemoryGlobals::GetDefaultAllocator().DestroyAndFree(linuxFileHandler);
     }
 
+    FileMapping FileSystem::MapFile(const StringView& path)
+    {
+        i32 fd = open(path.CStr(), O_RDONLY);
+        if (fd == -1)
+        {
+            return {};
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            close(fd);
+            return {};
+        }
+
+        VoidPtr data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+        //the mapping keeps its own reference to the file.
+        close(fd);
+
+        if (data == MAP_FAILED)
+        {
+            return {};
+        }
+
+        return FileMapping{
+            .data = static_cast<const u8*>(data),
+            .size = static_cast<usize>(st.st_size)
+        };
+    }
+
+    void FileSystem::UnmapFile(const FileMapping& fileMapping)
+    {
+        if (fileMapping.data)
+        {
+            munmap((VoidPtr) fileMapping.data, fileMapping.size);
+        }
+    }
+
 }
 
 #endif
@@ -170,11 +170,88 @@ namespace Fyrion
         return nRead;
     }
 
+    u64 FileSystem::ReadFileAt(FileHandler fileHandler, VoidPtr data, usize size, u64 offset)
+    {
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD nRead = 0;
+        if (!::ReadFile((HANDLE) fileHandler.handler, data, size, &nRead, &overlapped))
+        {
+            return 0;
+        }
+        return nRead;
+    }
+
+
+    bool FileSystem::SyncFile(const StringView& path)
+    {
+        HANDLE handle = CreateFile(path.CStr(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        bool res = FlushFileBuffers(handle) != 0;
+        CloseHandle(handle);
+        return res;
+    }
+
+    bool FileSystem::SyncDirectory(const StringView& path)
+    {
+        //NTFS journals directory entries, nothing to flush.
+        return true;
+    }
 
     void FileSystem::CloseFile(FileHandler fileHandler)
     {
         CloseHandle((HANDLE)fileHandler.handler);
     }
+
+    FileMapping FileSystem::MapFile(const StringView& path)
+    {
+        HANDLE file = CreateFile(path.CStr(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return {};
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return {};
+        }
+
+        HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            return {};
+        }
+
+        VoidPtr data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            return {};
+        }
+
+        return FileMapping{
+            .data = static_cast<const u8*>(data),
+            .size = static_cast<usize>(size.QuadPart),
+            .handler = mapping
+        };
+    }
+
+    void FileSystem::UnmapFile(const FileMapping& fileMapping)
+    {
+        if (fileMapping.data)
+        {
+            UnmapViewOfFile(fileMapping.data);
+            CloseHandle(fileMapping.handler);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "FileTransaction.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/HashSet.hpp"
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/Core/Algorithm.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::FileTransaction");
+
+        //fsync latency is mostly waiting for the device, flushing all files at once lets it merge the writes.
+        void SyncFiles(const Array<String>& files)
+        {
+            Parallel::For(files.Size(), 0, [&](usize index)
+            {
+                FileSystem::SyncFile(files[index]);
+            });
+        }
+
+        void SyncDirectories(const Array<String>& directories)
+        {
+            Parallel::For(directories.Size(), 0, [&](usize index)
+            {
+                FileSystem::SyncDirectory(directories[index]);
+            });
+        }
+    }
+
+    FileTransaction::FileTransaction(const StringView& directory) : m_directory(directory)
+    {
+    }
+
+    FileTransaction::~FileTransaction()
+    {
+        //not committed, temp files are discarded.
+        for (const String& tempFile : m_tempFiles)
+        {
+            FileSystem::Remove(tempFile);
+        }
+    }
+
+    bool FileTransaction::Write(const StringView& path, ConstPtr data, usize size)
+    {
+        String tempPath = String{path} + FY_TEMP_EXTENSION;
+
+        FileHandler handler = FileSystem::OpenFile(tempPath, AccessMode::WriteOnly);
+        if (!handler)
+        {
+            logger.Error("Failed to open {} ", tempPath);
+            return false;
+        }
+
+        bool res = FileSystem::WriteFile(handler, data, size) == size;
+        FileSystem::CloseFile(handler);
+
+        m_tempFiles.EmplaceBack(tempPath);
+
+        if (!res)
+        {
+            logger.Error("Failed to write {} ", tempPath);
+            return false;
+        }
+
+        Rename(tempPath, path);
+        return true;
+    }
+
+    void FileTransaction::Rename(const StringView& from, const StringView& to)
+    {
+        m_operations.EmplaceBack(Operation{
+            .type = OperationType::Rename,
+            .from = from,
+            .to = to
+        });
+    }
+
+    void FileTransaction::Remove(const StringView& path)
+    {
+        m_operations.EmplaceBack(Operation{
+            .type = OperationType::Remove,
+            .from = path
+        });
+    }
+
+    bool FileTransaction::Empty() const
+    {
+        return m_operations.Empty();
+    }
+
+    bool FileTransaction::Commit()
+    {
+        if (m_operations.Empty())
+        {
+            return true;
+        }
+
+        Array<String> files{};
+        String manifest{};
+
+        for (const Operation& operation : m_operations)
+        {
+            if (operation.type == OperationType::Rename)
+            {
+                files.EmplaceBack(operation.from);
+                manifest += "R\t";
+                manifest += operation.from;
+                manifest += "\t";
+                manifest += operation.to;
+                manifest += "\n";
+            }
+            else
+            {
+                manifest += "D\t";
+                manifest += operation.from;
+                manifest += "\n";
+            }
+        }
+
+        //1: everything that is going to be renamed must be on disk before the manifest.
+        SyncFiles(files);
+
+        //2: the manifest is the commit point, after it's renamed the transaction is rolled forward on recover.
+        String manifestPath = Path::Join(m_directory, FY_MANIFEST_FILE);
+        String manifestTempPath = manifestPath + FY_TEMP_EXTENSION;
+
+        FileHandler handler = FileSystem::OpenFile(manifestTempPath, AccessMode::WriteOnly);
+        if (!handler)
+        {
+            logger.Error("Failed to open manifest {} ", manifestTempPath);
+            return false;
+        }
+        bool res = FileSystem::WriteFile(handler, manifest.begin(), manifest.Size()) == manifest.Size();
+        FileSystem::CloseFile(handler);
+
+        if (!res || !FileSystem::SyncFile(manifestTempPath) || !FileSystem::Rename(manifestTempPath, manifestPath))
+        {
+            logger.Error("Failed to write manifest {} ", manifestPath);
+            FileSystem::Remove(manifestTempPath);
+            return false;
+        }
+        FileSystem::SyncDirectory(m_directory);
+
+        //3: apply. temp files now belong to the manifest, they are needed to roll forward if anything failed.
+        bool applied = Apply(m_operations);
+
+        m_tempFiles.Clear();
+        m_operations.Clear();
+
+        if (!applied)
+        {
+            logger.Error("Failed to apply transaction on {}, it will be rolled forward on recover", m_directory);
+            return false;
+        }
+
+        FileSystem::Remove(manifestPath);
+        FileSystem::SyncDirectory(m_directory);
+
+        return true;
+    }
+
+    bool FileTransaction::Recover(const StringView& directory)
+    {
+        String manifestPath = Path::Join(directory, FY_MANIFEST_FILE);
+        String manifestTempPath = manifestPath + FY_TEMP_EXTENSION;
+
+        //not committed, the destination files were never touched.
+        if (FileSystem::GetFileStatus(manifestTempPath).exists)
+        {
+            FileSystem::Remove(manifestTempPath);
+        }
+
+        if (!FileSystem::GetFileStatus(manifestPath).exists)
+        {
+            return false;
+        }
+
+        String manifest = FileSystem::ReadFileAsString(manifestPath);
+
+        Array<Operation> operations{};
+        Split(StringView{manifest}, StringView{"\n"}, [&](const StringView& line)
+        {
+            if (line.Size() < 3 || line[1] != '\t') return;
+
+            StringView args = line.Substr(2);
+            if (line[0] == 'R')
+            {
+                usize separator = args.FindFirstOf('\t');
+                if (separator == StringView::s_npos) return;
+
+                operations.EmplaceBack(Operation{
+                    .type = OperationType::Rename,
+                    .from = args.Substr(0, separator),
+                    .to = args.Substr(separator + 1)
+                });
+            }
+            else if (line[0] == 'D')
+            {
+                operations.EmplaceBack(Operation{
+                    .type = OperationType::Remove,
+                    .from = args
+                });
+            }
+        });
+
+        logger.Warn("Interrupted save found on {}, rolling forward {} operations", directory, operations.Size());
+
+        if (!Apply(operations))
+        {
+            logger.Error("Failed to roll forward {}, the manifest is kept", directory);
+            return false;
+        }
+
+        FileSystem::Remove(manifestPath);
+        FileSystem::SyncDirectory(directory);
+
+        return true;
+    }
+
+    bool FileTransaction::Apply(const Array<Operation>& operations)
+    {
+        HashSet<String> directories{};
+        bool            result = true;
+
+        for (const Operation& operation : operations)
+        {
+            if (operation.type == OperationType::Rename)
+            {
+                //on recover the rename may already be done.
+                if (FileSystem::GetFileStatus(operation.from).exists)
+                {
+                    if (!FileSystem::Rename(operation.from, operation.to))
+                    {
+                        logger.Error("Failed to rename {} to {} ", operation.from, operation.to);
+                        result = false;
+                    }
+                }
+                directories.Insert(Path::Parent(operation.to));
+            }
+            else if (FileSystem::GetFileStatus(operation.from).exists)
+            {
+                if (!FileSystem::Remove(operation.from))
+                {
+                    logger.Error("Failed to remove {} ", operation.from);
+                    result = false;
+                }
+                directories.Insert(Path::Parent(operation.from));
+            }
+        }
+
+        Array<String> directoryArray{};
+        directoryArray.Reserve(directories.Size());
+        for (const auto& it : directories)
+        {
+            directoryArray.EmplaceBack(it.first);
+        }
+        SyncDirectories(directoryArray);
+
+        return result;
+    }
+}
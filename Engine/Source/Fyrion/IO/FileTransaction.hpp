@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FileTypes.hpp"
+#include "Fyrion/Core/Array.hpp"
+
+#define FY_TEMP_EXTENSION ".fy_tmp"
+#define FY_MANIFEST_FILE ".fy_manifest"
+
+namespace Fyrion
+{
+    //groups file writes, renames and removes and applies them all or nothing.
+    //writes go to a temp file next to the destination, on Commit all pending files are flushed in parallel,
+    //the operations are recorded on a manifest in the transaction directory and then applied.
+    //if the process dies while applying, Recover rolls the manifest forward on the next start.
+    //if an operation fails the manifest is kept, Commit and Recover return false and the next Recover retries it.
+    class FY_API FileTransaction
+    {
+    public:
+        explicit FileTransaction(const StringView& directory);
+        ~FileTransaction();
+
+        FileTransaction(const FileTransaction&) = delete;
+        FileTransaction& operator=(const FileTransaction&) = delete;
+
+        bool Write(const StringView& path, ConstPtr data, usize size);
+        void Rename(const StringView& from, const StringView& to);
+        void Remove(const StringView& path);
+        bool Empty() const;
+        bool Commit();
+
+        static bool Recover(const StringView& directory);
+    private:
+        enum class OperationType
+        {
+            Rename = 0,
+            Remove = 1
+        };
+
+        struct Operation
+        {
+            OperationType type{};
+            String        from{};
+            String        to{};
+        };
+
+        String           m_directory{};
+        Array<Operation> m_operations{};
+        Array<String>    m_tempFiles{};
+
+        static bool Apply(const Array<Operation>& operations);
+    };
+}
@@ -18,6 +18,57 @@ namespace Fyrion
 
     FY_HANDLER(FileHandler);
 
+    enum class FileNotifyEvent
+    {
+        Added    = 0,
+        Removed  = 1,
+        Modified = 2
+    };
+
+    struct FileWatcherEvent
+    {
+        String          path{};
+        FileNotifyEvent event{};
+        f64             time{};
+    };
+
+    //read-only view of a whole file, it stays valid after the file is renamed or replaced.
+    struct FileMapping
+    {
+        const u8* data{};
+        usize     size{};
+        VoidPtr   handler{};
+    };
+
+    enum class IOPriority
+    {
+        Low     = 0,
+        Normal  = 1,
+        High    = 2
+    };
+
+    enum class IOResult
+    {
+        Success   = 0,
+        Failed    = 1,
+        Cancelled = 2
+    };
+
+    typedef void(*FnIOCallback)(VoidPtr userData, IOResult result, usize bytes);
+
+    FY_HANDLER(IORequest);
+
+    struct AsyncIOStats
+    {
+        u32 queued{};
+        u32 inFlight{};
+        u64 completed{};
+        u64 cancelled{};
+        u64 coalesced{};
+        u64 bytesRead{};
+        f64 bytesPerSecond{};
+    };
+
     struct FileStatus
     {
         bool    exists{};
@@ -0,0 +1,189 @@
+#include "FileWatcher.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+
+namespace Fyrion
+{
+    VoidPtr FileWatcherNativeCreate();
+    bool    FileWatcherNativeAdd(VoidPtr native, const StringView& directory);
+    void    FileWatcherNativeRead(VoidPtr native, Array<FileWatcherEvent>& events);
+    void    FileWatcherNativeDestroy(VoidPtr native);
+
+#ifndef FY_LINUX
+    VoidPtr FileWatcherNativeCreate()
+    {
+        return nullptr;
+    }
+
+    bool FileWatcherNativeAdd(VoidPtr native, const StringView& directory)
+    {
+        return false;
+    }
+
+    void FileWatcherNativeRead(VoidPtr native, Array<FileWatcherEvent>& events) {}
+    void FileWatcherNativeDestroy(VoidPtr native) {}
+#endif
+
+    FileWatcher::FileWatcher() : m_native(FileWatcherNativeCreate())
+    {
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        if (m_native)
+        {
+            FileWatcherNativeDestroy(m_native);
+        }
+    }
+
+    void FileWatcher::Watch(const StringView& directory)
+    {
+        m_directories.EmplaceBack(directory);
+
+        if (m_native && FileWatcherNativeAdd(m_native, directory))
+        {
+            return;
+        }
+
+        //no native support, fallback to scans. directories watched natively until now are snapshotted too,
+        //otherwise their files would be reported as added on the first scan.
+        if (m_native)
+        {
+            FileWatcherNativeDestroy(m_native);
+            m_native = nullptr;
+
+            for (const String& watched : m_directories)
+            {
+                Scan(watched, m_snapshot);
+            }
+        }
+        else
+        {
+            Scan(directory, m_snapshot);
+        }
+        m_lastScan = Platform::GetTime();
+    }
+
+    void FileWatcher::SetDebounceTime(f64 debounceTime)
+    {
+        m_debounceTime = debounceTime;
+    }
+
+    void FileWatcher::SetPollingInterval(f64 pollingInterval)
+    {
+        m_pollingInterval = pollingInterval;
+    }
+
+    bool FileWatcher::IsPolling() const
+    {
+        return m_native == nullptr;
+    }
+
+    void FileWatcher::Poll(Array<FileWatcherEvent>& events)
+    {
+        f64 now = Platform::GetTime();
+
+        if (m_native)
+        {
+            Array<FileWatcherEvent> nativeEvents{};
+            FileWatcherNativeRead(m_native, nativeEvents);
+            for (const FileWatcherEvent& nativeEvent : nativeEvents)
+            {
+                AddEvent(nativeEvent.path, nativeEvent.event, nativeEvent.time);
+            }
+        }
+        else if (now - m_lastScan >= m_pollingInterval)
+        {
+            HashMap<String, u64> snapshot{};
+            for (const String& directory : m_directories)
+            {
+                Scan(directory, snapshot);
+            }
+
+            for (const auto& it : snapshot)
+            {
+                auto old = m_snapshot.Find(it.first);
+                if (old == m_snapshot.end())
+                {
+                    AddEvent(it.first, FileNotifyEvent::Added, now);
+                }
+                else if (old->second != it.second)
+                {
+                    AddEvent(it.first, FileNotifyEvent::Modified, now);
+                }
+            }
+
+            for (const auto& it : m_snapshot)
+            {
+                if (!snapshot.Has(it.first))
+                {
+                    AddEvent(it.first, FileNotifyEvent::Removed, now);
+                }
+            }
+
+            m_snapshot.Swap(snapshot);
+            m_lastScan = now;
+        }
+
+        Array<String> settled{};
+        for (const auto& it : m_pending)
+        {
+            if (now - it.second.lastTime >= m_debounceTime)
+            {
+                events.EmplaceBack(FileWatcherEvent{
+                    .path = it.first,
+                    .event = it.second.event,
+                    .time = it.second.firstTime
+                });
+                settled.EmplaceBack(it.first);
+            }
+        }
+
+        for (const String& path : settled)
+        {
+            m_pending.Erase(path);
+        }
+    }
+
+    void FileWatcher::Scan(const StringView& directory, HashMap<String, u64>& snapshot)
+    {
+        for (const String& entry : DirectoryEntries{directory})
+        {
+            FileStatus status = FileSystem::GetFileStatus(entry);
+            if (status.isDirectory)
+            {
+                Scan(entry, snapshot);
+            }
+            else
+            {
+                snapshot.Insert(entry, status.lastModifiedTime);
+            }
+        }
+    }
+
+    void FileWatcher::AddEvent(const StringView& path, FileNotifyEvent event, f64 time)
+    {
+        auto it = m_pending.Find(path);
+        if (it == m_pending.end())
+        {
+            m_pending.Insert(path, PendingEvent{
+                .event = event,
+                .firstTime = time,
+                .lastTime = time
+            });
+            return;
+        }
+
+        if (event == FileNotifyEvent::Removed)
+        {
+            it->second.event = FileNotifyEvent::Removed;
+        }
+        else if (it->second.event == FileNotifyEvent::Removed)
+        {
+            //removed and written again in the same window, like saves done through a rename.
+            it->second.event = FileNotifyEvent::Modified;
+        }
+        it->second.lastTime = time;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "FileTypes.hpp"
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/HashMap.hpp"
+
+namespace Fyrion
+{
+    //watches directories recursively, uses native notifications when available (inotify on linux)
+    //and falls back to periodic scans otherwise. events are debounced per path.
+    class FY_API FileWatcher
+    {
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        void Watch(const StringView& directory);
+        void SetDebounceTime(f64 debounceTime);
+        void SetPollingInterval(f64 pollingInterval);
+        bool IsPolling() const;
+
+        //returns the events that are settled for at least the debounce time.
+        //FileWatcherEvent::time is the time the first event of the path was noticed.
+        void Poll(Array<FileWatcherEvent>& events);
+    private:
+        struct PendingEvent
+        {
+            FileNotifyEvent event{};
+            f64             firstTime{};
+            f64             lastTime{};
+        };
+
+        VoidPtr                       m_native{};
+        Array<String>                 m_directories{};
+        HashMap<String, u64>          m_snapshot{};
+        HashMap<String, PendingEvent> m_pending{};
+        f64                           m_debounceTime = 0.1;
+        f64                           m_pollingInterval = 1.0;
+        f64                           m_lastScan{};
+
+        void Scan(const StringView& directory, HashMap<String, u64>& snapshot);
+        void AddEvent(const StringView& path, FileNotifyEvent event, f64 time);
+    };
+}
@@ -0,0 +1,152 @@
+#include "Fyrion/Common.hpp"
+
+#ifdef FY_LINUX
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "FileWatcher.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::FileWatcher");
+
+        constexpr u32 WatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+
+        struct LinuxFileWatcher
+        {
+            i32                  fd{};
+            HashMap<i32, String> directories{};
+        };
+
+        bool AddWatch(LinuxFileWatcher* watcher, const StringView& directory)
+        {
+            String path = directory;
+            i32 wd = inotify_add_watch(watcher->fd, path.CStr(), WatchMask);
+            if (wd < 0)
+            {
+                logger.Warn("inotify_add_watch failed for {} errno {}", directory, errno);
+                return false;
+            }
+            watcher->directories.Insert(wd, path);
+
+            for (const String& entry : DirectoryEntries{directory})
+            {
+                if (FileSystem::GetFileStatus(entry).isDirectory && !AddWatch(watcher, entry))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    VoidPtr FileWatcherNativeCreate()
+    {
+        i32 fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0)
+        {
+            logger.Warn("inotify not available, errno {}", errno);
+            return nullptr;
+        }
+        return MemoryGlobals::GetDefaultAllocator().Alloc<LinuxFileWatcher>(fd);
+    }
+
+    bool FileWatcherNativeAdd(VoidPtr native, const StringView& directory)
+    {
+        return AddWatch(static_cast<LinuxFileWatcher*>(native), directory);
+    }
+
+    void FileWatcherNativeRead(VoidPtr native, Array<FileWatcherEvent>& events)
+    {
+        LinuxFileWatcher* watcher = static_cast<LinuxFileWatcher*>(native);
+
+        alignas(inotify_event) char buffer[4096];
+
+        while (true)
+        {
+            i64 len = read(watcher->fd, buffer, sizeof(buffer));
+            if (len <= 0)
+            {
+                break;
+            }
+
+            f64 now = Platform::GetTime();
+
+            for (char* ptr = buffer; ptr < buffer + len;)
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                auto it = watcher->directories.Find(event->wd);
+                if (it == watcher->directories.end())
+                {
+                    continue;
+                }
+
+                if (event->mask & (IN_DELETE_SELF | IN_IGNORED))
+                {
+                    watcher->directories.Erase(it);
+                    continue;
+                }
+
+                if (event->len == 0)
+                {
+                    continue;
+                }
+
+                String path = Path::Join(it->second, event->name);
+
+                if (event->mask & IN_ISDIR)
+                {
+                    //new directories need their own watch, files created before the watch are reported as added.
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        AddWatch(watcher, path);
+                        for (const String& entry : DirectoryEntries{path})
+                        {
+                            events.EmplaceBack(FileWatcherEvent{
+                                .path = entry,
+                                .event = FileNotifyEvent::Added,
+                                .time = now
+                            });
+                        }
+                    }
+                    continue;
+                }
+
+                FileNotifyEvent notifyEvent = FileNotifyEvent::Modified;
+                if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                {
+                    notifyEvent = FileNotifyEvent::Removed;
+                }
+                else if (event->mask & IN_CREATE)
+                {
+                    notifyEvent = FileNotifyEvent::Added;
+                }
+
+                events.EmplaceBack(FileWatcherEvent{
+                    .path = path,
+                    .event = notifyEvent,
+                    .time = now
+                });
+            }
+        }
+    }
+
+    void FileWatcherNativeDestroy(VoidPtr native)
+    {
+        LinuxFileWatcher* watcher = static_cast<LinuxFileWatcher*>(native);
+        close(watcher->fd);
+        MemoryGlobals::GetDefaultAllocator().DestroyAndFree(watcher);
+    }
+}
+
+#endif
@@ -21,6 +21,7 @@ namespace Fyrion::Platform
 
     FY_API f64          GetTime();
     FY_API f64          GetElapsedTime();
+    FY_API void         Sleep(f64 seconds);
 
     FY_API void         ShowInExplorer(const StringView& path);
 
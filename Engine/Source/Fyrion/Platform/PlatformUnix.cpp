@@ -7,6 +7,7 @@
 #ifdef FY_UNIX
 
 #include <dlfcn.h>
+#include <time.h>
 
 namespace Fyrion
 {
@@ -39,6 +40,19 @@ namespace Fyrion
         return now.tv_sec + now.tv_nsec * 0.000000001;
     }
 
+    void Platform::Sleep(f64 seconds)
+    {
+        if (seconds <= 0)
+        {
+            return;
+        }
+
+        struct timespec duration{};
+        duration.tv_sec = static_cast<time_t>(seconds);
+        duration.tv_nsec = static_cast<long>((seconds - static_cast<f64>(duration.tv_sec)) * 1000000000.0);
+        nanosleep(&duration, nullptr);
+    }
+
     void Platform::ShowInExplorer(const StringView& path)
     {
 #ifdef FY_LINUX
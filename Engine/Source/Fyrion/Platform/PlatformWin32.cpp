@@ -33,6 +33,23 @@ namespace Fyrion
         return (f64) nowTime.QuadPart * clockFrequency;
     }
 
+    void Platform::Sleep(f64 seconds)
+    {
+        if (seconds <= 0)
+        {
+            return;
+        }
+
+        //Sleep has millisecond granularity, the remaining time is spun.
+        f64 end = GetTime() + seconds;
+        DWORD milliseconds = static_cast<DWORD>(seconds * 1000.0);
+        if (milliseconds > 1)
+        {
+            ::Sleep(milliseconds - 1);
+        }
+        while (GetTime() < end) {}
+    }
+
     void Platform::ShowInExplorer(const StringView& path)
     {
         auto stat = FileSystem::GetFileStatus(path);
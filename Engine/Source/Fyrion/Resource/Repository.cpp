@@ -3,6 +3,8 @@
 //https://ruby0x1.github.io/machinery_blog_archive/post/multi-threading-the-truth/index.html
 
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include "Repository.hpp"
 #include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Core/SharedPtr.hpp"
@@ -18,6 +20,12 @@
 #include "Fyrion/Assets/AssetTypes.hpp"
 #include "Fyrion/IO/FileSystem.hpp"
 #include "Fyrion/IO/Path.hpp"
+#include "Fyrion/IO/FileTransaction.hpp"
+#include "Fyrion/IO/AsyncIO.hpp"
+#include "Fyrion/Core/Math.hpp"
+#include "Fyrion/Core/Compression.hpp"
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/Platform/Platform.hpp"
 
 #define PAGE(value)    u32((value)/FY_REPO_PAGE_SIZE)
 #define OFFSET(value)  (u32)((value) & (FY_REPO_PAGE_SIZE - 1))
@@ -94,6 +102,7 @@ namespace Fyrion
         Array<VoidPtr> fields{};
         ResourceData* dataOnWrite{};
         bool readOnly = true;
+        bool reset{};
     };
 
     struct ResourceStorage
@@ -107,6 +116,7 @@ namespace Fyrion
         ResourceStorage* parent{};
         usize parentIndex = U32_MAX;
         bool markedToDestroy{};
+        bool resetOnWrite{};
         bool active = true;
         TypeHandler* typeHandler = nullptr;
         std::atomic<u32> version = 1;
@@ -119,6 +129,57 @@ namespace Fyrion
         bool            destroyResource{};
     };
 
+    constexpr u32 StreamChunkMagic = 0x43535946; //FYSC
+    constexpr u32 StreamChunkSize = 64 * 1024;
+
+    //followed by chunkCount + 1 file offsets and the chunks.
+    //a chunk with the same size as its uncompressed range is stored uncompressed.
+    struct StreamChunkHeader
+    {
+        u32 magic{};
+        u32 chunkSize{};
+        u64 size{};
+        u64 chunkCount{};
+    };
+
+    struct StreamMapping
+    {
+        FileMapping              fileMapping{};
+        std::atomic<i32>         references{};
+        const StreamChunkHeader* header{};
+        const u64*               chunkOffsets{};
+        std::atomic<u64>         decodedBytes{};
+        std::atomic<u64>         decodeTime{};
+        std::mutex               cacheMutex{};
+        u8*                      cache{};
+        Array<bool>              decodedChunks{};
+        String                   sharedPath{};
+        u64                      lastModifiedTime{};
+    };
+
+    constexpr usize WriteBehindBufferSize = 16 * StreamChunkSize;
+    constexpr usize WriteBehindBufferCount = 4;
+
+    //appended data is written to the temp file by a background thread, at most WriteBehindBufferCount buffers are in memory.
+    //buffers are multiple of the chunk size, so the content hash is computed while writing.
+    struct StreamWriter
+    {
+        String                  bufferFile{};
+        String                  tempFile{};
+        FileHandler             fileHandler{};
+        std::thread             thread{};
+        std::mutex              mutex{};
+        std::condition_variable condition{};
+        Array<u8>               current{};
+        Array<Array<u8>>        pending{};
+        Array<Array<u8>>        freeBuffers{};
+        Array<StreamHash>       chunkHashes{};
+        usize                   bufferCount{};
+        usize                   size{};
+        bool                    finished{};
+        bool                    failed{};
+    };
+
     struct ResourcePage
     {
         ResourceStorage elements[FY_REPO_PAGE_SIZE];
@@ -171,21 +232,19 @@ namespace Fyrion
 
         RID GetID(UUID uuid)
         {
-            if (uuid)
+            if (!uuid)
             {
-                std::unique_lock lock(byUUIDMutex);
-                if (auto it = byUUID.Find(uuid))
-                {
-                    return it->second;
-                }
+                return GetID();
             }
-            RID rid = GetID();
 
-            if (uuid)
+            //lookup and insert must be atomic, assets can be parsed in parallel and reference the same uuid.
+            std::unique_lock lock(byUUIDMutex);
+            if (auto it = byUUID.Find(uuid))
             {
-                std::unique_lock lock(byUUIDMutex);
-                byUUID.Insert(uuid, rid);
+                return it->second;
             }
+            RID rid = GetID();
+            byUUID.Insert(uuid, rid);
             return rid;
         }
 
@@ -200,6 +259,28 @@ namespace Fyrion
 
         void DestroyStorage(ResourceStorage* resourceStorage);
 
+        void RemoveFromResourcesByType(TypeID typeId, RID rid)
+        {
+            if (typeId == 0)
+            {
+                return;
+            }
+
+            std::unique_lock lock(resourcesByTypeMutex);
+            if (auto it = resourcesByType.Find(typeId))
+            {
+                Array<RID>& rids = it->second;
+                for (usize i = 0; i < rids.Size(); ++i)
+                {
+                    if (rids[i] == rid)
+                    {
+                        rids.Remove(i);
+                        break;
+                    }
+                }
+            }
+        }
+
         void DestroyData(ResourceData* data, bool destroySubObjects)
         {
             if (data)
@@ -269,23 +350,321 @@ namespace Fyrion
                 DestroyData(resourceStorage->data, true);
             }
 
-            if (resourceStorage->parent && resourceStorage->parentIndex != U32_MAX && !resourceStorage->parent->markedToDestroy)
+            if (resourceStorage->parent && resourceStorage->parentIndex != U32_MAX && !resourceStorage->parent->markedToDestroy &&
+                resourceStorage->parent->resourceType->fieldsByIndex[resourceStorage->parentIndex]->fieldType == ResourceFieldType::SubObjectSet)
             {
                 ResourceObject parent = Repository::Write(resourceStorage->parent->rid);
                 parent.RemoveFromSubObjectSet(resourceStorage->parentIndex, resourceStorage->rid);
                 parent.Commit();
             }
 
+            RemoveFromResourcesByType(resourceStorage->typeId, resourceStorage->rid);
+
             resourceStorage->~ResourceStorage();
             MemSet(resourceStorage, 0, sizeof(ResourceStorage));
         }
 
+        template<typename Func>
+        void ForEachSubObject(ResourceData* data, Func&& func)
+        {
+            if (!data || !data->memory) return;
+
+            for (int i = 0; i < data->fields.Size(); ++i)
+            {
+                if (data->fields[i] == nullptr) continue;
+
+                ResourceFieldType fieldType = data->storage->resourceType->fieldsByIndex[i]->fieldType;
+                if (fieldType == ResourceFieldType::SubObjectSet)
+                {
+                    for (auto it: static_cast<SubObjectSetData*>(data->fields[i])->subObjects)
+                    {
+                        func(&pages[it.first.page]->elements[it.first.offset]);
+                    }
+                }
+                else if (fieldType == ResourceFieldType::SubObject)
+                {
+                    RID subobject = *static_cast<RID*>(data->fields[i]);
+                    if (subobject)
+                    {
+                        func(&pages[subobject.page]->elements[subobject.offset]);
+                    }
+                }
+            }
+        }
+
+        //subobjects of the old data that were not written again after a reset are destroyed.
+        void DestroyRemovedSubObjects(ResourceData* oldData, ResourceData* newData)
+        {
+            HashSet<RID> current{};
+            ForEachSubObject(newData, [&](ResourceStorage* subobject)
+            {
+                current.Insert(subobject->rid);
+            });
+
+            ForEachSubObject(oldData, [&](ResourceStorage* subobject)
+            {
+                if (!current.Has(subobject->rid) && subobject->parent == newData->storage && subobject->data)
+                {
+                    subobject->parent = nullptr;
+                    subobject->parentIndex = U32_MAX;
+                    Repository::DestroyResource(subobject->rid);
+                }
+            });
+        }
+
+        std::mutex bufferIdMutex{};
+
+        //mappings created by MapTo are shared by path, streams with the same file are mapped once.
+        std::mutex                      streamMappingMutex{};
+        HashMap<String, StreamMapping*> streamMappings{};
+
         u64 GenerateBufferId()
         {
+            std::unique_lock lock(bufferIdMutex);
             return Random::Xorshift64star();
         }
 
-        String GetBufferFile(StreamObject* streamObject)
+        StreamMapping* CreateStreamMapping(const StringView& file, StreamEncoding encoding)
+        {
+            FileMapping fileMapping = FileSystem::MapFile(file);
+            if (!fileMapping.data)
+            {
+                return nullptr;
+            }
+
+            StreamMapping* mapping = allocator.Alloc<StreamMapping>(fileMapping);
+            if (encoding != StreamEncoding::Chunked)
+            {
+                return mapping;
+            }
+
+            const StreamChunkHeader* header = reinterpret_cast<const StreamChunkHeader*>(fileMapping.data);
+            if (fileMapping.size >= sizeof(StreamChunkHeader) && header->magic == StreamChunkMagic && header->chunkSize > 0
+                && fileMapping.size >= sizeof(StreamChunkHeader) + (header->chunkCount + 1) * sizeof(u64))
+            {
+                mapping->header = header;
+                mapping->chunkOffsets = reinterpret_cast<const u64*>(fileMapping.data + sizeof(StreamChunkHeader));
+            }
+            else
+            {
+                logger.Error("stream file {} has an invalid chunk table", file);
+            }
+
+            return mapping;
+        }
+
+        //returns the mapping with a reference already added.
+        StreamMapping* AcquireStreamMapping(const StringView& file, StreamEncoding encoding)
+        {
+            String path = file;
+            u64 lastModifiedTime = FileSystem::GetFileStatus(path).lastModifiedTime;
+
+            std::unique_lock lock(streamMappingMutex);
+
+            auto it = streamMappings.Find(path);
+            if (it != streamMappings.end() && it->second->lastModifiedTime == lastModifiedTime && (it->second->header != nullptr) == (encoding == StreamEncoding::Chunked))
+            {
+                it->second->references++;
+                return it->second;
+            }
+
+            //the file was replaced, the old mapping is kept alive by its streams but it's not shared anymore.
+            StreamMapping* mapping = CreateStreamMapping(path, encoding);
+            if (mapping)
+            {
+                mapping->references = 1;
+                mapping->sharedPath = path;
+                mapping->lastModifiedTime = lastModifiedTime;
+                streamMappings.Insert(path, mapping).first->second = mapping;
+            }
+            else if (it != streamMappings.end())
+            {
+                streamMappings.Erase(it);
+            }
+            return mapping;
+        }
+
+        void ReleaseStreamMapping(StreamMapping* mapping)
+        {
+            if (mapping == nullptr)
+            {
+                return;
+            }
+
+            if (!mapping->sharedPath.Empty())
+            {
+                std::unique_lock lock(streamMappingMutex);
+                if (--mapping->references > 0)
+                {
+                    return;
+                }
+
+                auto it = streamMappings.Find(mapping->sharedPath);
+                if (it != streamMappings.end() && it->second == mapping)
+                {
+                    streamMappings.Erase(it);
+                }
+            }
+            else if (--mapping->references > 0)
+            {
+                return;
+            }
+
+            FileSystem::UnmapFile(mapping->fileMapping);
+            if (mapping->cache)
+            {
+                allocator.MemFree(mapping->cache);
+            }
+            allocator.DestroyAndFree(mapping);
+        }
+
+        //base points to the file byte at baseOffset, it has to contain all chunks in the range.
+        //returns false if a chunk doesn't decode to its full length, dst is left incomplete.
+        bool DecodeStreamChunks(StreamMapping* mapping, const u8* base, u64 baseOffset, u8* dst, usize offset, usize size)
+        {
+            const StreamChunkHeader* header = mapping->header;
+
+            f64   startTime = Platform::GetTime();
+            u64   decoded = 0;
+            usize first = offset / header->chunkSize;
+            usize last = (offset + size - 1) / header->chunkSize;
+
+            Array<u8> chunk{};
+
+            for (usize c = first; c <= last; ++c)
+            {
+                usize chunkBegin = c * header->chunkSize;
+                usize chunkLength = Math::Min(static_cast<usize>(header->chunkSize), static_cast<usize>(header->size - chunkBegin));
+                usize from = Math::Max(offset, chunkBegin) - chunkBegin;
+                usize to = Math::Min(offset + size, chunkBegin + chunkLength) - chunkBegin;
+
+                const u8* src = base + (mapping->chunkOffsets[c] - baseOffset);
+                usize srcSize = mapping->chunkOffsets[c + 1] - mapping->chunkOffsets[c];
+                u8* out = dst + (chunkBegin + from - offset);
+
+                if (srcSize == chunkLength)
+                {
+                    MemCopy(out, src + from, to - from);
+                    continue;
+                }
+
+                usize decompressed;
+                if (from == 0 && to == chunkLength)
+                {
+                    decompressed = Compression::Decompress(src, srcSize, out, chunkLength);
+                }
+                else
+                {
+                    chunk.Resize(chunkLength);
+                    decompressed = Compression::Decompress(src, srcSize, chunk.Data(), chunkLength);
+                    if (decompressed == chunkLength)
+                    {
+                        MemCopy(out, chunk.Data() + from, to - from);
+                    }
+                }
+
+                if (decompressed != chunkLength)
+                {
+                    logger.Error("stream chunk {} is corrupted, decoded {} of {} bytes", c, decompressed, chunkLength);
+                    return false;
+                }
+                decoded += chunkLength;
+            }
+
+            mapping->decodedBytes += decoded;
+            mapping->decodeTime += static_cast<u64>((Platform::GetTime() - startTime) * 1000000000.0);
+            return true;
+        }
+
+        void StreamWriterThread(StreamWriter* writer)
+        {
+            while (true)
+            {
+                Array<u8> buffer{};
+                {
+                    std::unique_lock lock(writer->mutex);
+                    writer->condition.wait(lock, [&]
+                    {
+                        return writer->finished || !writer->pending.Empty();
+                    });
+
+                    if (writer->pending.Empty())
+                    {
+                        return;
+                    }
+
+                    buffer = Traits::Move(writer->pending[0]);
+                    writer->pending.Remove(0);
+                }
+
+                for (usize offset = 0; offset < buffer.Size(); offset += StreamChunkSize)
+                {
+                    u64 hash[2];
+                    MurmurHash3X64128(buffer.Data() + offset, static_cast<u32>(Math::Min(static_cast<usize>(StreamChunkSize), buffer.Size() - offset)), 0, hash);
+                    writer->chunkHashes.EmplaceBack(StreamHash{hash[0], hash[1]});
+                }
+
+                bool failed = !writer->fileHandler || FileSystem::WriteFile(writer->fileHandler, buffer.Data(), buffer.Size()) != buffer.Size();
+
+                {
+                    std::unique_lock lock(writer->mutex);
+                    writer->failed |= failed;
+                    buffer.Clear();
+                    writer->freeBuffers.EmplaceBack(Traits::Move(buffer));
+                }
+                writer->condition.notify_all();
+            }
+        }
+
+        //hands the current buffer to the writer thread, waits while all buffers are in flight.
+        void StreamWriterFlush(StreamWriter* writer)
+        {
+            std::unique_lock lock(writer->mutex);
+            writer->pending.EmplaceBack(Traits::Move(writer->current));
+            writer->condition.notify_all();
+
+            writer->condition.wait(lock, [&]
+            {
+                return !writer->freeBuffers.Empty() || writer->bufferCount < WriteBehindBufferCount;
+            });
+
+            if (!writer->freeBuffers.Empty())
+            {
+                writer->current = Traits::Move(writer->freeBuffers.Back());
+                writer->freeBuffers.PopBack();
+            }
+            else
+            {
+                writer->current = Array<u8>{};
+                writer->current.Reserve(WriteBehindBufferSize);
+                writer->bufferCount++;
+            }
+        }
+
+        //returns false if any write failed, the temp file is left to the caller.
+        bool StreamWriterFinish(StreamWriter* writer)
+        {
+            if (!writer->current.Empty())
+            {
+                std::unique_lock lock(writer->mutex);
+                writer->pending.EmplaceBack(Traits::Move(writer->current));
+            }
+
+            {
+                std::unique_lock lock(writer->mutex);
+                writer->finished = true;
+            }
+            writer->condition.notify_all();
+            writer->thread.join();
+
+            if (writer->fileHandler)
+            {
+                FileSystem::CloseFile(writer->fileHandler);
+            }
+            return !writer->failed;
+        }
+
+        String GetBufferFile(const StreamObject* streamObject)
         {
 
             if (!streamObject->MappedTo().Empty())
@@ -371,6 +750,14 @@ namespace Fyrion
         RID rid = GetID(uuid);
         ResourceStorage* resourceStorage = GetOrAllocate(rid);
 
+        //the resource is already alive, it's being parsed again. keep the storage (parent, version and events)
+        //and start the next write from an empty data.
+        if (uuid && resourceStorage->rid == rid && resourceStorage->data && resourceStorage->typeId == typeId && !resourceStorage->markedToDestroy)
+        {
+            resourceStorage->resetOnWrite = true;
+            return rid;
+        }
+
         new(PlaceHolder(), resourceStorage) ResourceStorage{
             .rid = rid,
             .uuid = uuid,
@@ -426,7 +813,13 @@ namespace Fyrion
         data->fields.Resize(resourceType->fieldsByIndex.Size());
         data->readOnly = false;
 
-        if (storage->data)
+        if (storage->data && storage->resetOnWrite)
+        {
+            data->dataOnWrite = storage->data.load();
+            data->reset = true;
+            storage->resetOnWrite = false;
+        }
+        else if (storage->data)
         {
             ResourceData* copyData = storage->data.load();
             data->dataOnWrite = copyData;
@@ -458,6 +851,71 @@ namespace Fyrion
         storage->markedToDestroy = true;
     }
 
+    void Repository::ReplaceResource(RID rid, RID source)
+    {
+        ResourceStorage* storage = &pages[rid.page]->elements[rid.offset];
+        ResourceStorage* sourceStorage = &pages[source.page]->elements[source.offset];
+        FY_ASSERT(storage->resourceType == sourceStorage->resourceType, "resources must have the same type");
+
+        ResourceData* oldData = storage->data.load();
+        ResourceData* newData = sourceStorage->data.load();
+
+        if (newData)
+        {
+            newData->storage = storage;
+            ForEachSubObject(newData, [&](ResourceStorage* subobject)
+            {
+                subobject->parent = storage;
+            });
+        }
+
+        //old subobjects are destroyed with the old data, detach them to not write on this resource again.
+        ForEachSubObject(oldData, [&](ResourceStorage* subobject)
+        {
+            subobject->parent = nullptr;
+            subobject->parentIndex = U32_MAX;
+        });
+
+        storage->data = newData;
+        sourceStorage->data = nullptr;
+
+        if (storage->resourceType)
+        {
+            ResourceEventType eventType = oldData ? ResourceEventType::Update : ResourceEventType::Insert;
+            for (auto itEvent: storage->resourceType->events)
+            {
+                if ((itEvent.second.eventType && eventType) != 0)
+                {
+                    ResourceObject oldObject{oldData, true};
+                    ResourceObject newObject{newData, true};
+                    itEvent.second.event(itEvent.second.userData, eventType, oldObject, newObject);
+                }
+            }
+        }
+
+        UpdateVersion(storage);
+
+        if (oldData)
+        {
+            toCollectItems.enqueue(ToDestroyResourceData{
+                .data = oldData,
+                .destroySubObjects = true,
+                .destroyResource = false
+            });
+        }
+
+        if (sourceStorage->uuid)
+        {
+            std::unique_lock lock(byUUIDMutex);
+            byUUID.Erase(sourceStorage->uuid);
+        }
+
+        RemoveFromResourcesByType(sourceStorage->typeId, source);
+
+        sourceStorage->~ResourceStorage();
+        MemSet(sourceStorage, 0, sizeof(ResourceStorage));
+    }
+
     void Repository::GarbageCollect()
     {
         ToDestroyResourceData data{};
@@ -563,6 +1021,15 @@ namespace Fyrion
         ResourceStorage* prototypeStorage = &pages[prototype.page]->elements[prototype.offset];
         FY_ASSERT(prototypeStorage->resourceType, "Prototype can't be created from resources without types");
 
+        //already alive, clear the overrides in place.
+        if (uuid && resourceStorage->rid == rid && resourceStorage->data && resourceStorage->prototype == prototypeStorage && !resourceStorage->markedToDestroy)
+        {
+            resourceStorage->resetOnWrite = true;
+            ResourceObject object = Write(rid);
+            object.Commit();
+            return rid;
+        }
+
         ResourceData* data = allocator.Alloc<ResourceData>();
         data->storage = resourceStorage;
         data->memory  = nullptr;
@@ -688,23 +1155,18 @@ namespace Fyrion
 
     RID Repository::GetOrCreateByUUID(const UUID& uuid, TypeID typeId)
     {
-        {
-            std::unique_lock lock(byUUIDMutex);
+        std::unique_lock lock(byUUIDMutex);
 
-            auto it = byUUID.Find(uuid);
-            if (it != byUUID.end())
-            {
-                return it->second;
-            }
+        auto it = byUUID.Find(uuid);
+        if (it != byUUID.end())
+        {
+            return it->second;
         }
 
         RID rid = GetID();
-        {
-            std::unique_lock lock(byUUIDMutex);
-            byUUID.Insert(uuid, rid);
-        }
+        byUUID.Insert(uuid, rid);
 
-        ResourceStorage* storage      = &pages[rid.page]->elements[rid.offset];
+        ResourceStorage* storage      = GetOrAllocate(rid);
         ResourceType   * resourceType = nullptr;
 
         if (auto it = resourceTypes.Find(typeId))
@@ -775,6 +1237,12 @@ namespace Fyrion
         return storage->rid.id != 0;
     }
 
+    bool Repository::IsStreamFileMapped(const StringView& file)
+    {
+        std::unique_lock lock(streamMappingMutex);
+        return streamMappings.Find(String{file}) != streamMappings.end();
+    }
+
     bool Repository::IsEmpty(RID rid)
     {
         ResourceStorage* storage = &pages[rid.page]->elements[rid.offset];
@@ -1097,6 +1565,11 @@ namespace Fyrion
 
                 UpdateVersion(m_data->storage);
 
+                if (m_data->reset)
+                {
+                    DestroyRemovedSubObjects(m_data->dataOnWrite, m_data);
+                }
+
                 toCollectItems.enqueue(ToDestroyResourceData{
                     .data = m_data->dataOnWrite,
                     .destroySubObjects = false,
@@ -1194,12 +1667,59 @@ namespace Fyrion
         return static_cast<StreamObject*>(m_data->fields[index]);
     }
 
-    void StreamObject::MapTo(const StringView& file, usize offset)
+    StreamObject::StreamObject(const StreamObject& other) : m_id(other.m_id), m_hash(other.m_hash), m_mapFile(other.m_mapFile), m_mapOffset(other.m_mapOffset), m_encoding(other.m_encoding)
+    {
+        SetMapping(other.m_mapping);
+    }
+
+    StreamObject& StreamObject::operator=(const StreamObject& other)
+    {
+        if (this != &other)
+        {
+            m_id = other.m_id;
+            m_hash = other.m_hash;
+            m_mapFile = other.m_mapFile;
+            m_mapOffset = other.m_mapOffset;
+            m_encoding = other.m_encoding;
+            SetMapping(other.m_mapping);
+        }
+        return *this;
+    }
+
+    StreamObject::~StreamObject()
+    {
+        if (m_writer)
+        {
+            StreamWriterFinish(m_writer);
+            FileSystem::Remove(m_writer->tempFile);
+            allocator.DestroyAndFree(m_writer);
+        }
+        SetMapping(nullptr);
+    }
+
+    void StreamObject::SetMapping(StreamMapping* mapping)
+    {
+        if (mapping)
+        {
+            mapping->references++;
+        }
+
+        ReleaseStreamMapping(m_mapping);
+        m_mapping = mapping;
+    }
+
+    void StreamObject::MapTo(const StringView& file, usize offset, StreamEncoding encoding)
     {
         m_mapFile = file;
+        m_mapOffset = offset;
+        m_encoding = encoding;
+
+        StreamMapping* mapping = AcquireStreamMapping(file, encoding);
+        SetMapping(mapping);
+        ReleaseStreamMapping(mapping);
     }
 
-    StringView StreamObject::MappedTo()
+    StringView StreamObject::MappedTo() const
     {
         return m_mapFile;
     }
@@ -1207,21 +1727,346 @@ namespace Fyrion
     void StreamObject::Set(VoidPtr data, usize size)
     {
         m_mapFile.Clear();
-        FileHandler fileHandler = FileSystem::OpenFile(GetBufferFile(this), AccessMode::WriteOnly);
+        m_mapOffset = 0;
+        m_encoding = StreamEncoding::Raw;
+        m_hash = {};
+
+        //other versions of this stream can still have the old file mapped, so it's replaced instead of overwritten.
+        String bufferFile = GetBufferFile(this);
+        String tempFile = bufferFile + FY_TEMP_EXTENSION;
+
+        FileHandler fileHandler = FileSystem::OpenFile(tempFile, AccessMode::WriteOnly);
         FileSystem::WriteFile(fileHandler, data, size);
         FileSystem::CloseFile(fileHandler);
+        FileSystem::Rename(tempFile, bufferFile);
+
+        SetMapping(CreateStreamMapping(bufferFile, StreamEncoding::Raw));
     }
 
-    usize StreamObject::Size()
+    void StreamObject::BeginWrite()
     {
-        return FileSystem::GetFileStatus(GetBufferFile(this)).fileSize;
+        FY_ASSERT(!m_writer, "stream is already being written");
+
+        m_mapFile.Clear();
+        m_mapOffset = 0;
+        m_encoding = StreamEncoding::Raw;
+        m_hash = {};
+
+        m_writer = allocator.Alloc<StreamWriter>();
+        m_writer->bufferFile = GetBufferFile(this);
+        m_writer->tempFile = m_writer->bufferFile + FY_TEMP_EXTENSION;
+        m_writer->fileHandler = FileSystem::OpenFile(m_writer->tempFile, AccessMode::WriteOnly);
+        m_writer->failed = !m_writer->fileHandler;
+        m_writer->current.Reserve(WriteBehindBufferSize);
+        m_writer->bufferCount = 1;
+        m_writer->thread = std::thread(StreamWriterThread, m_writer);
     }
 
-    void StreamObject::Get(VoidPtr data, usize size, usize offset)
+    void StreamObject::Append(ConstPtr data, usize size)
     {
-        FileHandler fileHandler = FileSystem::OpenFile(GetBufferFile(this), AccessMode::ReadOnly);
-        FileSystem::ReadFile(fileHandler, data, size);
-        FileSystem::CloseFile(fileHandler);
+        FY_ASSERT(m_writer, "BeginWrite must be called before Append");
+
+        const u8* bytes = static_cast<const u8*>(data);
+        m_writer->size += size;
+
+        while (size > 0)
+        {
+            usize copySize = Math::Min(size, WriteBehindBufferSize - m_writer->current.Size());
+            m_writer->current.Insert(m_writer->current.end(), bytes, bytes + copySize);
+            bytes += copySize;
+            size -= copySize;
+
+            if (m_writer->current.Size() == WriteBehindBufferSize)
+            {
+                StreamWriterFlush(m_writer);
+            }
+        }
+    }
+
+    bool StreamObject::EndWrite()
+    {
+        FY_ASSERT(m_writer, "BeginWrite must be called before EndWrite");
+
+        StreamWriter* writer = m_writer;
+        m_writer = nullptr;
+
+        //the buffer file is only replaced once the whole stream is written.
+        bool success = StreamWriterFinish(writer) && FileSystem::Rename(writer->tempFile, writer->bufferFile);
+        if (success)
+        {
+            u64 hash[2];
+            MurmurHash3X64128(writer->chunkHashes.Data(), static_cast<u32>(writer->chunkHashes.Size() * sizeof(StreamHash)), static_cast<u32>(writer->size), hash);
+
+            SetMapping(CreateStreamMapping(writer->bufferFile, StreamEncoding::Raw));
+            m_hash = StreamHash{hash[0], hash[1]};
+        }
+        else
+        {
+            logger.Error("Failed to write stream {}", writer->bufferFile);
+            FileSystem::Remove(writer->tempFile);
+        }
+
+        allocator.DestroyAndFree(writer);
+        return success;
+    }
+
+    usize StreamObject::Size() const
+    {
+        if (m_mapping && m_mapping->header)
+        {
+            return m_mapping->header->size;
+        }
+
+        if (m_mapping && m_mapping->fileMapping.size > m_mapOffset)
+        {
+            return m_mapping->fileMapping.size - m_mapOffset;
+        }
+        return 0;
+    }
+
+    void StreamObject::Get(VoidPtr data, usize size, usize offset) const
+    {
+        if (IsCompressed())
+        {
+            usize available = Size();
+            if (offset < available && size > 0)
+            {
+                usize readSize = Math::Min(size, available - offset);
+                if (!DecodeStreamChunks(m_mapping, m_mapping->fileMapping.data, 0, static_cast<u8*>(data), offset, readSize))
+                {
+                    //no partially decoded data is returned.
+                    MemSet(data, 0, readSize);
+                }
+            }
+            return;
+        }
+
+        Span<const u8> range = Map(offset, size);
+        MemCopy(data, range.Data(), range.Size());
+    }
+
+    Span<const u8> StreamObject::Map(usize offset, usize size) const
+    {
+        usize available = Size();
+        if (offset >= available)
+        {
+            return {};
+        }
+
+        usize mapSize = Math::Min(size, available - offset);
+
+        const u8* begin = nullptr;
+        if (IsCompressed())
+        {
+            //only the chunks in the range are decoded, the decoded chunks are shared by all copies.
+            const StreamChunkHeader* header = m_mapping->header;
+
+            std::unique_lock lock(m_mapping->cacheMutex);
+            if (!m_mapping->cache)
+            {
+                m_mapping->cache = static_cast<u8*>(allocator.MemAlloc(available, 1));
+                m_mapping->decodedChunks.Resize(header->chunkCount);
+            }
+
+            if (mapSize > 0)
+            {
+                usize first = offset / header->chunkSize;
+                usize last = (offset + mapSize - 1) / header->chunkSize;
+                for (usize c = first; c <= last; ++c)
+                {
+                    if (m_mapping->decodedChunks[c])
+                    {
+                        continue;
+                    }
+
+                    usize chunkBegin = c * header->chunkSize;
+                    usize chunkLength = Math::Min(static_cast<usize>(header->chunkSize), available - chunkBegin);
+                    if (!DecodeStreamChunks(m_mapping, m_mapping->fileMapping.data, 0, m_mapping->cache + chunkBegin, chunkBegin, chunkLength))
+                    {
+                        return {};
+                    }
+                    m_mapping->decodedChunks[c] = true;
+                }
+            }
+            begin = m_mapping->cache + offset;
+        }
+        else
+        {
+            begin = m_mapping->fileMapping.data + m_mapOffset + offset;
+        }
+
+        return {begin, mapSize};
+    }
+
+    IORequest StreamObject::GetAsync(VoidPtr data, usize size, usize offset, IOPriority priority, VoidPtr userData, FnIOCallback callback) const
+    {
+        usize available = Size();
+        usize readSize = offset < available ? Math::Min(size, available - offset) : 0;
+
+        if (!IsCompressed() || readSize == 0)
+        {
+            return AsyncIO::Read(GetBufferFile(this), m_mapOffset + offset, readSize, data, priority, userData, callback);
+        }
+
+        //reads the compressed bytes of the chunks in the range and decodes them on the IO thread.
+        struct AsyncChunkRead
+        {
+            StreamObject stream;
+            Array<u8>    buffer;
+            u64          bufferOffset;
+            u8*          data;
+            usize        offset;
+            usize        size;
+            VoidPtr      userData;
+            FnIOCallback callback;
+        };
+
+        const StreamChunkHeader* header = m_mapping->header;
+        u64 begin = m_mapping->chunkOffsets[offset / header->chunkSize];
+        u64 end = m_mapping->chunkOffsets[(offset + readSize - 1) / header->chunkSize + 1];
+
+        AsyncChunkRead* chunkRead = allocator.Alloc<AsyncChunkRead>(*this, Array<u8>(end - begin), begin, static_cast<u8*>(data), offset, readSize, userData, callback);
+
+        return AsyncIO::Read(GetBufferFile(this), begin, end - begin, chunkRead->buffer.Data(), priority, chunkRead, [](VoidPtr userData, IOResult result, usize bytes)
+        {
+            AsyncChunkRead* chunkRead = static_cast<AsyncChunkRead*>(userData);
+            if (result == IOResult::Success && bytes == chunkRead->buffer.Size() &&
+                DecodeStreamChunks(chunkRead->stream.m_mapping, chunkRead->buffer.Data(), chunkRead->bufferOffset, chunkRead->data, chunkRead->offset, chunkRead->size))
+            {
+                chunkRead->callback(chunkRead->userData, IOResult::Success, chunkRead->size);
+            }
+            else
+            {
+                chunkRead->callback(chunkRead->userData, result == IOResult::Success ? IOResult::Failed : result, 0);
+            }
+            allocator.DestroyAndFree(chunkRead);
+        });
+    }
+
+    bool StreamObject::IsCompressed() const
+    {
+        return m_mapping && m_mapping->header;
+    }
+
+    void StreamObject::Compress(Array<u8>& data) const
+    {
+        if (IsCompressed())
+        {
+            data.Resize(m_mapping->fileMapping.size);
+            MemCopy(data.Data(), m_mapping->fileMapping.data, m_mapping->fileMapping.size);
+            return;
+        }
+
+        Span<const u8> raw = Map(0, Size());
+        usize chunkCount = (raw.Size() + StreamChunkSize - 1) / StreamChunkSize;
+
+        Array<Array<u8>> chunks(chunkCount);
+        Parallel::For(chunkCount, 0, [&](usize c)
+        {
+            const u8* src = raw.Data() + c * StreamChunkSize;
+            usize length = Math::Min(static_cast<usize>(StreamChunkSize), raw.Size() - c * StreamChunkSize);
+
+            Array<u8>& chunk = chunks[c];
+            chunk.Resize(Compression::CompressBound(length));
+            usize compressedSize = Compression::Compress(src, length, chunk.Data(), chunk.Size());
+
+            //not worth it, stored as is.
+            if (compressedSize == 0 || compressedSize >= length)
+            {
+                chunk.Resize(length);
+                MemCopy(chunk.Data(), src, length);
+            }
+            else
+            {
+                chunk.Resize(compressedSize);
+            }
+        });
+
+        usize tableSize = sizeof(StreamChunkHeader) + (chunkCount + 1) * sizeof(u64);
+        usize totalSize = tableSize;
+        for (const Array<u8>& chunk : chunks)
+        {
+            totalSize += chunk.Size();
+        }
+
+        data.Resize(totalSize);
+
+        StreamChunkHeader header{
+            .magic = StreamChunkMagic,
+            .chunkSize = StreamChunkSize,
+            .size = raw.Size(),
+            .chunkCount = chunkCount
+        };
+        MemCopy(data.Data(), &header, sizeof(StreamChunkHeader));
+
+        u64* offsets = reinterpret_cast<u64*>(data.Data() + sizeof(StreamChunkHeader));
+        u64 offset = tableSize;
+        for (usize c = 0; c < chunkCount; ++c)
+        {
+            offsets[c] = offset;
+            MemCopy(data.Data() + offset, chunks[c].Data(), chunks[c].Size());
+            offset += chunks[c].Size();
+        }
+        offsets[chunkCount] = offset;
+    }
+
+    StreamCompressionStats StreamObject::GetCompressionStats() const
+    {
+        StreamCompressionStats stats{};
+        stats.size = Size();
+
+        if (IsCompressed())
+        {
+            stats.compressedSize = m_mapping->fileMapping.size;
+            stats.decodedBytes = m_mapping->decodedBytes;
+
+            u64 decodeTime = m_mapping->decodeTime;
+            if (decodeTime > 0)
+            {
+                stats.decodeGBs = static_cast<f64>(stats.decodedBytes) / static_cast<f64>(decodeTime);
+            }
+        }
+        else
+        {
+            stats.compressedSize = stats.size;
+        }
+
+        if (stats.compressedSize > 0)
+        {
+            stats.ratio = static_cast<f64>(stats.size) / static_cast<f64>(stats.compressedSize);
+        }
+        return stats;
+    }
+
+    StreamHash StreamObject::ComputeContentHash() const
+    {
+        Span<const u8> data = Map(0, Size());
+        usize chunkCount = (data.Size() + StreamChunkSize - 1) / StreamChunkSize;
+
+        Array<StreamHash> chunkHashes(chunkCount);
+        Parallel::For(chunkCount, 0, [&](usize c)
+        {
+            usize offset = c * StreamChunkSize;
+            usize length = Math::Min(static_cast<usize>(StreamChunkSize), data.Size() - offset);
+
+            u64 hash[2];
+            MurmurHash3X64128(data.Data() + offset, static_cast<u32>(length), 0, hash);
+            chunkHashes[c] = StreamHash{hash[0], hash[1]};
+        });
+
+        u64 hash[2];
+        MurmurHash3X64128(chunkHashes.Data(), static_cast<u32>(chunkHashes.Size() * sizeof(StreamHash)), static_cast<u32>(data.Size()), hash);
+        return StreamHash{hash[0], hash[1]};
+    }
+
+    StreamHash StreamObject::GetContentHash() const
+    {
+        return m_hash;
+    }
+
+    void StreamObject::SetContentHash(const StreamHash& hash)
+    {
+        m_hash = hash;
     }
 
     u64 StreamObject::GetBufferId() const
@@ -1266,6 +2111,7 @@ namespace Fyrion
         resourceTypesByName.Clear();
         byUUID.Clear();
         byPath.Clear();
+        resourcesByType.Clear();
     }
 
     void RegisterResourceTypes()
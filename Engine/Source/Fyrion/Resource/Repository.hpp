@@ -41,6 +41,7 @@ namespace Fyrion
         FY_API RID            GetOrCreateByUUID(const UUID& uuid, TypeID typeId);
         FY_API void           ClearValues(RID rid);
         FY_API void           DestroyResource(RID rid);
+        FY_API void           ReplaceResource(RID rid, RID source);
         FY_API RID            CloneResource(RID rid);
         FY_API ResourceObject Read(RID rid);
         FY_API ResourceObject ReadNoPrototypes(RID rid);
@@ -53,6 +54,9 @@ namespace Fyrion
         FY_API bool           IsEmpty(RID rid);
         FY_API u32            GetVersion(RID rid);
 
+        //true while a stream of any alive version, including the ones not collected yet, maps the file.
+        FY_API bool           IsStreamFileMapped(const StringView& file);
+
         FY_API void GarbageCollect();
 
         template <typename T>
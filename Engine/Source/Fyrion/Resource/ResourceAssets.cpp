@@ -5,13 +5,44 @@
 #include "Fyrion/IO/Path.hpp"
 #include "Fyrion/IO/FileSystem.hpp"
 #include "ResourceSerialization.hpp"
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+#include "Fyrion/IO/FileWatcher.hpp"
+#include "Fyrion/IO/FileTransaction.hpp"
+#include "Fyrion/Core/HashSet.hpp"
+
+#include <mutex>
+
+namespace Fyrion
+{
+    struct AssetLoadDirectory
+    {
+        RID    rid{};
+        String absolutePath{};
+    };
+
+    struct AssetLoadFile
+    {
+        RID    directory{};
+        String absolutePath{};
+        String extension{};
+        RID    asset{};
+        RID    object{};
+        bool   loaded{};
+        u64    lastModifiedTime{};
+        Array<String> streamBlobs{};
+    };
+}
 
 namespace Fyrion::ResourceAssets
 {
-    void LoadAssetFile(ResourceObject& assetRoot, RID directoryAsset, const StringView& assetFile);
+    void EnumerateDirectory(const AssetLoadDirectory& directory, Array<AssetLoadDirectory>& directories, Array<AssetLoadFile>& files);
+    void LoadAssetFile(AssetLoadFile& file, const StringView& storeDirectory);
     String MakeDirectoryAbsolutePath(RID rid);
     String MakeAssetAbsolutePath(RID rid);
-    void UpdateStreams(RID rid, const StringView& assetFile);
+    void UpdateStreams(RID rid, const StringView& assetFile, const StringView& storeDirectory, Array<String>& streamBlobs);
+    String GetStoreDirectory(RID rid);
+    void SetStreamReferences(Array<String>& streamBlobs, Array<String>&& newStreamBlobs);
 }
 
 namespace Fyrion
@@ -20,6 +51,8 @@ namespace Fyrion
     {
         u32    loadedVersion;
         String absolutePath;
+        u64    lastModifiedTime;
+        Array<String> streamBlobs;
     };
 
     namespace
@@ -27,40 +60,65 @@ namespace Fyrion
         HashMap<String, FnImportAsset>      assetImporters{};
         HashMap<String, RID>                assetRoots{};
         HashMap<RID, AssetFileInfo>         assetFileInfos{};
+        u32                                 loadWorkerCount{};
+        AssetLoadStats                      lastLoadStats{};
+        FileWatcher*                        fileWatcher{};
+        bool                                hotReloadEnabled = false;
+        AssetReloadStats                    reloadStats{};
+        HashMap<String, u32>                streamReferences{};
+        std::mutex                          dependenciesMutex{};
+        HashMap<RID, Array<String>>         assetDependencies{};
         Logger& logger = Logger::GetLogger("Fyrion::ResourceAssets", LogLevel::Debug);
     }
 
-    void ResourceAssets::LoadAssetFile(ResourceObject& assetRoot, RID directoryAsset, const StringView& assetFile)
+    void ResourceAssets::EnumerateDirectory(const AssetLoadDirectory& directory, Array<AssetLoadDirectory>& directories, Array<AssetLoadFile>& files)
     {
-        String extension = Path::Extension(assetFile);
-        if (extension == FY_DATA_EXTENSION) return;
-
-        if (FileSystem::GetFileStatus(assetFile).isDirectory)
+        for (const auto& entry: DirectoryEntries{directory.absolutePath})
         {
-            RID rid = Repository::CreateResource<AssetDirectory>();
+            String extension = Path::Extension(entry);
+            if (extension == FY_DATA_EXTENSION) continue;
 
-            ResourceObject assetDirectory = Repository::Write(rid);
-            assetDirectory.SetValue(AssetDirectory::Name, Path::Name(assetFile));
-            assetDirectory.SetValue(AssetDirectory::Parent, directoryAsset);
-            assetDirectory.Commit();
+            //leftover of a save that was interrupted before its commit.
+            if (extension == FY_TEMP_EXTENSION)
+            {
+                FileSystem::Remove(entry);
+                continue;
+            }
 
-            assetFileInfos.Insert(rid, AssetFileInfo{
-                .loadedVersion = Repository::GetVersion(rid),
-                .absolutePath = assetFile
-            });
+            if (FileSystem::GetFileStatus(entry).isDirectory)
+            {
+                RID rid = Repository::CreateResource<AssetDirectory>();
 
-            assetRoot.AddToSubObjectSet(AssetRoot::Directories, rid);
+                ResourceObject assetDirectory = Repository::Write(rid);
+                assetDirectory.SetValue(AssetDirectory::Name, Path::Name(entry));
+                assetDirectory.SetValue(AssetDirectory::Parent, directory.rid);
+                assetDirectory.Commit();
 
-            for (const auto& entry: DirectoryEntries{assetFile})
+                directories.EmplaceBack(AssetLoadDirectory{
+                    .rid = rid,
+                    .absolutePath = entry
+                });
+            }
+            else if (extension == FY_ASSET_EXTENSION || assetImporters.Has(extension))
             {
-                LoadAssetFile(assetRoot, rid, entry);
+                files.EmplaceBack(AssetLoadFile{
+                    .directory = directory.rid,
+                    .absolutePath = entry,
+                    .extension = extension
+                });
             }
         }
-        else if (extension == FY_ASSET_EXTENSION)
+    }
+
+    void ResourceAssets::LoadAssetFile(AssetLoadFile& file, const StringView& storeDirectory)
+    {
+        file.lastModifiedTime = FileSystem::GetFileStatus(file.absolutePath).lastModifiedTime;
+
+        if (file.extension == FY_ASSET_EXTENSION)
         {
             String buffer = {};
 
-            FileHandler handler = FileSystem::OpenFile(assetFile, AccessMode::ReadOnly);
+            FileHandler handler = FileSystem::OpenFile(file.absolutePath, AccessMode::ReadOnly);
             usize size = FileSystem::GetFileSize(handler);
             buffer.Resize(size);
             FileSystem::ReadFile(handler, buffer.begin(), size);
@@ -68,78 +126,138 @@ namespace Fyrion
 
             if (buffer.Empty()) return;
 
-            RID object = ResourceSerialization::ParseResourceInfo(buffer);
-
-            UpdateStreams(object, assetFile);
-
-            RID rid = Repository::CreateResource<Asset>();
-            ResourceObject asset = Repository::Write(rid);
-            asset.SetValue(Asset::Name, Path::Name(assetFile));
-            asset.SetValue(Asset::Directory, directoryAsset);
-            asset.SetSubObject(Asset::Object, object);
-            asset.SetValue(Asset::Extension, FY_ASSET_EXTENSION);
-            asset.Commit();
-
-            assetRoot.AddToSubObjectSet(AssetRoot::Assets, rid);
-
-            assetFileInfos.Insert(rid, AssetFileInfo{
-                .loadedVersion = Repository::GetVersion(rid),
-                .absolutePath = assetFile
-            });
+            file.object = ResourceSerialization::ParseResourceInfo(buffer);
+            UpdateStreams(file.object, file.absolutePath, storeDirectory, file.streamBlobs);
+            file.loaded = true;
         }
-        else if (auto it = assetImporters.Find(extension))
+        else if (auto it = assetImporters.Find(file.extension))
         {
             FnImportAsset importAsset = it->second;
             if (importAsset)
             {
-                RID rid = Repository::CreateResource<Asset>();
+                file.object = importAsset(file.asset, file.absolutePath);
+                file.loaded = true;
+            }
+        }
+    }
 
-                ResourceObject asset = Repository::Write(rid);
-                asset.SetValue(Asset::Name, Path::Name(assetFile));
-                asset.SetValue(Asset::Directory, directoryAsset);
-                asset.SetValue(Asset::Extension, Path::Extension(assetFile));
+    void ResourceAssets::UpdateStreams(RID rid, const StringView& assetFile, const StringView& storeDirectory, Array<String>& streamBlobs)
+    {
+        //streams saved before the content store are still on the data directory of the asset.
+        String dataPath =  Path::Join(Path::Parent(assetFile), Path::Name(assetFile), FY_DATA_EXTENSION);
+        bool hasDataPath = FileSystem::GetFileStatus(dataPath).exists;
 
-                assetRoot.AddToSubObjectSet(AssetRoot::Assets, rid);
+        ResourceObject read = Repository::ReadNoPrototypes(rid);
+        u32 valueCount = read.GetValueCount();
+        for (int i = 0; i < valueCount; ++i)
+        {
+            if (read.GetResourceType(i) == ResourceFieldType::Stream)
+            {
+                StreamObject* streamObject = read.GetStream(i);
+                if (!streamObject) continue;
 
-                RID object = importAsset(rid, assetFile);
-                if (object)
+                if (StreamHash hash = streamObject->GetContentHash())
                 {
-                    asset.SetSubObject(Asset::Object, object);
+                    String blobPath = Path::Join(storeDirectory, hash.ToString());
+                    streamObject->MapTo(blobPath, 0, StreamEncoding::Chunked);
+                    streamBlobs.EmplaceBack(blobPath);
+                }
+                else if (hasDataPath)
+                {
+                    char strBuffer[17]{};
+                    usize bufSize = U64ToHex(streamObject->GetBufferId(), strBuffer);
+                    StringView streamName = {strBuffer, bufSize};
+                    String streamPath =  Path::Join(dataPath, streamName);
+                    streamObject->MapTo(streamPath, 0);
                 }
+            }
+        }
+    }
 
-                asset.Commit();
+    String ResourceAssets::GetStoreDirectory(RID rid)
+    {
+        while (rid && Repository::GetResourceTypeID(rid) != GetTypeID<AssetRoot>())
+        {
+            rid = GetParent(rid);
+        }
 
-                assetFileInfos.Insert(rid, AssetFileInfo{
-                    .loadedVersion = Repository::GetVersion(rid),
-                    .absolutePath = assetFile
-                });
+        auto it = assetFileInfos.Find(rid);
+        if (!rid || it == assetFileInfos.end())
+        {
+            return {};
+        }
+        return Path::Join(it->second.absolutePath, FY_STORE_EXTENSION);
+    }
+
+    //blobs are reference counted by the assets that are saved or loaded with them.
+    void ResourceAssets::SetStreamReferences(Array<String>& streamBlobs, Array<String>&& newStreamBlobs)
+    {
+        for (const String& blob : newStreamBlobs)
+        {
+            auto it = streamReferences.Find(blob);
+            if (it == streamReferences.end())
+            {
+                it = streamReferences.Insert(blob, 0).first;
+            }
+            it->second++;
+        }
+
+        for (const String& blob : streamBlobs)
+        {
+            if (auto it = streamReferences.Find(blob))
+            {
+                it->second--;
             }
         }
+
+        streamBlobs = Traits::Move(newStreamBlobs);
     }
 
-    void ResourceAssets::UpdateStreams(RID rid, const StringView& assetFile)
+    u32 ResourceAssets::RemoveUnusedStreams(const StringView& directory)
     {
-        String dataPath =  Path::Join(Path::Parent(assetFile), Path::Name(assetFile), FY_DATA_EXTENSION);
-        if (FileSystem::GetFileStatus(dataPath).exists)
+        String storeDirectory = Path::Join(directory, FY_STORE_EXTENSION);
+        if (!FileSystem::GetFileStatus(storeDirectory).exists)
         {
-            ResourceObject read = Repository::ReadNoPrototypes(rid);
-            u32 valueCount = read.GetValueCount();
-            for (int i = 0; i < valueCount; ++i)
+            return 0;
+        }
+
+        Array<String> blobs{};
+        for (const String& blob : DirectoryEntries{storeDirectory})
+        {
+            blobs.EmplaceBack(blob);
+        }
+
+        u32 count = 0;
+        for (const String& blob : blobs)
+        {
+            auto it = streamReferences.Find(blob);
+            if (it != streamReferences.end() && it->second > 0)
             {
-                if (read.GetResourceType(i) == ResourceFieldType::SubObjectSet)
-                {
-                    StreamObject* streamObject = read.GetStream(i);
-                    if (streamObject)
-                    {
-                        char strBuffer[17]{};
-                        usize bufSize = U64ToHex(streamObject->GetBufferId(), strBuffer);
-                        StringView streamName = {strBuffer, bufSize};
-                        String streamPath =  Path::Join(dataPath, streamName);
-                        streamObject->MapTo(streamPath, 0);
-                    }
-                }
+                continue;
+            }
+
+            //older versions and versions kept by undo still map their blobs, they are removed after being collected.
+            if (Repository::IsStreamFileMapped(blob))
+            {
+                continue;
+            }
+
+            if (FileSystem::Remove(blob))
+            {
+                count++;
+            }
+
+            if (it != streamReferences.end())
+            {
+                streamReferences.Erase(it);
             }
         }
+
+        if (count > 0)
+        {
+            logger.Debug("{} unused streams removed from {}", count, storeDirectory);
+        }
+        return count;
     }
 
     RID ResourceAssets::LoadAssetsFromDirectory(const StringView& name, const StringView& directory)
@@ -148,6 +266,8 @@ namespace Fyrion
         {
             return {};
         }
+        FileTransaction::Recover(directory);
+
         RID rid = Repository::CreateResource<AssetRoot>();
         assetRoots.Insert(name, rid);
 
@@ -160,23 +280,288 @@ namespace Fyrion
             assetRoot.Commit();
         }
 
+        AssetLoadStats stats{
+            .workerCount = loadWorkerCount > 0 ? loadWorkerCount : Parallel::GetWorkerCount()
+        };
+
+        //stage 1: enumerate the tree level by level, each directory of the current level is listed in parallel.
+        f64 stageTime = Platform::GetTime();
+
+        Array<AssetLoadDirectory> directories{};
+        Array<AssetLoadFile>      files{};
+        Array<AssetLoadDirectory> level{};
+        level.EmplaceBack(AssetLoadDirectory{
+            .rid = rid,
+            .absolutePath = directory
+        });
+
+        while (!level.Empty())
         {
-            ResourceObject assetRoot = Repository::Write(rid);
-            for (const auto& entry: DirectoryEntries{directory})
+            Array<Array<AssetLoadDirectory>> levelDirectories(level.Size());
+            Array<Array<AssetLoadFile>>      levelFiles(level.Size());
+
+            Parallel::For(level.Size(), stats.workerCount, [&](usize index)
             {
-                LoadAssetFile(assetRoot, rid, entry);
+                EnumerateDirectory(level[index], levelDirectories[index], levelFiles[index]);
+            });
+
+            level.Clear();
+            for (usize i = 0; i < levelDirectories.Size(); ++i)
+            {
+                level.Insert(level.end(), levelDirectories[i].begin(), levelDirectories[i].end());
+                files.Insert(files.end(), levelFiles[i].begin(), levelFiles[i].end());
             }
+            directories.Insert(directories.end(), level.begin(), level.end());
+        }
+
+        stats.enumerateTime = Platform::GetTime() - stageTime;
+
+        //stage 2: read and parse or import every file in parallel.
+        //assets have their name and directory before the importers run, lookups by path don't race with the main thread.
+        stageTime = Platform::GetTime();
+
+        for (AssetLoadFile& file : files)
+        {
+            file.asset = Repository::CreateResource<Asset>();
+
+            ResourceObject asset = Repository::Write(file.asset);
+            asset.SetValue(Asset::Name, Path::Name(file.absolutePath));
+            asset.SetValue(Asset::Directory, file.directory);
+            asset.SetValue(Asset::Extension, file.extension);
+            asset.Commit();
+        }
+
+        String storeDirectory = Path::Join(directory, FY_STORE_EXTENSION);
+        Parallel::For(files.Size(), stats.workerCount, [&](usize index)
+        {
+            LoadAssetFile(files[index], storeDirectory);
+        });
+
+        stats.loadTime = Platform::GetTime() - stageTime;
+
+        //stage 3: commit all loaded assets and add everything to the asset root in a single write.
+        stageTime = Platform::GetTime();
+
+        Array<RID> directoryRids{};
+        directoryRids.Reserve(directories.Size());
+        for (const AssetLoadDirectory& loadDirectory : directories)
+        {
+            directoryRids.EmplaceBack(loadDirectory.rid);
+        }
+
+        Array<RID> assetRids{};
+        assetRids.Reserve(files.Size());
+        for (AssetLoadFile& file : files)
+        {
+            if (!file.loaded)
+            {
+                Repository::DestroyResource(file.asset);
+                file.asset = {};
+                continue;
+            }
+
+            if (file.object)
+            {
+                ResourceObject asset = Repository::Write(file.asset);
+                asset.SetSubObject(Asset::Object, file.object);
+                asset.Commit();
+            }
+
+            assetRids.EmplaceBack(file.asset);
+        }
+
+        {
+            ResourceObject assetRoot = Repository::Write(rid);
+            assetRoot.AddToSubObjectSet(AssetRoot::Directories, directoryRids);
+            assetRoot.AddToSubObjectSet(AssetRoot::Assets, assetRids);
             assetRoot.Commit();
         }
 
+        for (const AssetLoadDirectory& loadDirectory : directories)
+        {
+            assetFileInfos.Insert(loadDirectory.rid, AssetFileInfo{
+                .loadedVersion = Repository::GetVersion(loadDirectory.rid),
+                .absolutePath = loadDirectory.absolutePath
+            });
+        }
+
+        for (AssetLoadFile& file : files)
+        {
+            if (!file.asset) continue;
+
+            AssetFileInfo& info = assetFileInfos.Insert(file.asset, AssetFileInfo{
+                .loadedVersion = Repository::GetVersion(file.asset),
+                .absolutePath = file.absolutePath,
+                .lastModifiedTime = file.lastModifiedTime
+            }).first->second;
+
+            SetStreamReferences(info.streamBlobs, Traits::Move(file.streamBlobs));
+        }
+
         assetFileInfos.Insert(rid, AssetFileInfo{
             .loadedVersion = Repository::GetVersion(rid),
             .absolutePath = directory
         });
 
+        if (hotReloadEnabled)
+        {
+            if (!fileWatcher)
+            {
+                fileWatcher = MemoryGlobals::GetDefaultAllocator().Alloc<FileWatcher>();
+            }
+            fileWatcher->Watch(directory);
+        }
+
+        stats.commitTime = Platform::GetTime() - stageTime;
+        stats.directoryCount = directories.Size();
+        stats.assetCount = assetRids.Size();
+        lastLoadStats = stats;
+
+        logger.Debug("Asset root {} loaded with {} workers: {} directories, {} assets (enumerate {:.3f}s, load {:.3f}s, commit {:.3f}s)",
+                     name, stats.workerCount, stats.directoryCount, stats.assetCount, stats.enumerateTime, stats.loadTime, stats.commitTime);
+
         return rid;
     }
 
+    void ResourceAssets::SetLoadWorkerCount(u32 workerCount)
+    {
+        loadWorkerCount = workerCount;
+    }
+
+    AssetLoadStats ResourceAssets::GetLastLoadStats()
+    {
+        return lastLoadStats;
+    }
+
+    bool ResourceAssets::ReloadAsset(RID asset)
+    {
+        auto itInfo = assetFileInfos.Find(asset);
+        if (itInfo == assetFileInfos.end() || Repository::GetResourceTypeID(asset) != GetTypeID<Asset>())
+        {
+            return false;
+        }
+
+        AssetFileInfo& info = itInfo->second;
+        String extension = Path::Extension(info.absolutePath);
+
+        RID oldObject{};
+        {
+            ResourceObject read = Repository::Read(asset);
+            if (const RID* object = static_cast<const RID*>(read.GetValue(Asset::Object)))
+            {
+                oldObject = *object;
+            }
+        }
+
+        RID newObject{};
+
+        if (extension == FY_ASSET_EXTENSION)
+        {
+            //resources with the same uuid are parsed in place, the object keeps its RID.
+            String buffer = FileSystem::ReadFileAsString(info.absolutePath);
+            if (buffer.Empty()) return false;
+
+            newObject = ResourceSerialization::ParseResourceInfo(buffer);
+
+            Array<String> streamBlobs{};
+            UpdateStreams(newObject, info.absolutePath, GetStoreDirectory(asset), streamBlobs);
+            SetStreamReferences(info.streamBlobs, Traits::Move(streamBlobs));
+        }
+        else if (auto it = assetImporters.Find(extension))
+        {
+            if (!it->second) return false;
+
+            //importers always create a new resource, move it to the current one to keep RID and UUID.
+            newObject = it->second(asset, info.absolutePath);
+            if (newObject && oldObject && Repository::GetResourceType(newObject) == Repository::GetResourceType(oldObject))
+            {
+                Repository::ReplaceResource(oldObject, newObject);
+                newObject = oldObject;
+            }
+        }
+
+        if (!newObject)
+        {
+            logger.Error("Asset {} could not be reloaded", info.absolutePath);
+            return false;
+        }
+
+        if (newObject != oldObject)
+        {
+            ResourceObject write = Repository::Write(asset);
+            write.SetSubObject(Asset::Object, newObject);
+            write.Commit();
+
+            if (oldObject)
+            {
+                Repository::DestroyResource(oldObject);
+            }
+        }
+
+        info.loadedVersion = Repository::GetVersion(asset);
+        info.lastModifiedTime = FileSystem::GetFileStatus(info.absolutePath).lastModifiedTime;
+
+        logger.Debug("Asset {} reloaded", info.absolutePath);
+
+        return true;
+    }
+
+    void ResourceAssets::SetAssetDependencies(RID asset, const Array<String>& files)
+    {
+        //importers run on loader threads.
+        std::unique_lock lock(dependenciesMutex);
+        if (files.Empty())
+        {
+            assetDependencies.Erase(asset);
+            return;
+        }
+
+        auto it = assetDependencies.Find(asset);
+        if (it == assetDependencies.end())
+        {
+            it = assetDependencies.Insert(asset, Array<String>{}).first;
+        }
+        it->second = files;
+    }
+
+    Array<RID> ResourceAssets::GetAssetDependents(const StringView& file)
+    {
+        std::unique_lock lock(dependenciesMutex);
+        Array<RID> dependents{};
+        for (const auto& it : assetDependencies)
+        {
+            for (const String& dependency : it.second)
+            {
+                if (dependency == file)
+                {
+                    dependents.EmplaceBack(it.first);
+                    break;
+                }
+            }
+        }
+        return dependents;
+    }
+
+    void ResourceAssets::SetHotReloadEnabled(bool enabled)
+    {
+        hotReloadEnabled = enabled;
+
+        //roots loaded before hot reload was enabled are watched from now on.
+        if (enabled && !fileWatcher)
+        {
+            fileWatcher = MemoryGlobals::GetDefaultAllocator().Alloc<FileWatcher>();
+            for (const auto& it : assetRoots)
+            {
+                fileWatcher->Watch(GetAbsolutePath(it.second));
+            }
+        }
+    }
+
+    AssetReloadStats ResourceAssets::GetReloadStats()
+    {
+        return reloadStats;
+    }
+
     void ResourceAssets::SaveAssetsToDirectory(RID rid, const StringView& directory)
     {
         if (!FileSystem::GetFileStatus(directory).exists)
@@ -231,6 +616,26 @@ namespace Fyrion
             }
         }
 
+        //asset files are written to temp files and renamed in a single transaction at the end.
+        //the in-memory state is only updated after the commit, a failed save is retried by the next one.
+        struct SavedAsset
+        {
+            RID           asset;
+            String        absolutePath;
+            u32           version;
+            Array<String> streamBlobs;
+        };
+
+        FileTransaction transaction{directory};
+        Array<SavedAsset> savedAssets{};
+        Array<RID> deletedAssets{};
+        Array<Pair<StreamObject*, StreamHash>> hashedStreams{};
+        Array<Pair<StreamObject*, String>> movedStreams{};
+        Array<u8> compressedStream{};
+        String storeDirectory = Path::Join(directory, FY_STORE_EXTENSION);
+        HashSet<String> writtenBlobs{};
+        u32 dedupCount = 0;
+
         Array<RID> assets = assetRoot.GetSubObjectSetAsArray(AssetRoot::Assets);
         for (RID asset: assets)
         {
@@ -262,88 +667,159 @@ namespace Fyrion
 
                     String dataPath = Path::Join(parentPath, Path::Name(newAbsolutePath), FY_DATA_EXTENSION);
 
-                    String str = ResourceSerialization::WriteResourceInfo(objectRid);
-                    FileHandler handler = FileSystem::OpenFile(newAbsolutePath, AccessMode::WriteOnly);
-                    FileSystem::WriteFile(handler, str.begin(), str.Size());
-                    FileSystem::CloseFile(handler);
-
-                    logger.Debug("Asset {} saved on {} ", rid.id, newAbsolutePath);
-
+                    //streams go first, the asset file is written with their content hashes.
+                    Array<String> streamBlobs{};
                     ResourceObject object = Repository::ReadNoPrototypes(objectRid);
                     u32 valueCount = object.GetValueCount();
                     for (int i = 0; i < valueCount; ++i)
                     {
+                        if (object.GetResourceType(i) != ResourceFieldType::Stream) continue;
 
-                        if (object.GetResourceType(i) == ResourceFieldType::Stream)
+                        StreamObject* streamObject = object.GetStream(i);
+                        if (!streamObject || streamObject->Size() == 0) continue;
+
+                        StreamHash hash = streamObject->GetContentHash();
+                        if (!hash)
+                        {
+                            hash = streamObject->ComputeContentHash();
+                        }
+
+                        String blobPath = Path::Join(storeDirectory, hash.ToString());
+                        bool mapped = streamObject->MappedTo() == blobPath;
+
+                        //identical contents are stored once.
+                        if (FileSystem::GetFileStatus(blobPath).exists || !writtenBlobs.Insert(blobPath).second)
+                        {
+                            if (!mapped)
+                            {
+                                dedupCount++;
+                            }
+                        }
+                        else
                         {
-                            StreamObject* streamObject = object.GetStream(i);
-                            if (streamObject)
+                            if (!FileSystem::GetFileStatus(storeDirectory).exists)
                             {
-                                char strBuffer[17]{};
-                                usize bufSize = U64ToHex(streamObject->GetBufferId(), strBuffer);
-                                StringView streamName = {strBuffer, bufSize};
-                                String streamPath = Path::Join(dataPath, streamName);
-
-                                if (!FileSystem::GetFileStatus(dataPath).exists)
-                                {
-                                    FileSystem::CreateDirectory(dataPath);
-                                }
-
-                                //if it's still mapped, it's not changed.
-                                StringView path = streamObject->MappedTo();
-                                if (!path.Empty())
-                                {
-                                    if (streamPath != path)
-                                    {
-                                        FileSystem::Rename(path, streamPath);
-                                    }
-                                }
-                                else
-                                {
-                                    String tempPath = Path::Join(FileSystem::TempFolder(), streamName);
-                                    FileSystem::Rename(tempPath, streamPath);
-                                }
-                                streamObject->MapTo(streamPath, 0);
+                                FileSystem::CreateDirectory(storeDirectory);
                             }
+
+                            streamObject->Compress(compressedStream);
+                            if (!transaction.Write(blobPath, compressedStream.Data(), compressedStream.Size()))
+                            {
+                                continue;
+                            }
+                            logger.Debug("Stream {} compressed from {} to {} bytes", hash.ToString(), streamObject->Size(), compressedStream.Size());
+                        }
+
+                        //the raw file is not needed anymore, versions that still map it keep it alive.
+                        if (streamObject->MappedTo().Empty())
+                        {
+                            char strBuffer[17]{};
+                            usize bufSize = U64ToHex(streamObject->GetBufferId(), strBuffer);
+                            transaction.Remove(Path::Join(FileSystem::TempFolder(), StringView{strBuffer, bufSize}));
+                        }
+
+                        //the asset file is written with the hash, a failed commit restores the previous one.
+                        hashedStreams.EmplaceBack(streamObject, streamObject->GetContentHash());
+                        streamObject->SetContentHash(hash);
+                        streamBlobs.EmplaceBack(blobPath);
+
+                        if (!mapped)
+                        {
+                            movedStreams.EmplaceBack(streamObject, blobPath);
                         }
                     }
 
+                    String str = ResourceSerialization::WriteResourceInfo(objectRid);
+                    if (!transaction.Write(newAbsolutePath, str.begin(), str.Size()))
+                    {
+                        continue;
+                    }
+
+                    logger.Debug("Asset {} saved on {} ", rid.id, newAbsolutePath);
+
+                    //streams of older saves are moved to the store.
+                    if (FileSystem::GetFileStatus(dataPath).exists)
+                    {
+                        transaction.Remove(dataPath);
+                    }
+
                     if (newAbsolutePath != info.absolutePath && FileSystem::GetFileStatus(info.absolutePath).exists)
                     {
-                        FileSystem::Remove(info.absolutePath);
+                        transaction.Remove(info.absolutePath);
                         logger.Debug("Asset {} Removed from {} ", rid.id, info.absolutePath);
                     }
 
-                    String oldPath = info.absolutePath;
                     String oldDataPath = Path::Join(Path::Parent(info.absolutePath), Path::Name(info.absolutePath), FY_DATA_EXTENSION);
                     if (oldDataPath != dataPath)
                     {
-                        FileSystem::Remove(oldDataPath);
+                        transaction.Remove(oldDataPath);
                     }
 
-                    info.absolutePath = newAbsolutePath;
+                    savedAssets.EmplaceBack(SavedAsset{asset, newAbsolutePath, version, Traits::Move(streamBlobs)});
+                }
+                else
+                {
+                    info.loadedVersion = version;
                 }
-                info.loadedVersion   = version;
             }
             else if (!Repository::IsActive(asset))
             {
                 if (FileSystem::GetFileStatus(info.absolutePath).exists)
                 {
-                    FileSystem::Remove(info.absolutePath);
+                    transaction.Remove(info.absolutePath);
                     logger.Debug("Asset {} deleted from {} ", rid.id, info.absolutePath);
                 }
 
                 String dataPath = Path::Join(Path::Parent(info.absolutePath), Path::Name(info.absolutePath), FY_DATA_EXTENSION);
                 if (FileSystem::GetFileStatus(dataPath).exists)
                 {
-                    FileSystem::Remove(dataPath);
+                    transaction.Remove(dataPath);
                     logger.Debug("Asset Data Directory {} deleted from {} ", rid.id, dataPath);
                 }
 
-                Repository::DestroyResource(asset);
-                assetFileInfos.Erase(it);
+                deletedAssets.EmplaceBack(asset);
+            }
+        }
+
+        if (!transaction.Commit())
+        {
+            for (const auto& it : hashedStreams)
+            {
+                it.first->SetContentHash(it.second);
             }
+            logger.Error("Failed to save {} to {} ", name, directory);
+            return;
         }
+
+        for (SavedAsset& savedAsset : savedAssets)
+        {
+            AssetFileInfo& info = assetFileInfos.Find(savedAsset.asset)->second;
+            SetStreamReferences(info.streamBlobs, Traits::Move(savedAsset.streamBlobs));
+            info.absolutePath = savedAsset.absolutePath;
+            info.loadedVersion = savedAsset.version;
+            info.lastModifiedTime = FileSystem::GetFileStatus(info.absolutePath).lastModifiedTime;
+        }
+
+        for (RID asset : deletedAssets)
+        {
+            auto it = assetFileInfos.Find(asset);
+            SetStreamReferences(it->second.streamBlobs, {});
+            Repository::DestroyResource(asset);
+            assetFileInfos.Erase(it);
+        }
+
+        //streams can only be mapped to the new files after the transaction is applied.
+        for (const auto& it : movedStreams)
+        {
+            it.first->MapTo(it.second, 0, StreamEncoding::Chunked);
+        }
+
+        if (dedupCount > 0)
+        {
+            logger.Debug("{} streams already on the store", dedupCount);
+        }
+
+        RemoveUnusedStreams(directory);
     }
 
     String ResourceAssets::GetName(RID asset)
@@ -560,10 +1036,86 @@ namespace Fyrion
         Repository::AddResourceTypeEvent(GetTypeID<Asset>(), nullptr, ResourceEventType::Insert | ResourceEventType::Update, AssetChanges);
     }
 
+    void ResourceAssetsUpdate()
+    {
+        if (!fileWatcher || !hotReloadEnabled) return;
+
+        Array<FileWatcherEvent> events{};
+        fileWatcher->Poll(events);
+        if (events.Empty()) return;
+
+        HashMap<String, f64> changedFiles{};
+        for (const FileWatcherEvent& event : events)
+        {
+            //removed files are handled by the asset tree, only existing assets are reloaded.
+            if (event.event != FileNotifyEvent::Removed)
+            {
+                changedFiles.Insert(event.path, event.time);
+            }
+        }
+
+        Array<Pair<RID, f64>> toReload{};
+        for (const auto& it : assetFileInfos)
+        {
+            auto itChanged = changedFiles.Find(it.second.absolutePath);
+            if (itChanged == changedFiles.end()) continue;
+
+            //same time as the last load or save, it's our own change.
+            if (FileSystem::GetFileStatus(it.second.absolutePath).lastModifiedTime == it.second.lastModifiedTime) continue;
+
+            toReload.EmplaceBack(it.first, itChanged->second);
+        }
+
+        //files that are not assets, like included headers, reload only the assets that depend on them.
+        for (const auto& itChanged : changedFiles)
+        {
+            for (RID dependent : ResourceAssets::GetAssetDependents(itChanged.first))
+            {
+                bool found = false;
+                for (const auto& it : toReload)
+                {
+                    if (it.first == dependent)
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    toReload.EmplaceBack(dependent, itChanged.second);
+                }
+            }
+        }
+
+        for (const auto& it : toReload)
+        {
+            if (ResourceAssets::ReloadAsset(it.first))
+            {
+                f64 latency = Platform::GetTime() - it.second;
+                reloadStats.reloadCount++;
+                reloadStats.lastLatency = latency;
+                reloadStats.maxLatency = latency > reloadStats.maxLatency ? latency : reloadStats.maxLatency;
+                reloadStats.averageLatency += (latency - reloadStats.averageLatency) / reloadStats.reloadCount;
+
+                logger.Debug("Asset reload latency {:.3f}s", latency);
+            }
+        }
+    }
+
     void ResourceAssetsShutdown()
     {
+        if (fileWatcher)
+        {
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(fileWatcher);
+            fileWatcher = nullptr;
+        }
+        reloadStats = {};
+
         assetImporters.Clear();
         assetRoots.Clear();
         assetFileInfos.Clear();
+        assetDependencies.Clear();
+        streamReferences.Clear();
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Fyrion/Common.hpp"
 #include "ResourceTypes.hpp"
 #include "Fyrion/Core/String.hpp"
+#include "Fyrion/Core/Array.hpp"
 
 namespace Fyrion::ResourceAssets
 {
@@ -16,4 +17,17 @@ namespace Fyrion::ResourceAssets
 	FY_API u32          GetLoadedVersion(RID rid);
 	FY_API StringView   GetAbsolutePath(RID rid);
     FY_API void         ImportAsset(RID root, RID directory, const StringView& path);
+    FY_API void         SetLoadWorkerCount(u32 workerCount);
+    FY_API AssetLoadStats GetLastLoadStats();
+    FY_API bool         ReloadAsset(RID asset);
+    FY_API void         SetHotReloadEnabled(bool enabled);
+    FY_API AssetReloadStats GetReloadStats();
+
+    //files other than its own that an imported asset was built from, changes on them reload the asset.
+    FY_API void         SetAssetDependencies(RID asset, const Array<String>& files);
+    FY_API Array<RID>   GetAssetDependents(const StringView& file);
+
+    //removes the blobs of the content store that are not referenced by any loaded or saved asset,
+    //nor mapped by a version that is still alive.
+    FY_API u32          RemoveUnusedStreams(const StringView& directory);
 }
@@ -538,7 +538,14 @@ namespace Fyrion::ResourceSerialization
                         if (type == ResourceFieldType::Stream)
                         {
                             StreamObject* stream = object.WriteStream(index);
-                            stream->SetBufferId(HexTo64(StringView{context.value}));
+                            if (StreamHash hash = StreamHash::FromString(context.value))
+                            {
+                                stream->SetContentHash(hash);
+                            }
+                            else
+                            {
+                                stream->SetBufferId(HexTo64(StringView{context.value}));
+                            }
                         }
                         else if (typeInfo.typeId == GetTypeID<RID>())
                         {
@@ -891,7 +898,14 @@ namespace Fyrion::ResourceSerialization
                     context.buffer.Append(name);
                     context.buffer.Append(": ");
                     context.buffer.Append("\"");
-                    context.buffer.Append(StringView{strBuffer, bufSize});
+                    if (streamObject->GetContentHash())
+                    {
+                        context.buffer.Append(streamObject->GetContentHash().ToString());
+                    }
+                    else
+                    {
+                        context.buffer.Append(StringView{strBuffer, bufSize});
+                    }
                     context.buffer.Append("\"");
                     context.buffer.Append("\n");
                 }
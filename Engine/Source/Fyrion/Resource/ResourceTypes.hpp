@@ -119,6 +119,25 @@ namespace Fyrion
         constexpr static u32 Extension = 4;
     };
 
+    struct AssetLoadStats
+    {
+        u32 workerCount{};
+        u32 directoryCount{};
+        u32 assetCount{};
+        f64 enumerateTime{};
+        f64 loadTime{};
+        f64 commitTime{};
+    };
+
+    //latency is measured from the time the file change was noticed until the asset is updated in the repository.
+    struct AssetReloadStats
+    {
+        u32 reloadCount{};
+        f64 lastLatency{};
+        f64 averageLatency{};
+        f64 maxLatency{};
+    };
+
     typedef RID (*FnImportAsset)(RID asset, const StringView& path);
     typedef void(*FnResourceEvent)(VoidPtr userData, ResourceEventType eventType, ResourceObject& oldObject, ResourceObject& newObject);
 }
\ No newline at end of file
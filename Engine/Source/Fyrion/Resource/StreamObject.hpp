@@ -2,24 +2,123 @@
 
 #include <Fyrion/Common.hpp>
 #include "Fyrion/Core/String.hpp"
+#include "Fyrion/Core/Span.hpp"
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/Algorithm.hpp"
+#include "Fyrion/IO/FileTypes.hpp"
 
 namespace Fyrion
 {
-    //TODO: use mmap instead of String.
+    struct StreamMapping;
+    struct StreamWriter;
 
+    //128-bit hash of the stream contents, it's the name of the stream on the content store.
+    struct StreamHash
+    {
+        u64 high{};
+        u64 low{};
+
+        explicit operator bool() const
+        {
+            return high != 0 || low != 0;
+        }
+
+        bool operator==(const StreamHash& other) const
+        {
+            return high == other.high && low == other.low;
+        }
+
+        bool operator!=(const StreamHash& other) const
+        {
+            return !(*this == other);
+        }
+
+        String ToString() const
+        {
+            char buffer[32];
+            for (u32 i = 0; i < 16; ++i)
+            {
+                buffer[i] = "0123456789abcdef"[(high >> (60 - i * 4)) & 0xF];
+                buffer[i + 16] = "0123456789abcdef"[(low >> (60 - i * 4)) & 0xF];
+            }
+            return String{buffer, 32};
+        }
+
+        static StreamHash FromString(const StringView& str)
+        {
+            if (str.Size() != 32)
+            {
+                return {};
+            }
+            return StreamHash{HexTo64(str.Substr(0, 16)), HexTo64(str.Substr(16, 16))};
+        }
+    };
+
+    //how the mapped file is stored, it's defined by where the file comes from and never detected from its contents.
+    //files on the content store are chunked, buffer files written by Set or BeginWrite are raw.
+    enum class StreamEncoding
+    {
+        Raw,
+        Chunked
+    };
+
+    struct StreamCompressionStats
+    {
+        u64 size{};
+        u64 compressedSize{};
+        f64 ratio{};
+        u64 decodedBytes{};
+        f64 decodeGBs{};
+    };
+
+    //the backing file is kept mapped read-only, copies of the stream (each resource version) share the same mapping.
+    //saved streams are compressed in fixed-size chunks, ranged reads only decode the chunks they touch.
     class FY_API StreamObject
     {
     public:
-        void        MapTo(const StringView& file, usize offset);
-        StringView  MappedTo();
-        void        Set(VoidPtr data, usize size);
-        usize       Size();
-        void        Get(VoidPtr data, usize size, usize offset);
-        u64         GetBufferId() const;
-        void        SetBufferId(u64 bufferId);
+        StreamObject() = default;
+        StreamObject(const StreamObject& other);
+        StreamObject& operator=(const StreamObject& other);
+        ~StreamObject();
+
+        void            MapTo(const StringView& file, usize offset, StreamEncoding encoding = StreamEncoding::Raw);
+        StringView      MappedTo() const;
+        void            Set(VoidPtr data, usize size);
+        usize           Size() const;
+        void            Get(VoidPtr data, usize size, usize offset) const;
+        Span<const u8>  Map(usize offset, usize size) const;
+
+        //streaming alternative to Set, appended data is written to disk on a background thread with bounded memory.
+        //the content hash is computed while writing. EndWrite returns false if the data could not be written.
+        void            BeginWrite();
+        void            Append(ConstPtr data, usize size);
+        bool            EndWrite();
+
+        //reads the range through AsyncIO, the callback runs on the IO thread and data must outlive it.
+        IORequest       GetAsync(VoidPtr data, usize size, usize offset, IOPriority priority, VoidPtr userData, FnIOCallback callback) const;
+
+        //builds the chunked compressed file of the stream, a stream that is already compressed is copied as is.
+        void            Compress(Array<u8>& data) const;
+        bool            IsCompressed() const;
+        StreamCompressionStats GetCompressionStats() const;
+
+        //hash of the uncompressed contents, computed in chunks in parallel.
+        StreamHash      ComputeContentHash() const;
+        StreamHash      GetContentHash() const;
+        void            SetContentHash(const StreamHash& hash);
+
+        u64             GetBufferId() const;
+        void            SetBufferId(u64 bufferId);
     private:
-        u64         m_id{};
-        String      m_mapFile{};
+        u64             m_id{};
+        StreamHash      m_hash{};
+        String          m_mapFile{};
+        usize           m_mapOffset{};
+        StreamEncoding  m_encoding{};
+        StreamMapping*  m_mapping{};
+        StreamWriter*   m_writer{};
+
+        void            SetMapping(StreamMapping* mapping);
     };
 
 }
@@ -0,0 +1,78 @@
+#include <doctest.h>
+#include "Fyrion/Core/Compression.hpp"
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/Random.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    bool RoundTrip(const Array<u8>& data, usize& compressedSize)
+    {
+        Array<u8> compressed(Compression::CompressBound(data.Size()));
+        compressedSize = Compression::Compress(data.Data(), data.Size(), compressed.Data(), compressed.Size());
+        if (compressedSize == 0) return false;
+
+        Array<u8> decompressed(data.Size());
+        usize size = Compression::Decompress(compressed.Data(), compressedSize, decompressed.Data(), decompressed.Size());
+        return size == data.Size() && decompressed == data;
+    }
+
+    TEST_CASE("Core::Compression")
+    {
+        usize compressedSize = 0;
+
+        //repetitive
+        {
+            Array<u8> data(100000);
+            for (usize i = 0; i < data.Size(); ++i)
+            {
+                data[i] = static_cast<u8>((i % 100) < 50 ? i % 7 : 'a');
+            }
+            CHECK(RoundTrip(data, compressedSize));
+            CHECK(compressedSize < data.Size() / 10);
+        }
+
+        //long run, overlapping matches
+        {
+            Array<u8> data(5000, 42);
+            CHECK(RoundTrip(data, compressedSize));
+            CHECK(compressedSize < 50);
+        }
+
+        //incompressible, stays within the bound
+        {
+            Array<u8> data(70000);
+            for (u8& value : data)
+            {
+                value = static_cast<u8>(Random::Xorshift64star());
+            }
+            CHECK(RoundTrip(data, compressedSize));
+            CHECK(compressedSize <= Compression::CompressBound(data.Size()));
+        }
+
+        //smaller than the match limit
+        {
+            Array<u8> data{1, 2, 3, 4, 1, 2, 3, 4};
+            CHECK(RoundTrip(data, compressedSize));
+        }
+
+        //dst too small
+        {
+            Array<u8> data(1000);
+            for (u8& value : data)
+            {
+                value = static_cast<u8>(Random::Xorshift64star());
+            }
+            u8 dst[100];
+            CHECK(Compression::Compress(data.Data(), data.Size(), dst, sizeof(dst)) == 0);
+        }
+
+        //malformed
+        {
+            u8 src[] = {0x1F, 'a', 0xFF, 0xFF};
+            u8 dst[64];
+            CHECK(Compression::Decompress(src, sizeof(src), dst, sizeof(dst)) == 0);
+        }
+    }
+}
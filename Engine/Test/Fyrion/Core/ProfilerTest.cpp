@@ -0,0 +1,134 @@
+#include <doctest.h>
+#include <cstring>
+
+#include "Fyrion/HeadlessEngine.hpp"
+#include "Fyrion/Core/Event.hpp"
+#include "Fyrion/Core/Profiler.hpp"
+#include "Fyrion/Graphics/Graphics.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    constexpr u64 FrameCount = 8;
+
+    u64 updateCount = 0;
+    u64 gpuTimingsFrame = 0;
+
+    void OnUpdateTest(f64 deltaTime)
+    {
+        FY_PROFILE_SCOPE("Game");
+
+        updateCount++;
+        if (updateCount == FrameCount)
+        {
+            Engine::Shutdown();
+        }
+    }
+
+    void OnRecordTest(RenderCommands& renderCommands, f64 deltaTime)
+    {
+        gpuTimingsFrame = Graphics::GetGPUFrameTimings().frame;
+
+        renderCommands.BeginLabel("Shadows", Vec4{});
+        renderCommands.BeginLabel("Cascade", Vec4{});
+        renderCommands.EndLabel();
+        renderCommands.EndLabel();
+    }
+
+    TEST_CASE("Core::ProfilerScopes")
+    {
+        Profiler::Reset();
+
+        Profiler::BeginFrame(10);
+        {
+            FY_PROFILE_SCOPE("Outer");
+            FY_PROFILE_SCOPE("Inner");
+        }
+        Profiler::BeginScope("Open");
+        Profiler::EndFrame();
+
+        //scopes outside of a frame are ignored.
+        Profiler::BeginScope("Ignored");
+        Profiler::EndScope();
+
+        REQUIRE(Profiler::GetFrameCount() == 1);
+
+        const ProfileFrame& frame = Profiler::GetFrame(0);
+        CHECK(frame.frame == 10);
+        CHECK(!frame.gpuResolved);
+        REQUIRE(frame.cpuScopes.Size() == 3);
+        CHECK(frame.cpuScopes[0].name == "Outer");
+        CHECK(frame.cpuScopes[0].depth == 0);
+        CHECK(frame.cpuScopes[1].name == "Inner");
+        CHECK(frame.cpuScopes[1].depth == 1);
+        CHECK(frame.cpuScopes[0].end >= frame.cpuScopes[1].end);
+        CHECK(frame.cpuScopes[2].end >= frame.cpuScopes[2].begin);
+
+        ProfileScope gpuScopes[2] = {
+            {.name = "Pass", .depth = 0, .begin = 0.0, .end = 0.002},
+            {.name = "Draw", .depth = 1, .begin = 0.0005, .end = 0.001},
+        };
+        Profiler::SetGPUScopes(10, {gpuScopes, 2});
+        Profiler::SetGPUScopes(11, {gpuScopes, 2});
+
+        REQUIRE(Profiler::FindFrame(10));
+        CHECK(Profiler::FindFrame(10)->gpuResolved);
+        CHECK(Profiler::FindFrame(10)->gpuTime == doctest::Approx(0.002));
+        CHECK(!Profiler::FindFrame(11));
+
+        String trace = Profiler::ExportChromeTrace();
+        CHECK(trace.Find('{') == 0);
+        CHECK(strstr(trace.CStr(), "\"traceEvents\""));
+        CHECK(strstr(trace.CStr(), "\"name\":\"Inner\""));
+        CHECK(strstr(trace.CStr(), "\"name\":\"Draw\",\"ph\":\"X\",\"pid\":0,\"tid\":1"));
+
+        Profiler::Reset();
+        CHECK(Profiler::GetFrameCount() == 0);
+    }
+
+    TEST_CASE("Core::ProfilerEngineFrames")
+    {
+        updateCount = 0;
+        gpuTimingsFrame = 0;
+
+        HeadlessEngine engine{};
+
+        Event::Bind<OnUpdate, &OnUpdateTest>();
+        Event::Bind<OnRecordRenderCommands, &OnRecordTest>();
+
+        Engine::Run();
+
+        Event::Unbind<OnUpdate, &OnUpdateTest>();
+        Event::Unbind<OnRecordRenderCommands, &OnRecordTest>();
+
+        REQUIRE(Profiler::GetFrameCount() == FrameCount);
+
+        const ProfileFrame& first = Profiler::GetFrame(0);
+        CHECK(first.frame == 0);
+        REQUIRE(first.cpuScopes.Size() == 6);
+        CHECK(first.cpuScopes[0].name == "Wait");
+        CHECK(first.cpuScopes[1].name == "Update");
+        CHECK(first.cpuScopes[2].name == "Game");
+        CHECK(first.cpuScopes[2].depth == 1);
+        CHECK(first.cpuScopes[3].name == "Record");
+        CHECK(first.cpuScopes[5].name == "EndFrame");
+
+        //gpu timings are resolved when the device reuses the frame slot.
+        CHECK(first.gpuResolved);
+        REQUIRE(first.gpuScopes.Size() == 4);
+        CHECK(first.gpuScopes[0].name == "Frame");
+        CHECK(first.gpuScopes[0].begin == 0.0);
+        CHECK(first.gpuScopes[1].name == "Shadows");
+        CHECK(first.gpuScopes[1].depth == 1);
+        CHECK(first.gpuScopes[2].name == "Cascade");
+        CHECK(first.gpuScopes[2].depth == 2);
+        CHECK(first.gpuScopes[3].name == "Swapchain");
+
+        CHECK(!Profiler::GetFrame(FrameCount - 1).gpuResolved);
+
+        CHECK(gpuTimingsFrame == FrameCount - FY_DEFAULT_FRAMES_IN_FLIGHT - 1);
+
+        CHECK(strstr(Profiler::ExportChromeTrace().CStr(), "\"name\":\"Cascade\""));
+    }
+}
@@ -0,0 +1,139 @@
+#include <doctest.h>
+
+#include "Fyrion/Graphics/CommandStream.hpp"
+#include "Fyrion/Graphics/Device/BindlessIndexAllocator.hpp"
+#include "Fyrion/Graphics/Device/Null/NullDevice.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Graphics::Bindless::IndexAllocator")
+    {
+        BindlessIndexAllocator allocator{4};
+        CHECK(allocator.GetCapacity() == 4);
+
+        u32 indices[4];
+        for (u32 i = 0; i < 4; ++i)
+        {
+            indices[i] = allocator.Allocate();
+            CHECK(indices[i] == i);
+        }
+        CHECK(allocator.GetCount() == 4);
+        CHECK(allocator.Allocate() == U32_MAX);
+
+        allocator.Free(U32_MAX);
+        CHECK(allocator.GetCount() == 4);
+
+        //freed indices are pending until the frames in flight are done with them.
+        allocator.Free(indices[1]);
+        CHECK(allocator.GetCount() == 3);
+        CHECK(allocator.Allocate() == U32_MAX);
+
+        for (u32 i = 0; i < FY_FRAMES_IN_FLIGHT - 1; ++i)
+        {
+            allocator.NextFrame();
+            CHECK(allocator.Allocate() == U32_MAX);
+        }
+
+        allocator.NextFrame();
+        CHECK(allocator.Allocate() == indices[1]);
+        CHECK(allocator.GetCount() == 4);
+
+        allocator.SetCapacity(5);
+        CHECK(allocator.Allocate() == 4);
+        CHECK(allocator.GetCount() == 5);
+    }
+
+    TEST_CASE("Graphics::Bindless::Indices")
+    {
+        NullDevice device{};
+        CHECK(device.GetFeatures().bindlessSupported);
+
+        Texture texture = device.CreateTexture(TextureCreation{
+            .extent = {64, 64, 1},
+            .usage = TextureUsage::ShaderResource | TextureUsage::TransferDst
+        });
+
+        Texture renderTarget = device.CreateTexture(TextureCreation{
+            .extent = {64, 64, 1},
+            .usage = TextureUsage::RenderPass
+        });
+
+        TextureView mipView = device.CreateTextureView(TextureViewCreation{
+            .texture = texture,
+            .baseMipLevel = 0
+        });
+
+        Sampler sampler = device.CreateSampler(SamplerCreation{});
+        Buffer  storageBuffer = device.CreateBuffer(BufferCreation{.usage = BufferUsage::StorageBuffer, .size = 16});
+        Buffer  uniformBuffer = device.CreateBuffer(BufferCreation{.usage = BufferUsage::UniformBuffer, .size = 16});
+
+        u32 textureIndex = device.GetBindlessIndex(texture);
+        CHECK(textureIndex != U32_MAX);
+        CHECK(textureIndex == device.GetBindlessIndex(device.textures.Get(texture.handler)->textureView));
+        CHECK(device.GetBindlessIndex(mipView) != U32_MAX);
+        CHECK(device.GetBindlessIndex(mipView) != textureIndex);
+        CHECK(device.GetBindlessIndex(renderTarget) == U32_MAX);
+        CHECK(device.GetBindlessIndex(sampler) != U32_MAX);
+        CHECK(device.GetBindlessIndex(storageBuffer) != U32_MAX);
+        CHECK(device.GetBindlessIndex(uniformBuffer) == U32_MAX);
+        CHECK(device.textureIndices.GetCount() == 2);
+
+        //frames in flight can still read the descriptor, the index is not reused right away.
+        device.DestroyTextureView(mipView);
+        CHECK(device.textureIndices.GetCount() == 1);
+
+        Texture other = device.CreateTexture(TextureCreation{.extent = {64, 64, 1}});
+        u32 otherIndex = device.GetBindlessIndex(other);
+        CHECK(otherIndex != U32_MAX);
+
+        for (u32 i = 0; i < FY_FRAMES_IN_FLIGHT - 1; ++i)
+        {
+            device.BeginFrame();
+            TextureView view = device.CreateTextureView(TextureViewCreation{.texture = texture});
+            CHECK(device.GetBindlessIndex(view) > otherIndex);
+            device.DestroyTextureView(view);
+        }
+
+        device.BeginFrame();
+        TextureView reused = device.CreateTextureView(TextureViewCreation{.texture = texture});
+        CHECK(device.GetBindlessIndex(reused) < otherIndex);
+
+        device.DestroyTextureView(reused);
+        device.DestroyTexture(other);
+        device.DestroyTexture(renderTarget);
+        device.DestroyTexture(texture);
+        device.DestroySampler(sampler);
+        device.DestroyBuffer(storageBuffer);
+        device.DestroyBuffer(uniformBuffer);
+
+        CHECK(device.textureIndices.GetCount() == 0);
+        CHECK(device.samplerIndices.GetCount() == 0);
+        CHECK(device.bufferIndices.GetCount() == 0);
+    }
+
+    TEST_CASE("Graphics::Bindless::BindHeap")
+    {
+        u8 pipelineHandler{};
+        PipelineState pipeline{&pipelineHandler};
+
+        CommandStream stream{};
+        stream.Begin();
+        stream.BindPipelineState(pipeline);
+        stream.BindBindlessHeap(pipeline);
+        stream.End();
+
+        NullCommands nullCommands{Logger::GetLogger("Fyrion::BindlessTest")};
+        nullCommands.Begin();
+        CommandStream* streamPtr = &stream;
+        CommandStream::Execute({&streamPtr, 1}, nullCommands);
+        nullCommands.BindBindlessHeap({});
+        nullCommands.End();
+
+        REQUIRE(nullCommands.commands.Size() == 3);
+        CHECK(nullCommands.commands[1].type == NullCommandType::BindBindlessHeap);
+        CHECK(nullCommands.commands[1].handler == &pipelineHandler);
+        CHECK(nullCommands.errors == 1);
+    }
+}
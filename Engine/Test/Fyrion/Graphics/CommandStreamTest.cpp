@@ -0,0 +1,91 @@
+#include <doctest.h>
+
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/Graphics/CommandStream.hpp"
+#include "Fyrion/Graphics/Device/Null/NullDevice.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Graphics::CommandStream::Execute")
+    {
+        constexpr u32 streamCount = 8;
+        constexpr u32 drawsPerStream = 1000;
+
+        u8 pipelineHandler{};
+        u8 renderPassHandler{};
+
+        PipelineState pipeline{&pipelineHandler};
+        RenderPass    renderPass{&renderPassHandler};
+        Vec4          clearColor{0, 0, 0, 1};
+
+        Array<CommandStream> streams(streamCount + 1);
+
+        Parallel::For(streamCount, streamCount, [&](usize index)
+        {
+            CommandStream& stream = streams[index];
+            stream.Begin();
+
+            //recorded backwards, sorting puts them back in order.
+            stream.SetSortKey(streamCount - index);
+            stream.BindPipelineState(pipeline);
+            for (u32 i = 0; i < drawsPerStream; ++i)
+            {
+                u32 value = static_cast<u32>(index) * drawsPerStream + i;
+                stream.PushConstants(pipeline, ShaderStage::All, &value, sizeof(u32));
+                stream.Draw(3, 1, value, 0);
+            }
+            stream.End();
+        });
+
+        CommandStream& passStream = streams[streamCount];
+        passStream.Begin();
+        passStream.BeginLabel("Pass", Vec4{1, 0, 0, 1});
+        passStream.BeginRenderPass(BeginRenderPassInfo{
+            .renderPass = renderPass,
+            .clearValues = {&clearColor, 1}
+        });
+        passStream.SetSortKey(U64_MAX);
+        passStream.EndRenderPass();
+        passStream.EndLabel();
+        passStream.End();
+
+        CHECK(passStream.GetPacketCount() == 4);
+        CHECK(streams[0].GetPacketCount() == 1 + drawsPerStream * 2);
+        CHECK(streams[0].GetMemoryUsage() >= CommandStream::ChunkSize);
+
+        Array<CommandStream*> streamPtrs{};
+        for (CommandStream& stream : streams)
+        {
+            streamPtrs.EmplaceBack(&stream);
+        }
+
+        CHECK(CommandStream::Validate(streamPtrs) == 0);
+
+        NullCommands nullCommands{Logger::GetLogger("Fyrion::CommandStreamTest")};
+        nullCommands.Begin();
+        CommandStream::Execute(streamPtrs, nullCommands);
+        nullCommands.End();
+
+        CHECK(nullCommands.errors == 0);
+        REQUIRE(nullCommands.commands.Size() == 4 + streamCount * (1 + drawsPerStream * 2));
+        CHECK(nullCommands.commands[0].type == NullCommandType::BeginLabel);
+        CHECK(nullCommands.commands[1].type == NullCommandType::BeginRenderPass);
+        CHECK(nullCommands.commands.Back().type == NullCommandType::EndLabel);
+
+        //last recorded stream has the lowest key
+        CHECK(nullCommands.commands[2].type == NullCommandType::BindPipelineState);
+        CHECK(nullCommands.commands[4].type == NullCommandType::Draw);
+        CHECK(nullCommands.commands[4].values[2] == (streamCount - 1) * drawsPerStream);
+        CHECK(nullCommands.commands[6].values[2] == (streamCount - 1) * drawsPerStream + 1);
+
+        //streams are reusable
+        passStream.Begin();
+        CHECK(passStream.IsEmpty());
+        passStream.Draw(3, 1, 0, 0);
+
+        CommandStream* invalidStream = &passStream;
+        CHECK(CommandStream::Validate({&invalidStream, 1}) == 2);
+    }
+}
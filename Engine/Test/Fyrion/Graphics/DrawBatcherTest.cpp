@@ -0,0 +1,207 @@
+#include <doctest.h>
+
+#include "Fyrion/HeadlessEngine.hpp"
+#include "Fyrion/Graphics/DrawBatcher.hpp"
+#include "Fyrion/Graphics/Device/Null/NullDevice.hpp"
+
+using namespace Fyrion;
+
+namespace Fyrion
+{
+    FY_API RenderDevice& GetRenderDevice();
+}
+
+namespace
+{
+    NullBuffer* GetNullBuffer(const Buffer& buffer)
+    {
+        return static_cast<NullDevice&>(GetRenderDevice()).buffers.Get(buffer.handler);
+    }
+
+    TEST_CASE("Graphics::DrawBatcher::MultiDraw")
+    {
+        HeadlessEngine engine{};
+
+        {
+            constexpr u32 drawCount = 100;
+
+            DrawBatcher batcher{DrawBatcherCreation{
+                .vertexStride = sizeof(Vec3),
+                .maxVertices = 1024,
+                .maxIndices = 1024,
+                .maxDraws = drawCount
+            }};
+
+            Vec3 triangle[3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+            u32  triangleIndices[3] = {0, 1, 2};
+
+            Vec3 quad[4] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+            u32  quadIndices[6] = {0, 1, 2, 2, 3, 0};
+
+            GeometryRender triangleGeometry = batcher.AddGeometry({reinterpret_cast<u8*>(triangle), sizeof(triangle)}, {triangleIndices, 3});
+            GeometryRender quadGeometry = batcher.AddGeometry({reinterpret_cast<u8*>(quad), sizeof(quad)}, {quadIndices, 6});
+
+            CHECK(triangleGeometry.vertexBuffer == quadGeometry.vertexBuffer);
+            CHECK(quadGeometry.firstIndex == 3);
+            CHECK(quadGeometry.indexCount == 6);
+            CHECK(quadGeometry.vertexOffset == 3);
+
+            Vec3 tooLarge[2048]{};
+            CHECK(!batcher.AddGeometry({reinterpret_cast<u8*>(tooLarge), sizeof(tooLarge)}, {quadIndices, 6}).vertexBuffer);
+
+            u8            pipelineHandlers[2]{};
+            PipelineState pipelines[2] = {{&pipelineHandlers[0]}, {&pipelineHandlers[1]}};
+
+            for (u32 i = 0; i < drawCount; ++i)
+            {
+                batcher.Draw(pipelines[i % 2], i % 2 == 0 ? triangleGeometry : quadGeometry, i);
+            }
+            batcher.Build();
+
+            const DrawBatcherStats& stats = batcher.GetStats();
+            CHECK(stats.geometries == 2);
+            CHECK(stats.draws == drawCount);
+            CHECK(stats.batches == 2);
+            CHECK(stats.drawCalls == 2);
+
+            //arguments are grouped by pipeline, keeping the draw order.
+            NullBuffer* indirectBuffer = GetNullBuffer(batcher.GetIndirectBuffer());
+            const DrawIndexedIndirectArguments* arguments = reinterpret_cast<const DrawIndexedIndirectArguments*>(indirectBuffer->data.Data());
+            CHECK(arguments[0].firstInstance == 0);
+            CHECK(arguments[0].indexCount == 3);
+            CHECK(arguments[1].firstInstance == 2);
+            CHECK(arguments[drawCount / 2].firstInstance == 1);
+            CHECK(arguments[drawCount / 2].firstIndex == 3);
+            CHECK(arguments[drawCount / 2].vertexOffset == 3);
+            CHECK(arguments[drawCount - 1].firstInstance == drawCount - 1);
+
+            u8         renderPassHandler{};
+            RenderPass renderPass{&renderPassHandler};
+            Vec4       clearColor{0, 0, 0, 1};
+
+            NullCommands nullCommands{Logger::GetLogger("Fyrion::DrawBatcherTest")};
+            nullCommands.Begin();
+            nullCommands.BeginRenderPass(BeginRenderPassInfo{.renderPass = renderPass, .clearValues = {&clearColor, 1}});
+            batcher.Record(nullCommands);
+            nullCommands.EndRenderPass();
+            nullCommands.End();
+
+            CHECK(nullCommands.errors == 0);
+
+            Array<NullCommand> indirectDraws{};
+            for (const NullCommand& command : nullCommands.commands)
+            {
+                if (command.type == NullCommandType::DrawIndexedIndirect)
+                {
+                    indirectDraws.EmplaceBack(command);
+                }
+            }
+
+            REQUIRE(indirectDraws.Size() == 2);
+            CHECK(indirectDraws[0].values[0] == 0);
+            CHECK(indirectDraws[0].values[1] == drawCount / 2);
+            CHECK(indirectDraws[1].values[0] == drawCount / 2 * sizeof(DrawIndexedIndirectArguments));
+            CHECK(indirectDraws[1].values[1] == drawCount / 2);
+
+            batcher.Reset();
+            batcher.Build();
+            CHECK(batcher.GetStats().draws == 0);
+        }
+    }
+
+    TEST_CASE("Graphics::DrawBatcher::GPUCulling")
+    {
+        HeadlessEngine engine{};
+
+        {
+            constexpr u32 drawCount = 100;
+
+            DrawBatcher batcher{DrawBatcherCreation{
+                .vertexStride = sizeof(Vec3),
+                .maxVertices = 1024,
+                .maxIndices = 1024,
+                .maxDraws = drawCount,
+                .gpuCulling = true
+            }};
+
+            Vec3 triangle[3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+            u32  triangleIndices[3] = {0, 1, 2};
+            GeometryRender geometry = batcher.AddGeometry({reinterpret_cast<u8*>(triangle), sizeof(triangle)}, {triangleIndices, 3});
+
+            u8            pipelineHandlers[2]{};
+            PipelineState pipelines[2] = {{&pipelineHandlers[0]}, {&pipelineHandlers[1]}};
+
+            for (u32 i = 0; i < drawCount - 1; ++i)
+            {
+                Vec3 position{static_cast<f32>(i), 0, 0};
+                batcher.Draw(pipelines[i % 2], geometry, i, AABB{position - 0.5f, position + 0.5f});
+            }
+            batcher.Draw(pipelines[1], geometry, drawCount - 1);
+            batcher.Build();
+
+            //the arguments are written by the culling pass, only the draw data is uploaded.
+            NullBuffer* cullBuffer = GetNullBuffer(batcher.GetCullBuffer());
+            const DrawCullData* cullData = reinterpret_cast<const DrawCullData*>(cullBuffer->data.Data());
+            CHECK(cullData[0].cull == 1);
+            CHECK(cullData[0].outputIndex == 0);
+            CHECK(cullData[1].batchIndex == 1);
+            CHECK(cullData[1].outputIndex == drawCount / 2);
+            CHECK(cullData[3].arguments.firstInstance == 3);
+            CHECK(cullData[3].center.x == doctest::Approx(3.0f));
+            CHECK(cullData[3].extents.y == doctest::Approx(0.5f));
+            CHECK(cullData[drawCount - 1].cull == 0);
+
+            NullCommands nullCommands{Logger::GetLogger("Fyrion::DrawBatcherTest")};
+            nullCommands.Begin();
+
+            batcher.Cull(nullCommands, Math::Perspective(Math::Radians(60.f), 1.0f, 0.1f, 100.0f));
+
+            u8         renderPassHandler{};
+            RenderPass renderPass{&renderPassHandler};
+            Vec4       clearColor{0, 0, 0, 1};
+
+            nullCommands.BeginRenderPass(BeginRenderPassInfo{.renderPass = renderPass, .clearValues = {&clearColor, 1}});
+            batcher.Record(nullCommands);
+            nullCommands.EndRenderPass();
+            nullCommands.End();
+
+            CHECK(nullCommands.errors == 0);
+
+            Array<NullCommand> dispatches{};
+            Array<NullCommand> countDraws{};
+            Array<NullCommand> barriers{};
+            u32                fills{};
+            for (const NullCommand& command : nullCommands.commands)
+            {
+                switch (command.type)
+                {
+                    case NullCommandType::Dispatch: dispatches.EmplaceBack(command); break;
+                    case NullCommandType::DrawIndexedIndirectCount: countDraws.EmplaceBack(command); break;
+                    case NullCommandType::BufferBarrier: barriers.EmplaceBack(command); break;
+                    case NullCommandType::FillBuffer: fills++; break;
+                    default: break;
+                }
+            }
+
+            CHECK(fills == 1);
+            REQUIRE(barriers.Size() == 3);
+
+            //the cleared counters are read and incremented by the culling pass.
+            CHECK(barriers[0].values[0] == static_cast<u32>(BufferAccess::TransferWrite));
+            CHECK(barriers[0].values[1] == static_cast<u32>(BufferAccess::ShaderReadWrite));
+
+            REQUIRE(dispatches.Size() == 1);
+            CHECK(dispatches[0].values[0] == 2);
+
+            REQUIRE(countDraws.Size() == 2);
+            CHECK(countDraws[0].handler == batcher.GetIndirectBuffer().handler);
+            CHECK(countDraws[0].values[0] == 0);
+            CHECK(countDraws[0].values[1] == 0);
+            CHECK(countDraws[0].values[2] == drawCount / 2);
+            CHECK(countDraws[1].values[0] == drawCount / 2 * sizeof(DrawIndexedIndirectArguments));
+            CHECK(countDraws[1].values[1] == sizeof(u32));
+            CHECK(countDraws[1].values[3] == sizeof(DrawIndexedIndirectArguments));
+            CHECK(batcher.GetStats().drawCalls == 2);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include <doctest.h>
+
+#include "Fyrion/Graphics/FramePacer.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Graphics::FramePacer::Disabled")
+    {
+        FramePacer framePacer{};
+        framePacer.SetGPUTime(0.010);
+        framePacer.BeginFrame(0, 1.0, 0);
+        framePacer.EndFrame(0, 1.002);
+
+        CHECK(framePacer.GetDelay(1.002) == 0.0);
+        CHECK(framePacer.GetStats().cpuTime == doctest::Approx(0.002));
+        CHECK(framePacer.GetStats().gpuTime == doctest::Approx(0.010));
+    }
+
+    TEST_CASE("Graphics::FramePacer::LowLatency")
+    {
+        FramePacer framePacer{};
+        framePacer.SetLowLatency(true);
+        framePacer.SetGPUTime(0.010);
+
+        //gpu bound, 2ms of cpu work for 10ms of gpu work.
+        framePacer.BeginFrame(0, 1.000, 0);
+        framePacer.EndFrame(0, 1.002);
+
+        //the gpu is predicted busy until 1.012, the next frame starts as late as its cpu time allows.
+        f64 delay = framePacer.GetDelay(1.002);
+        CHECK(delay > 0.0);
+        CHECK(delay < 0.010);
+        CHECK(1.002 + delay + framePacer.GetStats().cpuTime <= doctest::Approx(1.012));
+
+        framePacer.BeginFrame(1, 1.002 + delay, delay);
+        CHECK(framePacer.GetStats().delay == doctest::Approx(delay));
+
+        //frame 0 finished earlier than predicted, the prediction of the queued frames is moved back.
+        framePacer.FrameCompleted(0, 1.008);
+        CHECK(framePacer.GetStats().inputLatency == doctest::Approx(0.008));
+        CHECK(framePacer.GetStats().maxInputLatency == doctest::Approx(0.008));
+
+        framePacer.EndFrame(1, 1.002 + delay + 0.002);
+        framePacer.FrameCompleted(1, 1.020);
+        CHECK(framePacer.GetStats().averageInputLatency == doctest::Approx((0.008 + 1.020 - 1.002 - delay) / 2.0));
+
+        //completion of an unknown frame is ignored.
+        framePacer.FrameCompleted(1, 1.030);
+        CHECK(framePacer.GetStats().inputLatency == doctest::Approx(1.020 - 1.002 - delay));
+
+        //never delays more than a gpu frame.
+        CHECK(framePacer.GetDelay(0.0) <= framePacer.GetStats().gpuTime);
+
+        framePacer.Reset();
+        CHECK(framePacer.GetStats().frames == 0);
+        CHECK(framePacer.GetDelay(1.0) == 0.0);
+    }
+}
@@ -0,0 +1,255 @@
+#include <doctest.h>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Core/Event.hpp"
+#include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/Graphics/Device/Null/NullDevice.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    constexpr u64 FrameCount = 10;
+
+    u64    updateCount = 0;
+    u64    recordCount = 0;
+    Buffer buffer = {};
+
+    void OnUpdateTest(f64 deltaTime)
+    {
+        updateCount++;
+        if (updateCount == FrameCount)
+        {
+            Engine::Shutdown();
+        }
+    }
+
+    void OnRecordTest(RenderCommands& renderCommands, f64 deltaTime)
+    {
+        u32 value = static_cast<u32>(recordCount);
+        Graphics::UpdateBufferData(BufferDataInfo{
+            .buffer = buffer,
+            .data = &value,
+            .size = sizeof(u32),
+            .offset = (recordCount % 4) * sizeof(u32)
+        });
+        recordCount++;
+    }
+
+    TEST_CASE("Graphics::NullDevice::Headless")
+    {
+        Engine::Init();
+        {
+            Engine::CreateContext(EngineContextCreation{
+                .resolution = {800, 600},
+                .headless = true
+            });
+            CHECK(Engine::IsHeadless());
+
+            buffer = Graphics::CreateBuffer(BufferCreation{
+                .usage = BufferUsage::UniformBuffer,
+                .size = 4 * sizeof(u32),
+                .allocation = BufferAllocation::GPUOnly
+            });
+
+            Event::Bind<OnUpdate, &OnUpdateTest>();
+            Event::Bind<OnRecordRenderCommands, &OnRecordTest>();
+
+            Engine::Run();
+
+            Event::Unbind<OnUpdate, &OnUpdateTest>();
+            Event::Unbind<OnRecordRenderCommands, &OnRecordTest>();
+
+            CHECK(updateCount == FrameCount);
+            CHECK(recordCount == FrameCount);
+
+            FrameStats frameStats = Engine::GetFrameStats();
+            CHECK(frameStats.frames == FrameCount);
+            CHECK(frameStats.maxFrameTime >= frameStats.averageFrameTime);
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Graphics::NullDevice::Validation")
+    {
+        NullDevice device{};
+
+        Buffer src = device.CreateBuffer(BufferCreation{.size = 16});
+        Buffer dst = device.CreateBuffer(BufferCreation{.size = 16});
+
+        u32 values[4] = {1, 2, 3, 4};
+        device.UpdateBufferData(BufferDataInfo{
+            .buffer = src,
+            .data = values,
+            .size = sizeof(values)
+        });
+
+        RenderCommands& cmd = device.BeginFrame();
+        cmd.Begin();
+
+        BufferCopyInfo copyInfo{.srcOffset = 4, .dstOffset = 0, .size = 8};
+        cmd.CopyBuffer(src, dst, {&copyInfo, 1});
+
+        cmd.BeginRenderPass(BeginRenderPassInfo{.renderPass = device.AcquireNextRenderPass(device.CreateSwapchain({}))});
+        cmd.Draw(3, 1, 0, 0);
+        cmd.EndRenderPass();
+        cmd.End();
+        device.EndFrame({});
+
+        CHECK(device.commands.commands.Size() == 4);
+        CHECK(device.commands.commands[2].type == NullCommandType::Draw);
+        CHECK(device.commands.commands[2].values[0] == 3);
+
+        //draw without a bound pipeline
+        CHECK(device.commands.errors == 1);
+
+        NullBuffer* nullBuffer = device.buffers.Get(dst.handler);
+        CHECK(reinterpret_cast<u32*>(nullBuffer->data.Data())[0] == 2);
+        CHECK(reinterpret_cast<u32*>(nullBuffer->data.Data())[1] == 3);
+
+        UploadStats uploadStats = device.GetUploadStats();
+        CHECK(uploadStats.uploads == 1);
+        CHECK(uploadStats.bytesUploaded == sizeof(values));
+
+        device.DestroyBuffer(src);
+        device.DestroyBuffer(dst);
+    }
+
+    TEST_CASE("Graphics::NullDevice::FramesInFlight")
+    {
+        NullDevice device{};
+        CHECK(device.GetFramesInFlight() == FY_DEFAULT_FRAMES_IN_FLIGHT);
+
+        device.SetFramesInFlight(0);
+        CHECK(device.GetFramesInFlight() == 1);
+        device.SetFramesInFlight(FY_FRAMES_IN_FLIGHT + 1);
+        CHECK(device.GetFramesInFlight() == FY_FRAMES_IN_FLIGHT);
+
+        Swapchain swapchain = device.CreateSwapchain(SwapchainCreation{.presentMode = PresentMode::Mailbox});
+        CHECK(device.GetPresentMode(swapchain) == PresentMode::Mailbox);
+        device.SetPresentMode(swapchain, PresentMode::Immediate);
+        CHECK(device.GetPresentMode(swapchain) == PresentMode::Immediate);
+
+        //with one frame in flight the timings of a frame are available when the next one begins.
+        device.SetFramesInFlight(1);
+        for (u32 i = 0; i < 3; ++i)
+        {
+            device.WaitFrame();
+            RenderCommands& cmd = device.BeginFrame();
+            if (i > 0)
+            {
+                CHECK(device.GetGPUFrameTimings().frame == i - 1);
+            }
+            cmd.Begin();
+            cmd.BeginLabel("Frame", Vec4{});
+            cmd.EndLabel();
+            cmd.End();
+            device.EndFrame(swapchain);
+        }
+    }
+
+    TEST_CASE("Graphics::NullDevice::DeferredDestroy")
+    {
+        NullDevice device{};
+        device.SetFramesInFlight(2);
+
+        Swapchain swapchain = device.CreateSwapchain({});
+
+        auto frame = [&]
+        {
+            RenderCommands& cmd = device.BeginFrame();
+            cmd.Begin();
+            cmd.End();
+            device.EndFrame(swapchain);
+        };
+
+        frame();
+
+        Buffer buffer = device.CreateBuffer(BufferCreation{.usage = BufferUsage::UniformBuffer, .size = 16});
+        Texture texture = device.CreateTexture(TextureCreation{.extent = {16, 16, 1}});
+        CHECK(device.GetResourceStats().buffers.live == 1);
+        CHECK(device.GetResourceStats().textureViews.live == 1);
+
+        device.DestroyBuffer(buffer);
+        device.DestroyTexture(texture);
+
+        ResourceStats stats = device.GetResourceStats();
+        CHECK(stats.buffers.live == 0);
+        CHECK(stats.buffers.pendingDestroy == 1);
+        CHECK(stats.textures.pendingDestroy == 1);
+        CHECK(stats.textureViews.pendingDestroy == 1);
+
+        //released on frame 1, destroyed when frame 3 reuses its slot.
+        frame();
+        frame();
+        CHECK(device.GetResourceStats().buffers.pendingDestroy == 1);
+        frame();
+        CHECK(device.GetResourceStats().buffers.pendingDestroy == 0);
+        CHECK(device.GetResourceStats().textureViews.pendingDestroy == 0);
+
+        //stale handles are reported instead of reaching a reused slot.
+        Buffer other = device.CreateBuffer(BufferCreation{.usage = BufferUsage::UniformBuffer, .size = 16});
+        CHECK(other.handler != buffer.handler);
+
+        u64 errors = device.commands.errors;
+        u32 value = 1;
+        device.UpdateBufferData(BufferDataInfo{.buffer = buffer, .data = &value, .size = sizeof(u32)});
+        device.DestroyBuffer(buffer);
+        CHECK(device.commands.errors == errors + 2);
+        CHECK(device.GetResourceStats().buffers.staleAccesses == 2);
+        CHECK(device.GetResourceStats().buffers.live == 1);
+
+        device.DestroyBuffer(other);
+        device.WaitQueue();
+        CHECK(device.GetResourceStats().buffers.pendingDestroy == 0);
+    }
+
+    TEST_CASE("Graphics::NullDevice::UploadAsync")
+    {
+        NullDevice device{};
+        Swapchain  swapchain = device.CreateSwapchain({});
+
+        Buffer gpuBuffer = device.CreateBuffer(BufferCreation{.usage = BufferUsage::StorageBuffer, .size = 8});
+        Buffer cpuBuffer = device.CreateBuffer(BufferCreation{.usage = BufferUsage::UniformBuffer, .size = 4, .allocation = BufferAllocation::TransferToCPU});
+
+        CHECK(device.IsUploadComplete(UploadToken{}));
+
+        //buffers visible to the cpu are written directly.
+        u32 value = 1;
+        UploadToken cpuToken = device.UploadAsync(BufferDataInfo{.buffer = cpuBuffer, .data = &value, .size = sizeof(u32)});
+        CHECK(cpuToken.value == 0);
+        CHECK(device.IsUploadComplete(cpuToken));
+        CHECK(*reinterpret_cast<u32*>(device.buffers.Get(cpuBuffer.handler)->data.Data()) == 1);
+
+        u32 first = 10;
+        u32 second = 20;
+        UploadToken firstToken = device.UploadAsync(BufferDataInfo{.buffer = gpuBuffer, .data = &first, .size = sizeof(u32)});
+        UploadToken secondToken = device.UploadAsync(BufferDataInfo{.buffer = gpuBuffer, .data = &second, .size = sizeof(u32), .offset = sizeof(u32)});
+        CHECK(secondToken.value > firstToken.value);
+        CHECK(!device.IsUploadComplete(firstToken));
+        CHECK(!device.IsUploadComplete(secondToken));
+
+        u32* data = reinterpret_cast<u32*>(device.buffers.Get(gpuBuffer.handler)->data.Data());
+        CHECK(data[0] == 0);
+
+        //waiting completes the uploads up to the token only.
+        device.WaitUpload(firstToken);
+        CHECK(device.IsUploadComplete(firstToken));
+        CHECK(!device.IsUploadComplete(secondToken));
+        CHECK(data[0] == 10);
+        CHECK(data[1] == 0);
+
+        //pending uploads are complete on the next frame.
+        RenderCommands& cmd = device.BeginFrame();
+        cmd.Begin();
+        cmd.End();
+        device.EndFrame(swapchain);
+        CHECK(device.IsUploadComplete(secondToken));
+        CHECK(data[1] == 20);
+        CHECK(device.GetUploadStats().uploads == 3);
+        CHECK(device.commands.errors == 0);
+
+        device.DestroyBuffer(gpuBuffer);
+        device.DestroyBuffer(cpuBuffer);
+    }
+}
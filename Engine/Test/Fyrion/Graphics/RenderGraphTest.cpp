@@ -0,0 +1,208 @@
+#include <doctest.h>
+
+#include "Fyrion/HeadlessEngine.hpp"
+#include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Graphics/RenderGraph.hpp"
+#include "Fyrion/Graphics/Device/Null/NullDevice.hpp"
+#include "Fyrion/Resource/Repository.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    u32 renderCount = 0;
+
+    struct GBufferPass : RenderGraphPass
+    {
+        void Setup(RenderGraphPassSetup& setup) override
+        {
+            setup.Output("albedo", {.format = Format::RGBA});
+            setup.Output("normal", {.format = Format::RGBA16F});
+            setup.Output("depth", {.format = Format::Depth});
+        }
+
+        void Render(const RenderGraphPassContext& context, RenderCommands& cmd) override
+        {
+            CHECK(context.GetOutput("albedo"));
+            CHECK(context.GetOutput("depth"));
+            renderCount++;
+        }
+    };
+
+    struct AOPass : RenderGraphPass
+    {
+        void Setup(RenderGraphPassSetup& setup) override
+        {
+            setup.Input("normal");
+            setup.Input("depth");
+            setup.Output("ao", {.format = Format::R, .scale = {0.5, 0.5}});
+        }
+
+        void Render(const RenderGraphPassContext& context, RenderCommands& cmd) override
+        {
+            CHECK(context.GetInput("normal"));
+            CHECK(context.extent == Extent{400, 300});
+            renderCount++;
+        }
+    };
+
+    struct LightingPass : RenderGraphPass
+    {
+        void Setup(RenderGraphPassSetup& setup) override
+        {
+            setup.Input("albedo");
+            setup.Input("normal");
+            setup.Input("ao");
+            setup.Output("color", {.format = Format::RGBA16F});
+        }
+
+        void Render(const RenderGraphPassContext& context, RenderCommands& cmd) override
+        {
+            renderCount++;
+        }
+    };
+
+    struct PostPass : RenderGraphPass
+    {
+        void Setup(RenderGraphPassSetup& setup) override
+        {
+            setup.Input("color");
+            setup.Output("final", {.format = Format::RGBA});
+        }
+
+        void Render(const RenderGraphPassContext& context, RenderCommands& cmd) override
+        {
+            renderCount++;
+        }
+    };
+
+    struct DebugPass : RenderGraphPass
+    {
+        void Setup(RenderGraphPassSetup& setup) override
+        {
+            setup.Input("normal");
+            setup.Output("debug", {.format = Format::RGBA});
+        }
+
+        void Render(const RenderGraphPassContext& context, RenderCommands& cmd) override
+        {
+            FAIL("culled pass executed");
+        }
+    };
+
+    void AddPass(ResourceObject& graph, StringView type, StringView name)
+    {
+        RID pass = Repository::CreateResource<RenderGraphPassAsset>();
+        ResourceObject write = Repository::Write(pass);
+        write.SetValue(RenderGraphPassAsset::Pass, String{type});
+        write.SetValue(RenderGraphPassAsset::Name, String{name});
+        write.Commit();
+        graph.AddToSubObjectSet(RenderGraphAsset::Passes, pass);
+    }
+
+    void AddEdge(ResourceObject& graph, StringView origin, StringView dest)
+    {
+        RID edge = Repository::CreateResource<RenderGraphEdgeAsset>();
+        ResourceObject write = Repository::Write(edge);
+        write.SetValue(RenderGraphEdgeAsset::Origin, String{origin});
+        write.SetValue(RenderGraphEdgeAsset::Dest, String{dest});
+        write.Commit();
+        graph.AddToSubObjectSet(RenderGraphAsset::Edges, edge);
+    }
+
+    TEST_CASE("Graphics::RenderGraph::Compile")
+    {
+        HeadlessEngine engine{};
+
+        Registry::Type<GBufferPass, RenderGraphPass>("Tests::GBufferPass");
+        Registry::Type<AOPass, RenderGraphPass>("Tests::AOPass");
+        Registry::Type<LightingPass, RenderGraphPass>("Tests::LightingPass");
+        Registry::Type<PostPass, RenderGraphPass>("Tests::PostPass");
+        Registry::Type<DebugPass, RenderGraphPass>("Tests::DebugPass");
+
+        RID graphRid = Repository::CreateResource<RenderGraphAsset>();
+        {
+            ResourceObject write = Repository::Write(graphRid);
+            AddPass(write, "Tests::PostPass", "Post");
+            AddPass(write, "Tests::LightingPass", "Lighting");
+            AddPass(write, "Tests::DebugPass", "Debug");
+            AddPass(write, "Tests::AOPass", "AO");
+            AddPass(write, "Tests::GBufferPass", "GBuffer");
+
+            AddEdge(write, "GBuffer.albedo", "Lighting.albedo");
+            AddEdge(write, "GBuffer.normal", "Lighting.normal");
+            AddEdge(write, "GBuffer.normal", "AO.normal");
+            AddEdge(write, "GBuffer.depth", "AO.depth");
+            AddEdge(write, "GBuffer.normal", "Debug.normal");
+            AddEdge(write, "AO.ao", "Lighting.ao");
+            AddEdge(write, "Lighting.color", "Post.color");
+
+            write.SetValue(RenderGraphAsset::ColorOutput, String{"Post.final"});
+            write.Commit();
+        }
+
+        RenderGraph* renderGraph = RenderGraph::Create({800, 600}, graphRid);
+        REQUIRE(renderGraph);
+
+        Array<String> order = renderGraph->GetExecutionOrder();
+        REQUIRE(order.Size() == 4);
+        CHECK(order[0] == "GBuffer");
+        CHECK(order[1] == "AO");
+        CHECK(order[2] == "Lighting");
+        CHECK(order[3] == "Post");
+
+        const RenderGraphStats& stats = renderGraph->GetStats();
+        CHECK(stats.passes == 4);
+        CHECK(stats.culledPasses == 1);
+        CHECK(stats.transientTextures == 6);
+
+        //final aliases albedo, both RGBA render targets sampled later.
+        CHECK(stats.physicalTextures == 5);
+        CHECK(stats.memorySaved == 800 * 600 * 4);
+
+        //albedo, normal, depth and color at full size, ao at half size.
+        CHECK(stats.textureMemory == 800 * 600 * (4 + 8 + 4 + 8) + 400 * 300);
+        CHECK(renderGraph->GetColorOutput());
+
+        NullCommands nullCommands{Logger::GetLogger("Fyrion::RenderGraphTest")};
+        nullCommands.Begin();
+        renderGraph->Execute(nullCommands);
+        nullCommands.End();
+
+        CHECK(nullCommands.errors == 0);
+        CHECK(renderCount == 4);
+
+        u32 barriers = 0;
+        for (const NullCommand& command : nullCommands.commands)
+        {
+            if (command.type == NullCommandType::ResourceBarrier)
+            {
+                barriers++;
+            }
+        }
+        CHECK(barriers == stats.barriers);
+
+        //the scaled ao pass renders at half the viewport.
+        Array<Extent> viewports{};
+        for (const NullCommand& command : nullCommands.commands)
+        {
+            if (command.type == NullCommandType::SetViewport)
+            {
+                viewports.EmplaceBack(Extent{command.values[0], command.values[1]});
+            }
+        }
+        REQUIRE(viewports.Size() == 4);
+        CHECK(viewports[0] == Extent{800, 600});
+        CHECK(viewports[1] == Extent{400, 300});
+        CHECK(viewports[2] == Extent{800, 600});
+
+        //outputs: 3 + 1 + 1 + 1, sampled: normal, depth, albedo, ao, color and the final output.
+        CHECK(stats.barriers == 12);
+
+        renderGraph->Resize({1024, 768});
+        CHECK(renderGraph->GetViewportExtent() == Extent{1024, 768});
+        CHECK(renderGraph->GetStats().memorySaved == 1024 * 768 * 4);
+
+        RenderGraph::Destroy(renderGraph);
+    }
+}
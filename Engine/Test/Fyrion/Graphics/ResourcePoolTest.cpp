@@ -0,0 +1,127 @@
+#include <doctest.h>
+
+#include "Fyrion/Graphics/Device/ResourcePool.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace Fyrion;
+
+namespace
+{
+    u32 destroyCount = 0;
+
+    struct TestResource
+    {
+        u32 value{};
+
+        ~TestResource()
+        {
+            destroyCount++;
+        }
+    };
+
+    TEST_CASE("Graphics::ResourcePool::Handles")
+    {
+        destroyCount = 0;
+        {
+            ResourcePool<TestResource, 4> pool{};
+
+            VoidPtr first = pool.Create(10u);
+            VoidPtr second = pool.Create(20u);
+            REQUIRE(pool.Get(first));
+            CHECK(pool.Get(first)->value == 10);
+            CHECK(pool.Get(second)->value == 20);
+            CHECK(pool.Get(nullptr) == nullptr);
+
+            TestResource* released = pool.Release(first, 5);
+            REQUIRE(released);
+            CHECK(released->value == 10);
+            CHECK(pool.Get(first) == nullptr);
+            CHECK(pool.Release(first, 5) == nullptr);
+
+            ResourcePoolStats stats = pool.GetStats();
+            CHECK(stats.live == 1);
+            CHECK(stats.pendingDestroy == 1);
+            CHECK(stats.capacity == 4);
+            CHECK(stats.staleAccesses == 2);
+
+            //released values are kept until their frame is completed.
+            u32 collected = 0;
+            pool.Collect(4, [&](TestResource& resource) { collected++; });
+            CHECK(collected == 0);
+            CHECK(destroyCount == 0);
+
+            pool.Collect(5, [&](TestResource& resource)
+            {
+                CHECK(resource.value == 10);
+                collected++;
+            });
+            CHECK(collected == 1);
+            CHECK(destroyCount == 1);
+            CHECK(pool.GetStats().pendingDestroy == 0);
+
+            //the slot is reused with a new generation, the old handle stays invalid.
+            VoidPtr reused = pool.Create(30u);
+            CHECK(reused != first);
+            CHECK((reinterpret_cast<u64>(reused) & U32_MAX) == (reinterpret_cast<u64>(first) & U32_MAX));
+            CHECK(pool.Get(first) == nullptr);
+            CHECK(pool.Get(reused)->value == 30);
+
+            //values keep their address when new pages are added.
+            TestResource* secondValue = pool.Get(second);
+            for (u32 i = 0; i < 8; ++i)
+            {
+                pool.Create(i);
+            }
+            CHECK(pool.Get(second) == secondValue);
+            CHECK(pool.GetStats().capacity == 12);
+            CHECK(pool.GetStats().live == 10);
+
+            u32 alive = 0;
+            pool.ForEachAlive([&](TestResource& resource) { alive++; });
+            CHECK(alive == 10);
+
+            pool.Release(second, 8);
+            pool.CollectAll([](TestResource& resource) {});
+            CHECK(destroyCount == 2);
+        }
+
+        //values still alive are destroyed with the pool.
+        CHECK(destroyCount == 11);
+    }
+
+    TEST_CASE("Graphics::ResourcePool::ConcurrentGet")
+    {
+        ResourcePool<TestResource, 4> pool{};
+        VoidPtr first = pool.Create(10u);
+
+        //other threads resolve handles while new pages are added.
+        std::atomic<bool> finished{};
+        std::atomic<u32>  failures{};
+        std::thread reader([&]
+        {
+            while (!finished)
+            {
+                TestResource* resource = pool.Get(first);
+                if (resource == nullptr || resource->value != 10)
+                {
+                    failures++;
+                }
+            }
+        });
+
+        Array<VoidPtr> handles{};
+        for (u32 i = 0; i < 4000; ++i)
+        {
+            handles.EmplaceBack(pool.Create(i));
+        }
+
+        finished = true;
+        reader.join();
+
+        CHECK(failures == 0);
+        CHECK(pool.GetStats().live == 4001);
+        CHECK(pool.Get(handles.Back())->value == 3999);
+    }
+}
@@ -3,6 +3,8 @@
 #include "Fyrion/Engine.hpp"
 #include "Fyrion/Assets/AssetTypes.hpp"
 #include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/Parallel.hpp"
+#include "Fyrion/Graphics/DrawBatcher.hpp"
 #include "Fyrion/Graphics/ShaderManager.hpp"
 #include "Fyrion/IO/Path.hpp"
 #include "Fyrion/Resource/Repository.hpp"
@@ -90,6 +92,258 @@ namespace
         Engine::Destroy();
     }
 
+	TEST_CASE("Graphics::ShaderManager::Cache")
+	{
+		Engine::Init();
+		{
+			String cacheDirectory = Path::Join(FileSystem::CurrentDir(), "ShaderCacheTest");
+			FileSystem::Remove(cacheDirectory);
+			ShaderManager::SetCacheDirectory(cacheDirectory);
+
+			ShaderCreation shaderCreation{
+				.source = simpleShader,
+				.entryPoint = "MainVS",
+				.shaderStage = ShaderStage::Vertex,
+				.renderApi = RenderApiType::Vulkan
+			};
+
+			Array<u8> compiled{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, compiled));
+			CHECK(ShaderManager::GetCacheStats().compiles == 1);
+
+			Array<u8> memory{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, memory));
+			CHECK(ShaderManager::GetCacheStats().memoryHits == 1);
+			CHECK(memory == compiled);
+
+			//same as a new process
+			ShaderManager::ClearCache();
+			Array<u8> disk{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, disk));
+			CHECK(ShaderManager::GetCacheStats().diskHits == 1);
+			CHECK(disk == compiled);
+
+			//other entry point is other key
+			shaderCreation.entryPoint = "MainPS";
+			shaderCreation.shaderStage = ShaderStage::Pixel;
+			Array<u8> pixel{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, pixel));
+			CHECK(ShaderManager::GetCacheStats().compiles == 2);
+
+			Array<ShaderStageInfo> stages{ShaderStageInfo{.stage = ShaderStage::Vertex, .entryPoint = "MainVS", .offset = 0, .size = static_cast<u32>(compiled.Size())}};
+			ShaderInfo info = ShaderManager::ExtractShaderInfo(compiled, stages, RenderApiType::Vulkan);
+			ShaderInfo cachedInfo = ShaderManager::ExtractShaderInfo(compiled, stages, RenderApiType::Vulkan);
+			CHECK(ShaderManager::GetCacheStats().reflectionHits == 1);
+			CHECK(cachedInfo.inputVariables.Size() == info.inputVariables.Size());
+			CHECK(cachedInfo.pushConstants.Size() == info.pushConstants.Size());
+
+			FileSystem::Remove(cacheDirectory);
+		}
+		Engine::Destroy();
+	}
+
+	TEST_CASE("Graphics::ShaderManager::ParallelCompile")
+	{
+		Engine::Init();
+		{
+			String cacheDirectory = Path::Join(FileSystem::CurrentDir(), "ShaderParallelCacheTest");
+			FileSystem::Remove(cacheDirectory);
+			ShaderManager::SetCacheDirectory(cacheDirectory);
+
+			//each source is different, none of them is served by the cache
+			constexpr usize count = 16;
+			Array<String> sources(count);
+			Array<Array<u8>> results(count);
+			bool valid[count]{};
+
+			for (usize i = 0; i < count; ++i)
+			{
+				sources[i] = simpleShader;
+				sources[i].Append("\n//");
+				sources[i].Append(static_cast<u32>(i));
+			}
+
+			Parallel::For(count, 0, [&](usize index)
+			{
+				valid[index] = ShaderManager::CompileShader(ShaderCreation{
+					.source = sources[index],
+					.entryPoint = index % 2 == 0 ? "MainVS" : "MainPS",
+					.shaderStage = index % 2 == 0 ? ShaderStage::Vertex : ShaderStage::Pixel,
+					.renderApi = RenderApiType::Vulkan
+				}, results[index]);
+			});
+
+			for (usize i = 0; i < count; ++i)
+			{
+				CHECK(valid[i]);
+				CHECK(!results[i].Empty());
+			}
+			CHECK(ShaderManager::GetCacheStats().compiles == count);
+
+			FileSystem::Remove(cacheDirectory);
+		}
+		Engine::Destroy();
+	}
+
+	TEST_CASE("Graphics::ShaderManager::Includes")
+	{
+		Engine::Init();
+		{
+			String directory = Path::Join(FileSystem::CurrentDir(), "ShaderIncludeTest");
+			FileSystem::Remove(directory);
+			REQUIRE(FileSystem::CreateDirectory(directory));
+			ShaderManager::SetCacheDirectory(Path::Join(directory, "Cache"));
+
+			String headerPath = Path::Join(directory, "Common.hlsli");
+			auto writeHeader = [&](const StringView& content)
+			{
+				FileHandler fileHandler = FileSystem::OpenFile(headerPath, AccessMode::WriteOnly);
+				FileSystem::WriteFile(fileHandler, content.Data(), content.Size());
+				FileSystem::CloseFile(fileHandler);
+			};
+			writeHeader("float4 GetColor() { return float4(1, 0, 0, 1); }");
+
+			String source = "#include \"Common.hlsli\"\n float4 MainPS() : SV_TARGET { return GetColor(); }";
+			ShaderCreation shaderCreation{
+				.source = source,
+				.entryPoint = "MainPS",
+				.shaderStage = ShaderStage::Pixel,
+				.renderApi = RenderApiType::Vulkan,
+				.path = Path::Join(directory, "Shader.raster")
+			};
+
+			Array<u8> bytes{};
+			Array<String> dependencies{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, bytes, &dependencies));
+			REQUIRE(dependencies.Size() == 1);
+			CHECK(dependencies[0] == headerPath);
+
+			//unchanged header, served by the cache with the same dependencies
+			Array<u8> cached{};
+			Array<String> cachedDependencies{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, cached, &cachedDependencies));
+			CHECK(ShaderManager::GetCacheStats().memoryHits == 1);
+			CHECK(cachedDependencies.Size() == 1);
+			CHECK(cached == bytes);
+
+			//changed header, compiled again
+			writeHeader("float4 GetColor() { return float4(0, 1, 0, 1); }");
+			Array<u8> recompiled{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, recompiled));
+			CHECK(ShaderManager::GetCacheStats().invalidations == 1);
+			CHECK(ShaderManager::GetCacheStats().compiles == 2);
+			CHECK(recompiled != bytes);
+
+			//same source on other directory includes its own header
+			String otherDirectory = Path::Join(directory, "Other");
+			REQUIRE(FileSystem::CreateDirectory(otherDirectory));
+			String otherHeaderPath = Path::Join(otherDirectory, "Common.hlsli");
+			{
+				StringView content = "float4 GetColor() { return float4(0, 0, 1, 1); }";
+				FileHandler fileHandler = FileSystem::OpenFile(otherHeaderPath, AccessMode::WriteOnly);
+				FileSystem::WriteFile(fileHandler, content.Data(), content.Size());
+				FileSystem::CloseFile(fileHandler);
+			}
+
+			shaderCreation.path = Path::Join(otherDirectory, "Shader.raster");
+			Array<u8> other{};
+			Array<String> otherDependencies{};
+			REQUIRE(ShaderManager::CompileShader(shaderCreation, other, &otherDependencies));
+			CHECK(ShaderManager::GetCacheStats().compiles == 3);
+			REQUIRE(otherDependencies.Size() == 1);
+			CHECK(otherDependencies[0] == otherHeaderPath);
+			CHECK(other != recompiled);
+
+			FileSystem::Remove(directory);
+		}
+		Engine::Destroy();
+	}
+
+	TEST_CASE("Graphics::ShaderManager::ParsePermutations")
+	{
+		String source = "#pragma permutation USE_FOG\n  #pragma permutation USE_SHADOWS\r\n#pragma permutation USE_FOG\nfloat4 MainPS() : SV_TARGET { return 0; }";
+		usize size = source.Size();
+
+		Array<String> keys = ShaderManager::ParsePermutations(source);
+		REQUIRE(keys.Size() == 2);
+		CHECK(keys[0] == "USE_FOG");
+		CHECK(keys[1] == "USE_SHADOWS");
+
+		//lines are kept, only the directive is blanked
+		CHECK(source.Size() == size);
+		CHECK(ShaderManager::ParsePermutations(source).Empty());
+
+		Array<String> defines = ShaderManager::GetPermutationDefines(keys, 2);
+		REQUIRE(defines.Size() == 2);
+		CHECK(defines[0] == "USE_FOG=0");
+		CHECK(defines[1] == "USE_SHADOWS=1");
+	}
+
+	TEST_CASE("Graphics::ShaderManager::Variants")
+	{
+		Engine::Init();
+		{
+			String directory = Path::Join(FileSystem::CurrentDir(), "ShaderVariantTest");
+			FileSystem::Remove(directory);
+			REQUIRE(FileSystem::CreateDirectory(directory));
+			ShaderManager::SetCacheDirectory(Path::Join(directory, "Cache"));
+
+			//USE_UNUSED doesn't change the code, its variants share the resource
+			StringView source = "#pragma permutation USE_RED\n"
+				"#pragma permutation USE_UNUSED\n"
+				"float4 MainPS() : SV_TARGET\n"
+				"{\n"
+				"#if USE_RED\n"
+				"    return float4(1, 0, 0, 1);\n"
+				"#else\n"
+				"    return float4(0, 1, 0, 1);\n"
+				"#endif\n"
+				"}\n"
+				"float4 MainVS() : SV_POSITION { return 0; }\n";
+
+			FileHandler fileHandler = FileSystem::OpenFile(Path::Join(directory, "Variant.raster"), AccessMode::WriteOnly);
+			FileSystem::WriteFile(fileHandler, source.Data(), source.Size());
+			FileSystem::CloseFile(fileHandler);
+
+			ResourceAssets::LoadAssetsFromDirectory("Variant", directory);
+
+			RID shader = Repository::GetByPath("Variant://Variant.raster");
+			REQUIRE(shader);
+
+			ResourceObject shaderObject = Repository::Read(shader);
+			CHECK(shaderObject[ShaderAsset::Permutations].Value<Span<String>>().Size() == 2);
+
+			Array<String> unusedDefines{"USE_UNUSED"};
+			Array<String> redDefines{"USE_RED"};
+			Array<String> redUnusedDefines{"USE_RED", "USE_UNUSED"};
+
+			CHECK(ShaderManager::GetShaderVariant(shader, {}) == shader);
+			CHECK(ShaderManager::GetShaderVariant(shader, unusedDefines) == shader);
+			CHECK(ShaderManager::GetShaderVariantCount(shader) == 0);
+
+			RID red = ShaderManager::GetShaderVariant(shader, redDefines);
+			REQUIRE(red);
+			CHECK(red != shader);
+			CHECK(ShaderManager::GetShaderVariant(shader, redUnusedDefines) == red);
+			CHECK(ShaderManager::GetShaderVariant(shader, redDefines) == red);
+			CHECK(ShaderManager::GetShaderVariantCount(shader) == 1);
+
+			ResourceObject redObject = Repository::Read(red);
+			CHECK(redObject[ShaderAsset::Bytes].Value<Span<u8>>() != shaderObject[ShaderAsset::Bytes].Value<Span<u8>>());
+
+			//a new version of the asset recompiles its variants, the replaced one stays alive for frames in flight.
+			Repository::Write(shader).Commit();
+			RID reloadedRed = ShaderManager::GetShaderVariant(shader, redDefines);
+			REQUIRE(reloadedRed);
+			CHECK(reloadedRed != red);
+			Repository::GarbageCollect();
+			CHECK(Repository::IsAlive(red));
+
+			FileSystem::Remove(directory);
+		}
+		Engine::Destroy();
+	}
+
 	TEST_CASE("Graphics::ShaderAsset")
     {
     	Engine::Init();
@@ -190,4 +444,34 @@ namespace
     	Engine::Destroy();
 
     }
+
+    TEST_CASE("Graphics::ShaderAsset::GPUCulling")
+    {
+        Engine::Init();
+        {
+            ResourceAssets::LoadAssetsFromDirectory("Fyrion", Path::Join(FileSystem::AssetFolder(), "Fyrion"));
+
+            ResourceObject shader = Repository::Read(Repository::GetByPath("Fyrion://Shaders/GPUCulling.comp"));
+            REQUIRE(shader);
+
+            CHECK(!shader[ShaderAsset::Bytes].As<Span<u8>>().Empty());
+
+            Span<ShaderStageInfo> stages = shader[ShaderAsset::Stages].As<Span<ShaderStageInfo>>();
+            ShaderInfo shaderInfo = shader[ShaderAsset::Info].As<ShaderInfo>();
+
+            REQUIRE(stages.Size() == 1);
+            CHECK(stages[0].stage == ShaderStage::Compute);
+
+            REQUIRE(shaderInfo.descriptors.Size() == 1);
+            REQUIRE(shaderInfo.descriptors[0].bindings.Size() == 3);
+            for (const DescriptorBinding& binding : shaderInfo.descriptors[0].bindings)
+            {
+                CHECK(binding.descriptorType == DescriptorType::StorageBuffer);
+            }
+
+            REQUIRE(shaderInfo.pushConstants.Size() == 1);
+            CHECK(shaderInfo.pushConstants[0].size == sizeof(DrawCullConstants));
+        }
+        Engine::Destroy();
+    }
 }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Fyrion/Engine.hpp"
+
+namespace Fyrion
+{
+    //engine with a headless context for the scope of a test. the context is destroyed on exit,
+    //tests that call Engine::Run leave nothing to destroy.
+    struct HeadlessEngine
+    {
+        explicit HeadlessEngine(EngineContextCreation contextCreation = {})
+        {
+            contextCreation.headless = true;
+            Engine::Init();
+            Engine::CreateContext(contextCreation);
+        }
+
+        ~HeadlessEngine()
+        {
+            Engine::DestroyContext();
+            Engine::Destroy();
+        }
+
+        HeadlessEngine(const HeadlessEngine&) = delete;
+        HeadlessEngine& operator=(const HeadlessEngine&) = delete;
+    };
+}
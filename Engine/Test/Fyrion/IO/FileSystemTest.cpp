@@ -1,6 +1,13 @@
+#include <atomic>
+#include <cstring>
 #include <doctest.h>
 #include "Fyrion/IO/FileSystem.hpp"
 #include "Fyrion/IO/Path.hpp"
+#include "Fyrion/IO/FileWatcher.hpp"
+#include "Fyrion/IO/FileTransaction.hpp"
+#include "Fyrion/IO/AsyncIO.hpp"
+#include "Fyrion/Platform/Platform.hpp"
+#include "Fyrion/Engine.hpp"
 
 using namespace Fyrion;
 
@@ -47,4 +54,199 @@ namespace
 
         CHECK(FileSystem::Remove(path));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("IO::FileWatcher")
+    {
+        String directory = Path::Join(FileSystem::CurrentDir(), "FileWatcherTest");
+        FileSystem::Remove(directory);
+        REQUIRE(FileSystem::CreateDirectory(directory));
+
+        {
+            FileWatcher fileWatcher{};
+            fileWatcher.SetDebounceTime(0.01);
+            fileWatcher.SetPollingInterval(0.05);
+            fileWatcher.Watch(directory);
+
+            String path = Path::Join(directory, "File.txt");
+            FileHandler fileHandler = FileSystem::OpenFile(path, AccessMode::WriteOnly);
+            FileSystem::WriteFile(fileHandler, "abc", 3);
+            FileSystem::CloseFile(fileHandler);
+
+            Array<FileWatcherEvent> events{};
+            f64 start = Platform::GetTime();
+            while (events.Empty() && Platform::GetTime() - start < 3.0)
+            {
+                fileWatcher.Poll(events);
+            }
+
+            REQUIRE(events.Size() == 1);
+            CHECK(events[0].path == path);
+            CHECK(events[0].event == FileNotifyEvent::Added);
+        }
+
+        CHECK(FileSystem::Remove(directory));
+    }
+
+    void WriteTestFile(const StringView& path, const StringView& content)
+    {
+        FileHandler fileHandler = FileSystem::OpenFile(path, AccessMode::WriteOnly);
+        FileSystem::WriteFile(fileHandler, content.Data(), content.Size());
+        FileSystem::CloseFile(fileHandler);
+    }
+
+    TEST_CASE("IO::FileTransaction")
+    {
+        String directory = Path::Join(FileSystem::CurrentDir(), "FileTransactionTest");
+        FileSystem::Remove(directory);
+        REQUIRE(FileSystem::CreateDirectory(directory));
+
+        String file1 = Path::Join(directory, "File1.txt");
+        String file2 = Path::Join(directory, "File2.txt");
+        String file3 = Path::Join(directory, "File3.txt");
+        WriteTestFile(file1, "old content");
+        WriteTestFile(file3, "removed");
+
+        {
+            FileTransaction transaction{directory};
+            CHECK(transaction.Write(file1, "new", 3));
+            CHECK(FileSystem::ReadFileAsString(file1) == "old content");
+        }
+
+        //not committed
+        CHECK(FileSystem::ReadFileAsString(file1) == "old content");
+        CHECK(!FileSystem::GetFileStatus(String{file1} + FY_TEMP_EXTENSION).exists);
+
+        {
+            FileTransaction transaction{directory};
+            CHECK(transaction.Write(file1, "new", 3));
+            CHECK(transaction.Write(file2, "file2", 5));
+            transaction.Remove(file3);
+            CHECK(transaction.Commit());
+        }
+
+        CHECK(FileSystem::ReadFileAsString(file1) == "new");
+        CHECK(FileSystem::ReadFileAsString(file2) == "file2");
+        CHECK(!FileSystem::GetFileStatus(file3).exists);
+        CHECK(!FileSystem::GetFileStatus(Path::Join(directory, FY_MANIFEST_FILE)).exists);
+
+        //interrupted after the manifest is written
+        {
+            String tempFile = String{file1} + FY_TEMP_EXTENSION;
+            WriteTestFile(tempFile, "recovered");
+            WriteTestFile(Path::Join(directory, FY_MANIFEST_FILE), String{"R\t"} + tempFile + "\t" + file1 + "\nD\t" + file2 + "\n");
+
+            CHECK(FileTransaction::Recover(directory));
+            CHECK(FileSystem::ReadFileAsString(file1) == "recovered");
+            CHECK(!FileSystem::GetFileStatus(tempFile).exists);
+            CHECK(!FileSystem::GetFileStatus(file2).exists);
+            CHECK(!FileSystem::GetFileStatus(Path::Join(directory, FY_MANIFEST_FILE)).exists);
+            CHECK(!FileTransaction::Recover(directory));
+        }
+
+        //a failed rename keeps the manifest, recover finishes it once the destination is free.
+        {
+            String blocked = Path::Join(directory, "Blocked");
+            REQUIRE(FileSystem::CreateDirectory(blocked));
+            WriteTestFile(Path::Join(blocked, "File.txt"), "blocking");
+
+            {
+                FileTransaction transaction{directory};
+                CHECK(transaction.Write(blocked, "blocked", 7));
+                CHECK(!transaction.Commit());
+            }
+
+            CHECK(FileSystem::GetFileStatus(Path::Join(directory, FY_MANIFEST_FILE)).exists);
+            CHECK(FileSystem::GetFileStatus(String{blocked} + FY_TEMP_EXTENSION).exists);
+            CHECK(!FileTransaction::Recover(directory));
+
+            CHECK(FileSystem::Remove(blocked));
+            CHECK(FileTransaction::Recover(directory));
+            CHECK(FileSystem::ReadFileAsString(blocked) == "blocked");
+            CHECK(!FileSystem::GetFileStatus(Path::Join(directory, FY_MANIFEST_FILE)).exists);
+        }
+
+        CHECK(FileSystem::Remove(directory));
+    }
+
+    struct AsyncReadResult
+    {
+        std::atomic<u32> success{};
+        std::atomic<u32> cancelled{};
+        std::atomic<u64> bytes{};
+    };
+
+    void AsyncReadCallback(VoidPtr userData, IOResult result, usize bytes)
+    {
+        AsyncReadResult* readResult = static_cast<AsyncReadResult*>(userData);
+        if (result == IOResult::Success) readResult->success++;
+        if (result == IOResult::Cancelled) readResult->cancelled++;
+        readResult->bytes += bytes;
+    }
+
+    TEST_CASE("IO::AsyncIO")
+    {
+        Engine::Init();
+
+        constexpr usize blockSize = 4096;
+        constexpr usize blockCount = 32;
+
+        Array<u8> content(blockSize * blockCount);
+        for (usize i = 0; i < content.Size(); ++i)
+        {
+            content[i] = static_cast<u8>(i * 7 + i / blockSize);
+        }
+
+        String file = Path::Join(FileSystem::CurrentDir(), "AsyncIOTest");
+        FileHandler fileHandler = FileSystem::OpenFile(file, AccessMode::WriteOnly);
+        FileSystem::WriteFile(fileHandler, content.Data(), content.Size());
+        FileSystem::CloseFile(fileHandler);
+
+        AsyncIOStats before = AsyncIO::GetStats();
+
+        Array<u8> buffer(content.Size());
+        AsyncReadResult readResult{};
+
+        for (usize i = 0; i < blockCount; ++i)
+        {
+            IOPriority priority = i % 3 == 0 ? IOPriority::High : i % 3 == 1 ? IOPriority::Normal : IOPriority::Low;
+            AsyncIO::Read(file, i * blockSize, blockSize, buffer.Data() + i * blockSize, priority, &readResult, AsyncReadCallback);
+        }
+        AsyncIO::WaitIdle();
+
+        CHECK(readResult.success == blockCount);
+        CHECK(readResult.bytes == content.Size());
+        CHECK(memcmp(buffer.Data(), content.Data(), content.Size()) == 0);
+
+        AsyncIOStats after = AsyncIO::GetStats();
+        CHECK(after.completed - before.completed == blockCount);
+        CHECK(after.bytesRead - before.bytesRead == content.Size());
+        CHECK(after.queued == 0);
+        CHECK(after.inFlight == 0);
+
+        //a request is either cancelled while queued or completed, never both
+        {
+            AsyncReadResult cancelResult{};
+            u8 data[16]{};
+            IORequest request = AsyncIO::Read(file, blockSize, sizeof(data), data, IOPriority::Low, &cancelResult, AsyncReadCallback);
+            bool cancelled = AsyncIO::Cancel(request);
+            AsyncIO::WaitIdle();
+            CHECK(cancelResult.cancelled == (cancelled ? 1 : 0));
+            CHECK(cancelResult.success == (cancelled ? 0 : 1));
+            CHECK(!AsyncIO::Cancel(request));
+        }
+
+        //past the end of the file
+        {
+            AsyncReadResult eofResult{};
+            u8 data[16]{};
+            AsyncIO::Read(file, content.Size() - 4, sizeof(data), data, IOPriority::Normal, &eofResult, AsyncReadCallback);
+            AsyncIO::WaitIdle();
+            CHECK(eofResult.success == 1);
+            CHECK(eofResult.bytes == 4);
+        }
+
+        CHECK(FileSystem::Remove(file));
+
+        Engine::Destroy();
+    }
+}
@@ -1,3 +1,4 @@
+#include <cstring>
 #include <thread>
 #include <iostream>
 #include "doctest.h"
@@ -5,6 +6,12 @@
 #include "Fyrion/Core/Registry.hpp"
 //#include "Fyrion/EntryPoint.hpp"
 #include "Fyrion/Engine.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/Path.hpp"
+#include "Fyrion/IO/FileTransaction.hpp"
+#include "Fyrion/IO/AsyncIO.hpp"
+#include "Fyrion/Core/Random.hpp"
+#include "Fyrion/Core/Algorithm.hpp"
 
 using namespace Fyrion;
 
@@ -30,6 +37,11 @@ namespace
             constexpr static u32 TestValue = 0;
         };
 
+        struct TestStreamResource
+        {
+            constexpr static u32 Stream = 0;
+        };
+
         struct TestStructResource
         {
             String strTest{};
@@ -520,6 +532,38 @@ namespace
         Engine::Destroy();
     }
 
+    TEST_CASE("Repository::ReplaceResource")
+    {
+        Engine::Init();
+        CreateResourceTypes();
+        {
+            usize count = Repository::GetResourcesByType(GetTypeID<TestOtherResource>()).Size();
+
+            RID rid = Repository::CreateResource<TestOtherResource>();
+            RID source = Repository::CreateResource<TestOtherResource>();
+            {
+                ResourceObject write = Repository::Write(source);
+                write.SetValue(TestOtherResource::TestValue, 42);
+                write.Commit();
+            }
+
+            CHECK(Repository::GetResourcesByType(GetTypeID<TestOtherResource>()).Size() == count + 2);
+
+            Repository::ReplaceResource(rid, source);
+            CHECK(Repository::Read(rid).GetValue<i32>(TestOtherResource::TestValue) == 42);
+
+            //the source storage is consumed, it's not listed by its type anymore
+            Array<RID> resources = Repository::GetResourcesByType(GetTypeID<TestOtherResource>());
+            REQUIRE(resources.Size() == count + 1);
+            CHECK(FindFirst(resources.begin(), resources.end(), rid) != resources.end());
+
+            Repository::DestroyResource(rid);
+            Repository::GarbageCollect();
+            CHECK(Repository::GetResourcesByType(GetTypeID<TestOtherResource>()).Size() == count);
+        }
+        Engine::Destroy();
+    }
+
     TEST_CASE("Repository::TestMultithreading")
     {
         //breaking allocator count at end, but the test works
@@ -602,4 +646,288 @@ namespace
         Engine::Destroy();
 #endif
     }
-}
\ No newline at end of file
+
+    TEST_CASE("Repository::Streams")
+    {
+        Engine::Init();
+        {
+            ResourceTypeBuilder<TestStreamResource>::Builder()
+                .Stream<TestStreamResource::Stream>("Stream")
+                .Build();
+
+            u8 bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+            RID rid = Repository::CreateResource<TestStreamResource>();
+            {
+                ResourceObject write = Repository::Write(rid);
+                write.WriteStream(TestStreamResource::Stream)->Set(bytes, sizeof(bytes));
+                write.Commit();
+            }
+
+            ResourceObject read = Repository::Read(rid);
+            StreamObject* stream = read.GetStream(TestStreamResource::Stream);
+            REQUIRE(stream);
+            CHECK(stream->Size() == 8);
+
+            u8 range[3]{};
+            stream->Get(range, 3, 4);
+            CHECK(range[0] == 5);
+            CHECK(range[1] == 6);
+            CHECK(range[2] == 7);
+
+            Span<const u8> map = stream->Map(6, 10);
+            REQUIRE(map.Size() == 2);
+            CHECK(map[0] == 7);
+            CHECK(map[1] == 8);
+            CHECK(stream->Map(8, 1).Empty());
+
+            //the old version keeps its mapping after the stream is replaced
+            {
+                u8 newBytes[] = {9, 9};
+                ResourceObject write = Repository::Write(rid);
+                write.WriteStream(TestStreamResource::Stream)->Set(newBytes, sizeof(newBytes));
+                write.Commit();
+            }
+
+            CHECK(stream->Size() == 8);
+            CHECK(stream->Map(0, 1)[0] == 1);
+            CHECK(Repository::Read(rid).GetStream(TestStreamResource::Stream)->Size() == 2);
+
+            //offset is the start of the stream inside the file
+            StreamObject mapped{};
+            CHECK(mapped.Size() == 0);
+            CHECK(mapped.Map(0, 1).Empty());
+
+            String file = Path::Join(FileSystem::CurrentDir(), "StreamTestFile");
+            FileHandler fileHandler = FileSystem::OpenFile(file, AccessMode::WriteOnly);
+            FileSystem::WriteFile(fileHandler, bytes, sizeof(bytes));
+            FileSystem::CloseFile(fileHandler);
+
+            mapped.MapTo(file, 2);
+            CHECK(mapped.Size() == 6);
+            CHECK(mapped.Map(0, 1)[0] == 3);
+
+            //async reads are clamped to the stream size
+            u8 asyncRange[5]{};
+            usize asyncBytes{};
+            mapped.GetAsync(asyncRange, 10, 1, IOPriority::High, &asyncBytes, [](VoidPtr userData, IOResult result, usize bytes)
+            {
+                *static_cast<usize*>(userData) = result == IOResult::Success ? bytes : 0;
+            });
+            AsyncIO::WaitIdle();
+            CHECK(asyncBytes == 5);
+            CHECK(asyncRange[0] == 4);
+            CHECK(asyncRange[4] == 8);
+
+            StreamObject copy = mapped;
+            FileSystem::Remove(file);
+            CHECK(copy.Map(5, 1)[0] == 8);
+
+            char strBuffer[17]{};
+            usize bufSize = U64ToHex(stream->GetBufferId(), strBuffer);
+            FileSystem::Remove(Path::Join(FileSystem::TempFolder(), StringView{strBuffer, bufSize}));
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Repository::CompressedStreams")
+    {
+        Engine::Init();
+        {
+            //3 chunks and a half, first half repetitive and second half noise
+            Array<u8> bytes(64 * 1024 * 3 + 1000);
+            for (usize i = 0; i < bytes.Size(); ++i)
+            {
+                bytes[i] = i < bytes.Size() / 2 ? static_cast<u8>(i % 13) : static_cast<u8>(Random::Xorshift64star());
+            }
+
+            StreamObject raw{};
+            raw.SetBufferId(Random::Xorshift64star());
+            raw.Set(bytes.Data(), bytes.Size());
+            CHECK(!raw.IsCompressed());
+
+            Array<u8> compressed{};
+            raw.Compress(compressed);
+            CHECK(compressed.Size() < bytes.Size());
+
+            String file = Path::Join(FileSystem::CurrentDir(), "CompressedStreamTestFile");
+            FileHandler fileHandler = FileSystem::OpenFile(file, AccessMode::WriteOnly);
+            FileSystem::WriteFile(fileHandler, compressed.Data(), compressed.Size());
+            FileSystem::CloseFile(fileHandler);
+
+            StreamObject stream{};
+            stream.MapTo(file, 0, StreamEncoding::Chunked);
+            REQUIRE(stream.IsCompressed());
+            CHECK(stream.Size() == bytes.Size());
+
+            //range crossing chunk boundaries
+            Array<u8> range(70000);
+            stream.Get(range.Data(), range.Size(), 60000);
+            CHECK(memcmp(range.Data(), bytes.Data() + 60000, range.Size()) == 0);
+
+            //clamped to the end
+            u8 tail[16]{};
+            stream.Get(tail, sizeof(tail), bytes.Size() - 4);
+            CHECK(memcmp(tail, bytes.Data() + bytes.Size() - 4, 4) == 0);
+
+            //only the chunk of the range is decoded
+            u64 decodedBytes = stream.GetCompressionStats().decodedBytes;
+            Span<const u8> map = stream.Map(100, 10);
+            REQUIRE(map.Size() == 10);
+            CHECK(memcmp(map.Data(), bytes.Data() + 100, 10) == 0);
+            CHECK(stream.GetCompressionStats().decodedBytes == decodedBytes + 64 * 1024);
+
+            map = stream.Map(64 * 1024 * 2 + 5, 10);
+            REQUIRE(map.Size() == 10);
+            CHECK(memcmp(map.Data(), bytes.Data() + 64 * 1024 * 2 + 5, 10) == 0);
+
+            //decoded chunks are reused
+            decodedBytes = stream.GetCompressionStats().decodedBytes;
+            CHECK(stream.Map(50, 100).Size() == 100);
+            CHECK(stream.GetCompressionStats().decodedBytes == decodedBytes);
+
+            Array<u8> asyncRange(1000);
+            usize asyncBytes{};
+            stream.GetAsync(asyncRange.Data(), asyncRange.Size(), 64 * 1024 - 500, IOPriority::Normal, &asyncBytes, [](VoidPtr userData, IOResult result, usize bytes)
+            {
+                *static_cast<usize*>(userData) = result == IOResult::Success ? bytes : 0;
+            });
+            AsyncIO::WaitIdle();
+            CHECK(asyncBytes == asyncRange.Size());
+            CHECK(memcmp(asyncRange.Data(), bytes.Data() + 64 * 1024 - 500, asyncRange.Size()) == 0);
+
+            StreamCompressionStats stats = stream.GetCompressionStats();
+            CHECK(stats.size == bytes.Size());
+            CHECK(stats.compressedSize == compressed.Size());
+            CHECK(stats.ratio > 1.0);
+            CHECK(stats.decodedBytes > 0);
+
+            //already compressed streams are copied as they are
+            Array<u8> copy{};
+            stream.Compress(copy);
+            CHECK(copy == compressed);
+
+            //raw data that looks like a chunk table is not decoded
+            {
+                StreamObject lookalike{};
+                lookalike.SetBufferId(Random::Xorshift64star());
+                lookalike.Set(compressed.Data(), compressed.Size());
+                CHECK(!lookalike.IsCompressed());
+                CHECK(lookalike.Size() == compressed.Size());
+
+                lookalike.MapTo(file, 0);
+                CHECK(!lookalike.IsCompressed());
+                CHECK(lookalike.Size() == compressed.Size());
+
+                char strBuffer[17]{};
+                usize bufSize = U64ToHex(lookalike.GetBufferId(), strBuffer);
+                lookalike = {};
+                FileSystem::Remove(Path::Join(FileSystem::TempFolder(), StringView{strBuffer, bufSize}));
+            }
+
+            //a corrupted chunk fails the read instead of returning partially decoded data.
+            {
+                u64 chunkOffsets[2];
+                MemCopy(chunkOffsets, compressed.Data() + 24, sizeof(chunkOffsets));
+                for (u64 i = chunkOffsets[0]; i < chunkOffsets[1]; ++i)
+                {
+                    compressed[i] = 0;
+                }
+
+                String corruptedFile = Path::Join(FileSystem::CurrentDir(), "CorruptedStreamTestFile");
+                fileHandler = FileSystem::OpenFile(corruptedFile, AccessMode::WriteOnly);
+                FileSystem::WriteFile(fileHandler, compressed.Data(), compressed.Size());
+                FileSystem::CloseFile(fileHandler);
+
+                StreamObject corrupted{};
+                corrupted.MapTo(corruptedFile, 0, StreamEncoding::Chunked);
+                REQUIRE(corrupted.IsCompressed());
+
+                u8 head[16];
+                MemSet(head, 1, sizeof(head));
+                corrupted.Get(head, sizeof(head), 0);
+                CHECK(head[1] == 0);
+                CHECK(head[15] == 0);
+
+                CHECK(corrupted.Map(0, 10).Size() == 0);
+
+                IOResult asyncResult{};
+                corrupted.GetAsync(head, sizeof(head), 0, IOPriority::Normal, &asyncResult, [](VoidPtr userData, IOResult result, usize bytes)
+                {
+                    *static_cast<IOResult*>(userData) = result;
+                });
+                AsyncIO::WaitIdle();
+                CHECK(asyncResult == IOResult::Failed);
+
+                corrupted = {};
+                FileSystem::Remove(corruptedFile);
+            }
+
+            FileSystem::Remove(file);
+
+            char strBuffer[17]{};
+            usize bufSize = U64ToHex(raw.GetBufferId(), strBuffer);
+            FileSystem::Remove(Path::Join(FileSystem::TempFolder(), StringView{strBuffer, bufSize}));
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Repository::StreamWriter")
+    {
+        Engine::Init();
+        {
+            //more than all write behind buffers, appended in sizes that don't match the chunks
+            Array<u8> bytes(5 * 1024 * 1024 + 123);
+            for (usize i = 0; i < bytes.Size(); ++i)
+            {
+                bytes[i] = static_cast<u8>(Random::Xorshift64star());
+            }
+
+            StreamObject stream{};
+            stream.SetBufferId(Random::Xorshift64star());
+            stream.BeginWrite();
+            for (usize offset = 0; offset < bytes.Size(); offset += 10007)
+            {
+                stream.Append(bytes.Data() + offset, Math::Min(static_cast<usize>(10007), bytes.Size() - offset));
+            }
+            REQUIRE(stream.EndWrite());
+
+            REQUIRE(stream.Size() == bytes.Size());
+            Array<u8> data(bytes.Size());
+            stream.Get(data.Data(), data.Size(), 0);
+            CHECK(data == bytes);
+
+            CHECK(stream.GetContentHash());
+            CHECK(stream.GetContentHash() == stream.ComputeContentHash());
+
+            StreamObject copy = stream;
+            stream.BeginWrite();
+            stream.Append(bytes.Data(), 10);
+            REQUIRE(stream.EndWrite());
+            CHECK(stream.Size() == 10);
+            CHECK(copy.Size() == bytes.Size());
+
+            char strBuffer[17]{};
+            usize bufSize = U64ToHex(stream.GetBufferId(), strBuffer);
+            FileSystem::Remove(Path::Join(FileSystem::TempFolder(), StringView{strBuffer, bufSize}));
+
+            //the buffer file can't be replaced, the temp file is removed and the write fails
+            {
+                StreamObject blocked{};
+                blocked.SetBufferId(Random::Xorshift64star());
+                bufSize = U64ToHex(blocked.GetBufferId(), strBuffer);
+                String bufferFile = Path::Join(FileSystem::TempFolder(), StringView{strBuffer, bufSize});
+                REQUIRE(FileSystem::CreateDirectory(Path::Join(bufferFile, "Blocked")));
+
+                blocked.BeginWrite();
+                blocked.Append(bytes.Data(), 10);
+                CHECK(!blocked.EndWrite());
+                CHECK(!FileSystem::GetFileStatus(bufferFile + FY_TEMP_EXTENSION).exists);
+                CHECK(blocked.Size() == 0);
+
+                FileSystem::Remove(bufferFile);
+            }
+        }
+        Engine::Destroy();
+    }
+}
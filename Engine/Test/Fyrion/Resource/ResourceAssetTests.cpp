@@ -20,6 +20,11 @@ namespace
         constexpr static u32 Content = 0;
 	};
 
+    struct StreamAsset
+    {
+        constexpr static u32 Stream = 0;
+    };
+
 	RID TxtAssetLoadFunction(RID asset, const StringView& path)
 	{
 		String txt = FileSystem::ReadFileAsString(path);
@@ -32,6 +37,28 @@ namespace
 		return rid;
 	}
 
+	//first line is the name of a file on the same directory that is appended to the content.
+	RID IncludeAssetLoadFunction(RID asset, const StringView& path)
+	{
+		String txt = FileSystem::ReadFileAsString(path);
+		usize lineEnd = txt.Find('\n');
+		String includePath = Path::Join(Path::Parent(path), StringView{txt}.Substr(0, lineEnd));
+
+		String content = StringView{txt}.Substr(lineEnd + 1);
+		content.Append(FileSystem::ReadFileAsString(includePath));
+
+		Array<String> dependencies{};
+		dependencies.EmplaceBack(includePath);
+		ResourceAssets::SetAssetDependencies(asset, dependencies);
+
+		RID rid = Repository::CreateResource<TxtAsset>();
+		ResourceObject txtAsset = Repository::Write(rid);
+		txtAsset.SetValue(TxtAsset::Content, Traits::Move(content));
+		txtAsset.Commit();
+
+		return rid;
+	}
+
 	TEST_CASE("Repository::AssetsBasic")
 	{
 		Engine::Init();
@@ -81,6 +108,11 @@ namespace
             Array<RID> assets = assetRoot.GetSubObjectSetAsArray(AssetRoot::Assets);
             CHECK(assets.Size() == 3);
 
+            AssetLoadStats loadStats = ResourceAssets::GetLastLoadStats();
+            CHECK(loadStats.directoryCount == 3);
+            CHECK(loadStats.assetCount == 3);
+            CHECK(loadStats.workerCount > 0);
+
             {
                 RID rid = Repository::GetByPath("Fyrion://Dir1/Dir1/TxtFile1.txt");
                 CHECK(rid);
@@ -126,4 +158,226 @@ namespace
 		Engine::Destroy();
 	}
 
-}
\ No newline at end of file
+    TEST_CASE("Repository::AssetsReload")
+    {
+        Engine::Init();
+        {
+            String assetPath = Path::Join(FileSystem::CurrentDir(), "AssetsReload");
+            FileSystem::Remove(assetPath);
+            REQUIRE(FileSystem::CreateDirectory(assetPath));
+
+            String filePath = Path::Join(assetPath, "TxtFile.txt");
+            auto writeFile = [&](const StringView& content)
+            {
+                FileHandler fileHandler = FileSystem::OpenFile(filePath, AccessMode::WriteOnly);
+                FileSystem::WriteFile(fileHandler, content.Data(), content.Size());
+                FileSystem::CloseFile(fileHandler);
+            };
+            writeFile("aaaa");
+
+            ResourceAssets::AddAssetImporter(".txt", TxtAssetLoadFunction);
+
+            ResourceTypeBuilder<TxtAsset>::Builder()
+                .Value<TxtAsset::Content, String>("Content")
+                .Build();
+
+            ResourceAssets::LoadAssetsFromDirectory("Reload", assetPath);
+
+            RID object = Repository::GetByPath("Reload://TxtFile.txt");
+            REQUIRE(object);
+            RID asset = Repository::GetParent(object);
+            REQUIRE(asset);
+            CHECK(Repository::Read(object).GetValue<String>(TxtAsset::Content) == "aaaa");
+
+            writeFile("bbbb");
+            CHECK(ResourceAssets::ReloadAsset(asset));
+
+            CHECK(Repository::GetByPath("Reload://TxtFile.txt") == object);
+            CHECK(Repository::GetParent(object) == asset);
+            CHECK(Repository::Read(object).GetValue<String>(TxtAsset::Content) == "bbbb");
+            CHECK(ResourceAssets::GetLoadedVersion(asset) == Repository::GetVersion(asset));
+
+            Repository::GarbageCollect();
+            CHECK(Repository::Read(object).GetValue<String>(TxtAsset::Content) == "bbbb");
+
+            FileSystem::Remove(assetPath);
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Repository::AssetsDependencies")
+    {
+        Engine::Init();
+        {
+            String assetPath = Path::Join(FileSystem::CurrentDir(), "AssetsDependencies");
+            FileSystem::Remove(assetPath);
+            REQUIRE(FileSystem::CreateDirectory(assetPath));
+
+            auto writeFile = [&](const StringView& name, const StringView& content)
+            {
+                FileHandler fileHandler = FileSystem::OpenFile(Path::Join(assetPath, name), AccessMode::WriteOnly);
+                FileSystem::WriteFile(fileHandler, content.Data(), content.Size());
+                FileSystem::CloseFile(fileHandler);
+            };
+
+            writeFile("Header.inc", "header");
+            writeFile("Other.inc", "other");
+            writeFile("A.include", "Header.inc\na-");
+            writeFile("B.include", "Other.inc\nb-");
+
+            ResourceAssets::AddAssetImporter(".include", IncludeAssetLoadFunction);
+
+            ResourceTypeBuilder<TxtAsset>::Builder()
+                .Value<TxtAsset::Content, String>("Content")
+                .Build();
+
+            ResourceAssets::LoadAssetsFromDirectory("Dependencies", assetPath);
+
+            RID objectA = Repository::GetByPath("Dependencies://A.include");
+            RID objectB = Repository::GetByPath("Dependencies://B.include");
+            REQUIRE(objectA);
+            REQUIRE(objectB);
+            CHECK(Repository::Read(objectA).GetValue<String>(TxtAsset::Content) == "a-header");
+            CHECK(Repository::Read(objectB).GetValue<String>(TxtAsset::Content) == "b-other");
+
+            //only the asset that includes the header depends on it
+            Array<RID> dependents = ResourceAssets::GetAssetDependents(Path::Join(assetPath, "Header.inc"));
+            REQUIRE(dependents.Size() == 1);
+            CHECK(dependents[0] == Repository::GetParent(objectA));
+
+            writeFile("Header.inc", "changed");
+            for (RID dependent : dependents)
+            {
+                CHECK(ResourceAssets::ReloadAsset(dependent));
+            }
+            CHECK(Repository::Read(objectA).GetValue<String>(TxtAsset::Content) == "a-changed");
+
+            //dependencies are replaced on reimport
+            writeFile("A.include", "Other.inc\na-");
+            CHECK(ResourceAssets::ReloadAsset(Repository::GetParent(objectA)));
+            CHECK(ResourceAssets::GetAssetDependents(Path::Join(assetPath, "Header.inc")).Empty());
+            CHECK(ResourceAssets::GetAssetDependents(Path::Join(assetPath, "Other.inc")).Size() == 2);
+
+            FileSystem::Remove(assetPath);
+        }
+        Engine::Destroy();
+    }
+
+    u32 CountFiles(const StringView& directory)
+    {
+        u32 count = 0;
+        if (FileSystem::GetFileStatus(directory).exists)
+        {
+            for (const String& entry : DirectoryEntries{directory})
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    RID CreateStreamAsset(RID root, const StringView& name, Array<u8>& bytes)
+    {
+        RID object = Repository::CreateResource<StreamAsset>();
+        Repository::SetUUID(object, UUID::RandomUUID());
+        {
+            ResourceObject write = Repository::Write(object);
+            write.WriteStream(StreamAsset::Stream)->Set(bytes.Data(), bytes.Size());
+            write.Commit();
+        }
+
+        RID asset = Repository::CreateResource<Asset>();
+        {
+            ResourceObject write = Repository::Write(asset);
+            write.SetValue(Asset::Name, String{name});
+            write.SetValue(Asset::Directory, root);
+            write.SetValue(Asset::Extension, String{FY_ASSET_EXTENSION});
+            write.SetSubObject(Asset::Object, object);
+            write.Commit();
+        }
+
+        ResourceObject assetRoot = Repository::Write(root);
+        assetRoot.AddToSubObjectSet(AssetRoot::Assets, asset);
+        assetRoot.Commit();
+
+        return asset;
+    }
+
+    TEST_CASE("Repository::AssetsStreamStore")
+    {
+        Engine::Init();
+        {
+            ResourceTypeBuilder<StreamAsset>::Builder()
+                .Stream<StreamAsset::Stream>("Stream")
+                .Build();
+
+            String assetPath = Path::Join(FileSystem::CurrentDir(), "AssetsStreamStore");
+            String storePath = Path::Join(assetPath, FY_STORE_EXTENSION);
+            FileSystem::Remove(assetPath);
+            REQUIRE(FileSystem::CreateDirectory(assetPath));
+
+            RID root = ResourceAssets::LoadAssetsFromDirectory("Store", assetPath);
+            REQUIRE(root);
+
+            Array<u8> bytes(100000);
+            for (usize i = 0; i < bytes.Size(); ++i)
+            {
+                bytes[i] = static_cast<u8>(i % 251);
+            }
+
+            RID assetA = CreateStreamAsset(root, "A", bytes);
+            RID assetB = CreateStreamAsset(root, "B", bytes);
+
+            ResourceAssets::SaveAssetsToDirectory(root, assetPath);
+
+            //same contents, stored and mapped once
+            CHECK(CountFiles(storePath) == 1);
+
+            RID objectA = Repository::Read(assetA)[Asset::Object].As<RID>();
+            RID objectB = Repository::Read(assetB)[Asset::Object].As<RID>();
+
+            {
+                StreamObject* streamA = Repository::Read(objectA).GetStream(StreamAsset::Stream);
+                StreamObject* streamB = Repository::Read(objectB).GetStream(StreamAsset::Stream);
+                REQUIRE(streamA);
+                REQUIRE(streamB);
+                CHECK(streamA->IsCompressed());
+                CHECK(streamA->GetContentHash());
+                CHECK(streamA->GetContentHash() == streamB->GetContentHash());
+                CHECK(streamA->MappedTo() == Path::Join(storePath, streamA->GetContentHash().ToString()));
+                CHECK(streamA->Map(0, 1).Data() == streamB->Map(0, 1).Data());
+            }
+
+            //the asset file references the hash, reloading maps the store
+            CHECK(ResourceAssets::ReloadAsset(assetA));
+            {
+                StreamObject* streamA = Repository::Read(objectA).GetStream(StreamAsset::Stream);
+                REQUIRE(streamA);
+                REQUIRE(streamA->Size() == bytes.Size());
+
+                Array<u8> data(bytes.Size());
+                streamA->Get(data.Data(), data.Size(), 0);
+                CHECK(data == bytes);
+            }
+
+            //the blob is kept while one asset references it
+            Repository::InactiveResource(assetB);
+            ResourceAssets::SaveAssetsToDirectory(root, assetPath);
+            Repository::GarbageCollect();
+            CHECK(CountFiles(storePath) == 1);
+
+            //the deleted asset is not collected yet, its version still maps the blob
+            Repository::InactiveResource(assetA);
+            ResourceAssets::SaveAssetsToDirectory(root, assetPath);
+            CHECK(CountFiles(storePath) == 1);
+
+            Repository::GarbageCollect();
+            CHECK(ResourceAssets::RemoveUnusedStreams(assetPath) == 1);
+            CHECK(CountFiles(storePath) == 0);
+
+            FileSystem::Remove(assetPath);
+            FileSystem::Remove(storePath);
+        }
+        Engine::Destroy();
+    }
+}